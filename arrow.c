@@ -0,0 +1,919 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: arrow.c
+|*
+|* Description: Columnar output: the rows of csv.c (one per root record,
+|*              with the columns of -c) in an Apache Arrow IPC file, which
+|*              can be mapped and read without parsing. Columns of
+|*              numbers (recno, pos, tag:int, and the INTEGER elements
+|*              without conversion, see csv_bind()) are int64, the others
+|*              utf8: one type per column. Missing values are nulls.
+|*
+|*              The file is written as it goes, without the Arrow
+|*              library: the magic, the schema, a record batch every
+|*              ARROW_BATCH_ROWS rows, the end of stream and the footer
+|*              with the position of the batches. The metadata are
+|*              flatbuffers (Schema.fbs, Message.fbs and File.fbs of the
+|*              Arrow format), built here front to back: each table
+|*              before the objects it points to, whose offsets are set
+|*              once they are written.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     INTEGER elements without conversion as int64
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Defines */
+
+#define FB_MAX_FIELDS   8       /* Fields of the tables used here */
+
+#define ARROW_V5        4       /* MetadataVersion */
+#define ARROW_SCHEMA    1       /* MessageHeader */
+#define ARROW_BATCH     3
+#define ARROW_TYPE_INT  2       /* Type */
+#define ARROW_TYPE_UTF8 5
+
+#define ARROW_PAD(n)    (((n) + 7) & ~7LL)  /* Buffers are aligned to 8 bytes */
+
+
+/* 3. Prototypes */
+
+static void     arrow_batch     (asn1printer *pr);
+static void     arrow_reset     (arrowfile *a);
+static void     arrow_message   (asn1printer *pr, long long body_len, arrowblock *block);
+static long     arrow_schema    (arrowfile *a, const csvcols *cols);
+static void     arrow_write     (asn1printer *pr, const char *str, long len);
+static void     arrow_pad       (asn1printer *pr);
+static void     arrow_valid     (arrowcol *ac, long row, int valid);
+static void     arrow_int       (arrowcol *ac, long row, long long val, int valid);
+static void     arrow_str       (arrowcol *ac, long row, const char *str, long len, int valid);
+static long     fb_table        (asn1output *fb, const int *sizes, const long long *vals, int n, long *at);
+static long     fb_vector       (asn1output *fb, int count, int align);
+static long     fb_string       (asn1output *fb, const char *str, long len);
+static void     fb_link         (asn1output *fb, long at, long target);
+static void     fb_put          (asn1output *fb, long long val, int size);
+static void     fb_pad          (asn1output *fb, int align, int extra);
+
+
+/****************************************************************************
+|*
+|* Function: arrow_header
+|*
+|* Description;
+|*
+|*     Starts the Arrow file of the printer: magic and schema, with the
+|*     columns of pr->cols. The rows of csv_handler go then to the
+|*     columns of the file instead of being written as text. The type
+|*     of a column is the one of its conversion, chosen by csv_bind()
+|*     if not given.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    INTEGER elements without conversion as int64
+|*
+****************************************************************************/
+int arrow_header(asn1printer *pr)
+{
+    arrowfile*      a = NULL;
+    const csvcol*   col = NULL;
+    int             rc = 0;
+    int             i = 0;
+
+    /* 1. Columns */
+
+    if ( ( a = (arrowfile *)calloc(1, sizeof(arrowfile)) ) == NULL ||
+            ( a->cols = (arrowcol *)calloc((size_t)pr->cols->ncols, sizeof(arrowcol)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the Arrow columns\n");
+        free(a);
+        return -1;
+    }
+
+    a->ncols = pr->cols->ncols;
+    pr->arrow = a;
+
+    rc = output_init(&a->fb, -1, OUTPUT_MIN_SIZE * 16);
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        col = &pr->cols->cols[i];
+
+        /* Numbers: recno, pos and the tags with :int or an INTEGER without conversion */
+
+        a->cols[i].type = ((col->kind == COL_TAG && col->conv == CONV_INT) ||
+                col->kind == COL_RECNO || col->kind == COL_POS ? ARROW_INT64 : ARROW_UTF8);
+
+        rc |= output_init(&a->cols[i].valid, -1, OUTPUT_MIN_SIZE * 16);
+        rc |= output_init(&a->cols[i].offsets, -1, OUTPUT_MIN_SIZE * 16);
+        rc |= output_init(&a->cols[i].data, -1, OUTPUT_MIN_SIZE * 16);
+    }
+
+    if (rc != 0)
+    {
+        arrow_close(pr);
+        return -1;
+    }
+
+    arrow_reset(a);
+
+
+    /* 2. Magic, padded to 8 bytes, and the schema */
+
+    arrow_write(pr, ARROW_MAGIC, 6);
+    arrow_pad(pr);
+
+    arrow_message(pr, 0, NULL);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_row
+|*
+|* Description;
+|*
+|*     Adds the row of csv_handler (pr->row) to the columns. Every
+|*     ARROW_BATCH_ROWS rows, they are written as a record batch.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    File column also with a single file
+|*
+****************************************************************************/
+void arrow_row(asn1printer *pr)
+{
+    arrowfile*      a = pr->arrow;
+    const csvrow*   row = pr->row;
+    const csvcol*   col = NULL;
+    arrowcol*       ac = NULL;
+    const char*     str = NULL;
+    char            num[24];
+    unsigned long long val = 0;
+    long            i = 0;
+    long            j = 0;
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        col = &pr->cols->cols[i];
+        ac = &a->cols[i];
+
+        switch (col->kind)
+        {
+            case COL_RECNO:
+                arrow_int(ac, a->rows, row->recno, TRUE);
+                break;
+            case COL_POS:
+                arrow_int(ac, a->rows, row->pos, TRUE);
+                break;
+            case COL_RECORD:
+                if (pr->use_tagnames && row->name != NULL)
+                    arrow_str(ac, a->rows, row->name, (long)strlen(row->name), TRUE);
+                else
+                    arrow_str(ac, a->rows, num, (long)sprintf(num, "%d", row->tag), TRUE);
+                break;
+            case COL_FILE:
+                arrow_str(ac, a->rows, pr->file, (pr->file != NULL ? (long)strlen(pr->file) : 0), pr->file != NULL);
+                break;
+            default:
+                str = (row->val[i] != -1 ? row->vals.buff + row->val[i] : NULL);
+
+                if (ac->type == ARROW_UTF8)
+                {
+                    arrow_str(ac, a->rows, str, (str != NULL ? row->vlen[i] : 0), str != NULL);
+                    break;
+                }
+
+                /* Numbers: back from the text of csv_value() */
+
+                val = 0;
+
+                for (j = (str != NULL && str[0] == '-'); str != NULL && j < row->vlen[i]; j++)
+                    val = val * 10 + (unsigned long long)(str[j] - '0');
+
+                if (str != NULL && str[0] == '-')
+                    val = -val;
+
+                arrow_int(ac, a->rows, (long long)val, str != NULL);
+                break;
+        }
+    }
+
+    if (++a->rows == ARROW_BATCH_ROWS)
+        arrow_batch(pr);
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_close
+|*
+|* Description;
+|*
+|*     Writes the last record batch and the footer, and releases the
+|*     columns
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void arrow_close(asn1printer *pr)
+{
+    arrowfile*      a = pr->arrow;
+    asn1output*     fb = NULL;
+    long            at[4];
+    char            len[4];
+    int             i = 0;
+
+    if (a == NULL)
+        return;
+
+    fb = &a->fb;
+
+    /* 1. Last rows, end of stream and footer */
+
+    if (a->pos > 0)
+    {
+        if (a->rows > 0)
+            arrow_batch(pr);
+
+        arrow_write(pr, "\xff\xff\xff\xff\0\0\0\0", 8);
+
+        fb->len = 0;
+        fb_put(fb, 0, 4);
+        fb_link(fb, 0, fb_table(fb, (const int[]){ 2, 4, 4, 4 }, (const long long[]){ ARROW_V5, 0, 0, 0 }, 4, at));
+        fb_link(fb, at[1], arrow_schema(a, pr->cols));
+        fb_link(fb, at[2], fb_vector(fb, 0, 8));
+        fb_link(fb, at[3], fb_vector(fb, a->nblocks, 8));
+
+        for (i = 0; i < a->nblocks; i++)
+        {
+            fb_put(fb, a->blocks[i].offset, 8);
+            fb_put(fb, a->blocks[i].meta_len, 4);
+            fb_put(fb, 0, 4);
+            fb_put(fb, a->blocks[i].body_len, 8);
+        }
+
+        for (i = 0; i < 4; i++)
+            len[i] = (char)(fb->len >> (8 * i));
+
+        arrow_write(pr, fb->buff, fb->len);
+        arrow_write(pr, len, 4);
+        arrow_write(pr, ARROW_MAGIC, 6);
+    }
+
+
+    /* 2. Release */
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        (void)output_close(&a->cols[i].valid);
+        (void)output_close(&a->cols[i].offsets);
+        (void)output_close(&a->cols[i].data);
+    }
+
+    (void)output_close(fb);
+    free(a->cols);
+    free(a->blocks);
+    free(a);
+
+    pr->arrow = NULL;
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_batch
+|*
+|* Description;
+|*
+|*     Writes the rows of the columns as a record batch: its metadata
+|*     (number of rows, nulls and position of the buffers) and its body
+|*     (the buffers of each column, validity, offsets and data)
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_batch(asn1printer *pr)
+{
+    arrowfile*      a = pr->arrow;
+    asn1output*     fb = &a->fb;
+    arrowcol*       ac = NULL;
+    arrowblock*     blocks = NULL;
+    const asn1output* bufs[3];
+    long            at[4];
+    long            rb[3];
+    long long       body_len = 0;
+    int             nbufs = 0;
+    int             i = 0;
+    int             b = 0;
+
+    /* 1. Metadata: Message with a RecordBatch */
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        nbufs += (a->cols[i].type == ARROW_UTF8 ? 3 : 2);
+        body_len += ARROW_PAD(a->cols[i].valid.len) + ARROW_PAD(a->cols[i].data.len) +
+                (a->cols[i].type == ARROW_UTF8 ? ARROW_PAD(a->cols[i].offsets.len) : 0);
+    }
+
+    fb->len = 0;
+    fb_put(fb, 0, 4);
+    fb_link(fb, 0, fb_table(fb, (const int[]){ 2, 1, 4, 8 }, (const long long[]){ ARROW_V5, ARROW_BATCH, 0, body_len }, 4, at));
+    fb_link(fb, at[2], fb_table(fb, (const int[]){ 8, 4, 4 }, (const long long[]){ a->rows, 0, 0 }, 3, rb));
+
+    fb_link(fb, rb[1], fb_vector(fb, a->ncols, 8));
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        fb_put(fb, a->rows, 8);
+        fb_put(fb, a->cols[i].nulls, 8);
+    }
+
+    fb_link(fb, rb[2], fb_vector(fb, nbufs, 8));
+
+    for (i = 0, body_len = 0; i < a->ncols; i++)
+    {
+        ac = &a->cols[i];
+        nbufs = 0;
+        bufs[nbufs++] = &ac->valid;
+        if (ac->type == ARROW_UTF8)
+            bufs[nbufs++] = &ac->offsets;
+        bufs[nbufs++] = &ac->data;
+
+        for (b = 0; b < nbufs; b++)
+        {
+            fb_put(fb, body_len, 8);
+            fb_put(fb, bufs[b]->len, 8);
+            body_len += ARROW_PAD(bufs[b]->len);
+        }
+    }
+
+
+    /* 2. Block of the batch, for the footer */
+
+    if (a->nblocks == a->ablocks)
+    {
+        if ( ( blocks = (arrowblock *)realloc(a->blocks, (size_t)(a->ablocks * 2 + 16) * sizeof(arrowblock)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the Arrow record batches\n");
+            arrow_reset(a);
+            return;
+        }
+        a->blocks = blocks;
+        a->ablocks = a->ablocks * 2 + 16;
+    }
+
+    arrow_message(pr, body_len, &a->blocks[a->nblocks++]);
+
+
+    /* 3. Body */
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        ac = &a->cols[i];
+
+        arrow_write(pr, ac->valid.buff, ac->valid.len);
+        arrow_pad(pr);
+
+        if (ac->type == ARROW_UTF8)
+        {
+            arrow_write(pr, ac->offsets.buff, ac->offsets.len);
+            arrow_pad(pr);
+        }
+
+        arrow_write(pr, ac->data.buff, ac->data.len);
+        arrow_pad(pr);
+    }
+
+    arrow_reset(a);
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_reset
+|*
+|* Description;
+|*
+|*     Empties the columns for the next batch
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_reset(arrowfile *a)
+{
+    int             zero = 0;
+    int             i = 0;
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        a->cols[i].nulls = 0;
+        a->cols[i].valid.len = 0;
+        a->cols[i].data.len = 0;
+        a->cols[i].offsets.len = 0;
+
+        output_write(&a->cols[i].offsets, (const char *)&zero, sizeof(zero));
+    }
+
+    a->rows = 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_message
+|*
+|* Description;
+|*
+|*     Writes the flatbuffer of a->fb as the metadata of a message:
+|*     continuation marker, size and the flatbuffer padded to 8 bytes.
+|*     Its body (body_len bytes) goes next. block: where to keep its
+|*     position. Without block, builds and writes the schema.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_message(asn1printer *pr, long long body_len, arrowblock *block)
+{
+    arrowfile*      a = pr->arrow;
+    asn1output*     fb = &a->fb;
+    long            at[4];
+    char            prefix[8] = "\xff\xff\xff\xff";
+    int             i = 0;
+
+    /* 1. Message of the schema */
+
+    if (block == NULL)
+    {
+        fb->len = 0;
+        fb_put(fb, 0, 4);
+        fb_link(fb, 0, fb_table(fb, (const int[]){ 2, 1, 4, 8 }, (const long long[]){ ARROW_V5, ARROW_SCHEMA, 0, 0 }, 4, at));
+        fb_link(fb, at[2], arrow_schema(a, pr->cols));
+    }
+
+    /* 2. Prefix and metadata */
+
+    fb_pad(fb, 8, 0);
+
+    for (i = 0; i < 4; i++)
+        prefix[4 + i] = (char)(fb->len >> (8 * i));
+
+    if (block != NULL)
+    {
+        block->offset = a->pos;
+        block->meta_len = (int)(fb->len + 8);
+        block->body_len = body_len;
+    }
+
+    arrow_write(pr, prefix, 8);
+    arrow_write(pr, fb->buff, fb->len);
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_schema
+|*
+|* Description;
+|*
+|*     Builds the Schema table of the columns, and the tables it points
+|*     to: one Field per column, with its name and its type (Int of 64
+|*     bits or Utf8)
+|*
+|* Return:
+|*      Position of the Schema table
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long arrow_schema(arrowfile *a, const csvcols *cols)
+{
+    asn1output*     fb = &a->fb;
+    const int       one = 1;
+    long            schema = 0;
+    long            vec = 0;
+    long            field = 0;
+    long            at[2];
+    long            fat[6];
+    int             i = 0;
+
+    /* 1. Schema: endianness of the buffers (those of this machine) and fields */
+
+    schema = fb_table(fb, (const int[]){ 2, 4 }, (const long long[]){ (*(const char *)&one ? 0 : 1), 0 }, 2, at);
+
+    fb_link(fb, at[1], ( vec = fb_vector(fb, a->ncols, 4) ));
+
+    for (i = 0; i < a->ncols; i++)
+        fb_put(fb, 0, 4);
+
+
+    /* 2. Field: name, nullable, type_type, type, dictionary (none) and children (none) */
+
+    for (i = 0; i < a->ncols; i++)
+    {
+        field = fb_table(fb, (const int[]){ 4, 1, 1, 4, 0, 4 },
+                (const long long[]){ 0, 1, (a->cols[i].type == ARROW_INT64 ? ARROW_TYPE_INT : ARROW_TYPE_UTF8), 0, 0, 0 },
+                6, fat);
+
+        fb_link(fb, vec + 4 + 4 * i, field);
+        fb_link(fb, fat[0], fb_string(fb, cols->cols[i].name, (long)strlen(cols->cols[i].name)));
+
+        if (a->cols[i].type == ARROW_INT64)
+            fb_link(fb, fat[3], fb_table(fb, (const int[]){ 4, 1 }, (const long long[]){ 64, 1 }, 2, at));
+        else
+            fb_link(fb, fat[3], fb_table(fb, NULL, NULL, 0, NULL));
+
+        fb_link(fb, fat[5], fb_vector(fb, 0, 4));
+    }
+
+    return schema;
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_write
+|*
+|* Description;
+|*
+|*     Writes len bytes of str to the output, counting the position in
+|*     the file
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_write(asn1printer *pr, const char *str, long len)
+{
+    output_write(pr->out, str, len);
+    pr->arrow->pos += len;
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_pad
+|*
+|* Description;
+|*
+|*     Writes zeros up to the next multiple of 8 bytes of the file
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_pad(asn1printer *pr)
+{
+    static const char zeros[8] = { 0 };
+
+    arrow_write(pr, zeros, (long)(ARROW_PAD(pr->arrow->pos) - pr->arrow->pos));
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_valid
+|*
+|* Description;
+|*
+|*     Sets the validity bit of row in the column
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_valid(arrowcol *ac, long row, int valid)
+{
+    if (row % 8 == 0)
+        output_putc(&ac->valid, 0);
+
+    if (valid)
+        ac->valid.buff[ac->valid.len - 1] |= (char)(1 << (row % 8));
+    else
+        ac->nulls++;
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_int
+|*
+|* Description;
+|*
+|*     Adds the value of row to a column of int64 (0 if null)
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_int(arrowcol *ac, long row, long long val, int valid)
+{
+    arrow_valid(ac, row, valid);
+    output_write(&ac->data, (const char *)&val, sizeof(val));
+}
+
+
+/****************************************************************************
+|*
+|* Function: arrow_str
+|*
+|* Description;
+|*
+|*     Adds the value of row to a column of utf8 (empty if null)
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void arrow_str(arrowcol *ac, long row, const char *str, long len, int valid)
+{
+    int             end = 0;
+
+    arrow_valid(ac, row, valid);
+
+    if (len > 0)
+        output_write(&ac->data, str, len);
+
+    end = (int)ac->data.len;
+    output_write(&ac->offsets, (const char *)&end, sizeof(end));
+}
+
+
+/****************************************************************************
+|*
+|* Function: fb_table
+|*
+|* Description;
+|*
+|*     Writes a flatbuffer table with n fields of sizes (0: field not
+|*     present) and values vals: its vtable and then the table, with the
+|*     largest fields first so that all are aligned. Offsets to other
+|*     objects are written as 0 and set later with fb_link(). at: where
+|*     to keep the position of each field.
+|*
+|* Return:
+|*      Position of the table
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long fb_table(asn1output *fb, const int *sizes, const long long *vals, int n, long *at)
+{
+    int             offs[FB_MAX_FIELDS];
+    int             tsize = 4;
+    int             align = 4;
+    long            vtable = 0;
+    long            table = 0;
+    int             size = 0;
+    int             i = 0;
+
+    /* 1. Layout: 8 bytes fields first, just after the offset of the vtable */
+
+    for (size = 8; size > 0; size /= 2)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if (sizes[i] == size)
+            {
+                offs[i] = tsize;
+                tsize += size;
+                if (size == 8)
+                    align = 8;
+            }
+            else if (sizes[i] == 0)
+                offs[i] = 0;
+        }
+    }
+
+
+    /* 2. vtable: its size, size of the table and position of each field */
+
+    fb_pad(fb, 2, 0);
+    vtable = fb->len;
+
+    fb_put(fb, 4 + 2 * n, 2);
+    fb_put(fb, tsize, 2);
+
+    for (i = 0; i < n; i++)
+        fb_put(fb, offs[i], 2);
+
+
+    /* 3. Table: offset back to the vtable and the fields */
+
+    fb_pad(fb, align, 4);
+    table = fb->len;
+
+    fb_put(fb, table - vtable, 4);
+
+    for (size = 8; size > 0; size /= 2)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if (sizes[i] == size)
+            {
+                at[i] = fb->len;
+                fb_put(fb, vals[i], size);
+            }
+        }
+    }
+
+    return table;
+}
+
+
+/****************************************************************************
+|*
+|* Function: fb_vector
+|*
+|* Description;
+|*
+|*     Writes the length of a flatbuffer vector of count elements aligned
+|*     to align bytes. The caller writes the elements just after.
+|*
+|* Return:
+|*      Position of the vector
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long fb_vector(asn1output *fb, int count, int align)
+{
+    long            pos = 0;
+
+    fb_pad(fb, (align > 4 ? align : 4), 4);
+    pos = fb->len;
+    fb_put(fb, count, 4);
+
+    return pos;
+}
+
+
+/****************************************************************************
+|*
+|* Function: fb_string
+|*
+|* Description;
+|*
+|*     Writes a flatbuffer string: length, characters and a NUL
+|*
+|* Return:
+|*      Position of the string
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long fb_string(asn1output *fb, const char *str, long len)
+{
+    long            pos = fb_vector(fb, (int)len, 4);
+
+    output_write(fb, str, len);
+    output_putc(fb, '\0');
+
+    return pos;
+}
+
+
+/****************************************************************************
+|*
+|* Function: fb_link
+|*
+|* Description;
+|*
+|*     Sets the offset at position at to point to target, written later
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void fb_link(asn1output *fb, long at, long target)
+{
+    long            val = target - at;
+    int             i = 0;
+
+    for (i = 0; i < 4; i++)
+        fb->buff[at + i] = (char)(val >> (8 * i));
+}
+
+
+/****************************************************************************
+|*
+|* Function: fb_put
+|*
+|* Description;
+|*
+|*     Writes a value of size bytes, little endian as in all flatbuffers
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void fb_put(asn1output *fb, long long val, int size)
+{
+    int             i = 0;
+
+    for (i = 0; i < size; i++)
+        output_putc(fb, (char)(val >> (8 * i)));
+}
+
+
+/****************************************************************************
+|*
+|* Function: fb_pad
+|*
+|* Description;
+|*
+|*     Writes zeros until extra bytes more would end aligned to align
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void fb_pad(asn1output *fb, int align, int extra)
+{
+    while ((fb->len + extra) % align != 0)
+        output_putc(fb, '\0');
+}
+
+/* EOF */
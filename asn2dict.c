@@ -0,0 +1,1947 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|*
+|* Module: asn2dict.c
+|*
+|* Description: Compiler of ASN.1 specifications into dictionaries of tag
+|*              names for readasn --dict (see dict.c).
+|*
+|*              The type assignments with a tag of their own name their
+|*              tag in the flat table, looked up by tag number only:
+|*
+|*                  CallEventDetailList ::= [APPLICATION 3] SEQUENCE OF ...
+|*
+|*              gives the name CallEventDetailList to tag 3.
+|*
+|*              The schema names each child by its class and tag in the
+|*              type of its parent, so that context-specific tags, which
+|*              mean something else in each SEQUENCE, and universal tags
+|*              get their own names. A child is named after its component
+|*              when the component has a tag of its own ([n] Type), and
+|*              after its type when the tag comes from the type (TAP
+|*              style). The children of untagged CHOICEs and of explicit
+|*              tags are followed through. The top level holds the tagged
+|*              type assignments, and with -r the elements of a type, for
+|*              files which are a list of untagged records.
+|*
+|*              Several specifications can go to the same dictionary, for
+|*              instance RAP with the TAP it imports. The first name given
+|*              to a tag or a type is kept. Values, classes of information
+|*              objects and parameterized types are read over.
+|*
+|*              -l lists the tags, names and schema of a dictionary.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Schema: names of the children by type
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Defines */
+
+#define DICT_MAX_TAG    1048575         /* Highest tag number accepted */
+#define DICT_MAX_NEST   64              /* Types referenced through one another without a tag */
+
+/* Tokens of the specification */
+#define TOK_END     0   /* End of the specification */
+#define TOK_WORD    1   /* Identifier, reference or keyword */
+#define TOK_NUMBER  2
+#define TOK_ASSIGN  3   /* ::= */
+#define TOK_CHAR    4   /* Any other character */
+
+/* Classes of the tags, as in the first octet of the encoding */
+#define CLS_UNIVERSAL   0
+#define CLS_APPLICATION 1
+#define CLS_CONTEXT     2
+#define CLS_PRIVATE     3
+
+/* Default tagging of a module */
+#define TAGS_EXPLICIT   0
+#define TAGS_IMPLICIT   1
+#define TAGS_AUTOMATIC  2
+
+/* Kinds of types */
+#define K_PRIM      1   /* Built-in type with a universal tag */
+#define K_SEQ       2   /* SEQUENCE { } or SET { } */
+#define K_SEQOF     3   /* SEQUENCE OF or SET OF */
+#define K_CHOICE    4
+#define K_REF       5   /* Type of another assignment */
+#define K_ANY       6   /* ANY and open types: children unknown */
+
+
+/* 3. Types */
+
+typedef struct
+{
+    int         kind;           /* TOK_* */
+    const char* str;            /* Text of the token in the specification */
+    int         len;
+    int         line;           /* Line where it starts */
+} asntoken;
+
+typedef struct
+{
+    const char* p;              /* Next character of the specification */
+    const char* end;
+    const char* filename;
+    int         line;
+} asnlexer;
+
+typedef struct _asntype asntype;
+
+typedef struct
+{
+    char*       ident;          /* Identifier of the component. NULL: none */
+    asntype*    type;
+    int         is_components_of; /* COMPONENTS OF type: the components of type */
+} asncomp;
+
+struct _asntype
+{
+    int         kind;           /* K_* */
+    int         has_tag;        /* [class number] of its own */
+    int         cls;            /* CLS_* of the tag */
+    int         tag;
+    int         is_explicit;    /* The tag goes around the one of the type */
+    int         utag;           /* Universal tag of K_PRIM, K_SEQ and K_SEQOF */
+    char*       ref;            /* Name of the type of K_REF */
+    asncomp*    comps;          /* Components of K_SEQ and K_CHOICE, element of K_SEQOF */
+    int         ncomps;
+    int         id;             /* Type in the schema of its children. 0: none yet */
+    int         wrap_id;        /* Type in the schema of the children of its explicit tag */
+};
+
+typedef struct
+{
+    char*       name;
+    asntype*    type;
+    int         order;          /* Position among the assignments: the first one is kept */
+} asnassign;
+
+typedef struct
+{
+    asntoken*   toks;           /* Tokens of the specification, the last one TOK_END */
+    int         ntoks;
+    int         pos;            /* Next token */
+    int         limit;          /* First token after the assignment being parsed */
+    int         tagging;        /* TAGS_* of the module */
+    const char* filename;
+} asnparser;
+
+typedef struct
+{
+    asntype*    type;           /* Type whose children are described */
+    int         is_wrap;        /* Children of its explicit tag: the type without the tag */
+    unsigned int name;          /* Name of the children of is_wrap */
+} asnwork;
+
+typedef struct
+{
+    asnassign*  assigns;        /* Type assignments of all the specifications */
+    int         nassigns;
+    int         aassigns;
+    char*       pool;           /* Names, one after the other, starting with "" */
+    long        pool_len;
+    long        pool_alloc;
+    unsigned int* hash;         /* Offsets of the names in pool, by hash. 0: free */
+    unsigned int hmask;
+    unsigned int nnames;        /* Names in the hash */
+    unsigned int* idx;          /* Flat table: offset of the name of each tag */
+    int         ntags;
+    int         atags;
+    long        count;          /* Tags with a name */
+    schemaent*  ents;           /* Schema: children of each type, not hashed yet */
+    long        nents;
+    long        aents;
+    asnwork*    work;           /* Types of the schema: type id is work[id - 1] */
+    int         nwork;
+    int         awork;
+} asndict;
+
+
+/* 4. Prototypes */
+
+static int      spec_read       (asndict *d, const char *filename);
+static int      spec_module     (asndict *d, asnparser *p, int begin, int end);
+static asntype* parse_type      (asnparser *p);
+static int      parse_comps     (asnparser *p, asntype *t);
+static void     parse_skip      (asnparser *p, int to_comma);
+static const asntoken* parse_tok(const asnparser *p, int ahead);
+static void     parse_error     (const asnparser *p, const char *what);
+static void     type_free       (asntype *t);
+static asntype* type_resolve    (const asndict *d, const asntype *t);
+static int      type_is_choice  (const asndict *d, const asntype *t, int nest);
+static int      type_content    (asndict *d, asntype *t, unsigned int name, int nest);
+static int      type_children   (asndict *d, int parent, asntype *t, unsigned int name, int own_tag, int nest);
+static int      seq_children    (asndict *d, int parent, asntype *t, int nest);
+static int      schema_type     (asndict *d, asntype *t, int is_wrap, unsigned int name);
+static int      schema_add      (asndict *d, int parent, int cls, int tag, unsigned int name, int child);
+static int      schema_build    (asndict *d, const char *root);
+static int      flat_add        (asndict *d, int tag, unsigned int name);
+static unsigned int name_add    (asndict *d, const char *str, int len);
+static int      cmp_assign      (const void *a, const void *b);
+static int      cmp_ent         (const void *a, const void *b);
+static int      dict_write      (const asndict *d, const char *filename);
+static int      dict_list       (const char *filename);
+static void     next_token      (asnlexer *lx, asntoken *tok);
+static int      is_token        (const asntoken *tok, const char *str);
+static void     usage           (const char *program_name);
+
+
+/* 5. Global Variables */
+
+/* Built-in types: one or two words and their universal tag */
+static const struct
+{
+    const char* word;
+    const char* word2;
+    int         utag;
+} builtins[] =
+{
+    { "BOOLEAN", NULL, 1 },             { "INTEGER", NULL, 2 },
+    { "BIT", "STRING", 3 },             { "OCTET", "STRING", 4 },
+    { "NULL", NULL, 5 },                { "OBJECT", "IDENTIFIER", 6 },
+    { "ObjectDescriptor", NULL, 7 },    { "EXTERNAL", NULL, 8 },
+    { "REAL", NULL, 9 },                { "ENUMERATED", NULL, 10 },
+    { "EMBEDDED", "PDV", 11 },          { "UTF8String", NULL, 12 },
+    { "RELATIVE-OID", NULL, 13 },       { "NumericString", NULL, 18 },
+    { "PrintableString", NULL, 19 },    { "TeletexString", NULL, 20 },
+    { "T61String", NULL, 20 },          { "VideotexString", NULL, 21 },
+    { "IA5String", NULL, 22 },          { "UTCTime", NULL, 23 },
+    { "GeneralizedTime", NULL, 24 },    { "GraphicString", NULL, 25 },
+    { "VisibleString", NULL, 26 },      { "ISO646String", NULL, 26 },
+    { "GeneralString", NULL, 27 },      { "UniversalString", NULL, 28 },
+    { "CHARACTER", "STRING", 29 },      { "BMPString", NULL, 30 },
+    { NULL, NULL, 0 }
+};
+
+static const char* class_names[] = { "UNIVERSAL ", "APPLICATION ", "", "PRIVATE " };
+
+
+int main(int argc, char **argv)
+{
+    asndict         d;
+    const char*     output = NULL;
+    const char*     list = NULL;
+    const char*     root = NULL;
+    int             opt = 0;
+    int             i = 0;
+
+    memset(&d, 0x00, sizeof(d));
+
+
+    /* 1. Checking parameters */
+
+    while ( ( opt = getopt(argc, argv, "o:l:r:") ) != -1 )
+    {
+        switch (opt)
+        {
+            case 'o': /* 1.1. -o : Dictionary to write */
+                output = optarg;
+                break;
+            case 'l': /* 1.2. -l : Dictionary to list */
+                list = optarg;
+                break;
+            case 'r': /* 1.3. -r : Type of the elements at the top level */
+                root = optarg;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (list != NULL)
+    {
+        if (output != NULL || root != NULL || optind != argc)
+            usage(argv[0]);
+
+        exit(dict_list(list) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    if (output == NULL || optind == argc)
+        usage(argv[0]);
+
+    if (name_add(&d, "", 0) != 0) /* Offset 0: no name */
+        exit(EXIT_FAILURE);
+
+
+    /* 2. Type assignments of the specifications, in the order given */
+
+    for (i = optind; i < argc; i++)
+    {
+        if (spec_read(&d, argv[i]) != 0)
+            exit(EXIT_FAILURE);
+    }
+
+    if (d.nassigns == 0)
+    {
+        fprintf(stderr, "No type found\n");
+        exit(EXIT_FAILURE);
+    }
+
+    qsort(d.assigns, (size_t)d.nassigns, sizeof(asnassign), cmp_assign);
+
+
+    /* 3. Flat table and schema */
+
+    if (schema_build(&d, root) != 0)
+        exit(EXIT_FAILURE);
+
+    if (d.count == 0 && d.nents == 0)
+    {
+        fprintf(stderr, "No tagged type found\n");
+        exit(EXIT_FAILURE);
+    }
+
+
+    /* 4. Dictionary */
+
+    if (dict_write(&d, output) != 0)
+        exit(EXIT_FAILURE);
+
+    fprintf(stderr, "%s: %ld tags, %d types, %ld children\n", output, d.count, d.nwork, d.nents);
+
+    exit(EXIT_SUCCESS);
+}
+
+
+/****************************************************************************
+|*
+|* Function: spec_read
+|*
+|* Description;
+|*
+|*     Reads the specification filename into tokens and parses the type
+|*     assignments of each module in it (DEFINITIONS ... BEGIN ... END)
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error reading the specification or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int spec_read(asndict *d, const char *filename)
+{
+    asnparser       p;
+    asnlexer        lx;
+    asntoken*       toks_tmp = NULL;
+    FILE*           fp = NULL;
+    char*           text = NULL;
+    long            len = 0;
+    int             atoks = 0;
+    int             i = 0, begin = 0;
+    int             rc = 0;
+
+    memset(&p, 0x00, sizeof(p));
+    p.filename = filename;
+
+    /* 1. The whole specification in memory */
+
+    if ( ( fp = fopen(filename, "rb") ) == NULL )
+    {
+        fprintf(stderr, "Cannot open file %s: %s\n", filename, strerror(errno));
+        return -1;
+    }
+
+    if (fseek(fp, 0, SEEK_END) != 0 || ( len = ftell(fp) ) < 0 || fseek(fp, 0, SEEK_SET) != 0 ||
+            ( text = (char *)malloc((size_t)len + 1) ) == NULL ||
+            (long)fread(text, 1, (size_t)len, fp) != len)
+    {
+        fprintf(stderr, "Cannot read file %s\n", filename);
+        (void)fclose(fp);
+        free(text);
+        return -1;
+    }
+
+    (void)fclose(fp);
+    text[len] = '\0';
+
+
+    /* 2. Tokens, the last one TOK_END */
+
+    lx.p = text;
+    lx.end = text + len;
+    lx.filename = filename;
+    lx.line = 1;
+
+    do
+    {
+        if (p.ntoks == atoks)
+        {
+            atoks = (atoks > 0 ? atoks * 2 : 4096);
+            if ( ( toks_tmp = (asntoken *)realloc(p.toks, (size_t)atoks * sizeof(asntoken)) ) == NULL )
+            {
+                fprintf(stderr, "Couldn't allocate memory\n");
+                free(p.toks);
+                free(text);
+                return -1;
+            }
+            p.toks = toks_tmp;
+        }
+
+        next_token(&lx, &p.toks[p.ntoks]);
+    }
+    while (p.toks[p.ntoks++].kind != TOK_END);
+
+
+    /* 3. Modules: DEFINITIONS [EXPLICIT | IMPLICIT | AUTOMATIC TAGS] ::= BEGIN ... END */
+
+    for (i = 0; i < p.ntoks - 1 && rc == 0; i++)
+    {
+        if (!is_token(&p.toks[i], "DEFINITIONS"))
+            continue;
+
+        p.tagging = TAGS_EXPLICIT;
+
+        for (i++; i < p.ntoks - 1 && p.toks[i].kind != TOK_ASSIGN; i++)
+        {
+            if (is_token(&p.toks[i], "IMPLICIT"))
+                p.tagging = TAGS_IMPLICIT;
+            else if (is_token(&p.toks[i], "AUTOMATIC"))
+                p.tagging = TAGS_AUTOMATIC;
+        }
+
+        if (!is_token(&p.toks[i + 1], "BEGIN"))
+            continue;
+
+        for (begin = i += 2; i < p.ntoks - 1 && !is_token(&p.toks[i], "END"); i++)
+            ;
+
+        rc = spec_module(d, &p, begin, i);
+    }
+
+    free(p.toks);
+    free(text);
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: spec_module
+|*
+|* Description;
+|*
+|*     Parses the type assignments of the body of a module, tokens begin
+|*     to end. Each assignment goes from the left side of its "::=" to
+|*     the left side of the next one, which is:
+|*
+|*         TypeReference ::=               type
+|*         valueReference Type ::=         value (also with two words:
+|*                                         OCTET STRING, OBJECT IDENTIFIER)
+|*         Reference { parameters } ::=    parameterized
+|*
+|*     Only the first kind is kept. Whatever comes before the first
+|*     assignment (EXPORTS, IMPORTS) is read over.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int spec_module(asndict *d, asnparser *p, int begin, int end)
+{
+    const asntoken* toks = p->toks;
+    asnassign*      assigns_tmp = NULL;
+    asntype*        t = NULL;
+    int*            lhs = NULL;         /* First token of the left side of each "::=" */
+    int*            ops = NULL;         /* Token of each "::=" */
+    int             n = 0, j = 0, i = 0, s = 0;
+    int             depth = 0;
+
+    if ( ( lhs = (int *)malloc((size_t)(end - begin + 1) * sizeof(int)) ) == NULL ||
+            ( ops = (int *)malloc((size_t)(end - begin + 1) * sizeof(int)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory\n");
+        free(lhs);
+        return -1;
+    }
+
+    /* 1. Left sides of the "::=" out of braces */
+
+    for (i = begin; i < end; i++)
+    {
+        if (is_token(&toks[i], "{"))
+            depth++;
+        else if (is_token(&toks[i], "}"))
+            depth--;
+
+        if (toks[i].kind != TOK_ASSIGN || depth != 0 || i == begin)
+            continue;
+
+        s = i - 1;
+
+        if (is_token(&toks[s], "}"))
+        {
+            for (depth = 1, s--; s > begin && depth > 0; s--)
+                depth += is_token(&toks[s], "}") - is_token(&toks[s], "{");
+            depth = 0;
+        }
+        else if (s > begin && toks[s - 1].kind == TOK_WORD &&
+                ((is_token(&toks[s], "STRING") && (is_token(&toks[s - 1], "OCTET") || is_token(&toks[s - 1], "BIT") ||
+                  is_token(&toks[s - 1], "CHARACTER"))) ||
+                 (is_token(&toks[s], "IDENTIFIER") && is_token(&toks[s - 1], "OBJECT"))))
+        {
+            s--;
+        }
+
+        if (s > begin && toks[s - 1].kind == TOK_WORD && islower((uchar)toks[s - 1].str[0]) &&
+                !(s - 1 > begin && toks[s - 2].kind == TOK_ASSIGN))  /* A value "::= v" before */
+            s--;
+
+        lhs[n] = s;
+        ops[n++] = i;
+    }
+
+
+    /* 2. Type assignments */
+
+    for (j = 0; j < n; j++)
+    {
+        s = lhs[j];
+
+        if (ops[j] - s != 1 || toks[s].kind != TOK_WORD || !isupper((uchar)toks[s].str[0]))
+            continue;
+
+        p->pos = ops[j] + 1;
+        p->limit = (j + 1 < n ? lhs[j + 1] : end);
+
+        if ( ( t = parse_type(p) ) == NULL )
+        {
+            fprintf(stderr, "%s:%d: type %.*s not understood, left out\n", p->filename, toks[s].line, toks[s].len, toks[s].str);
+            continue;
+        }
+
+        if (d->nassigns == d->aassigns)
+        {
+            d->aassigns = (d->aassigns > 0 ? d->aassigns * 2 : 256);
+            if ( ( assigns_tmp = (asnassign *)realloc(d->assigns, (size_t)d->aassigns * sizeof(asnassign)) ) == NULL )
+            {
+                fprintf(stderr, "Couldn't allocate memory\n");
+                free(lhs);
+                free(ops);
+                return -1;
+            }
+            d->assigns = assigns_tmp;
+        }
+
+        d->assigns[d->nassigns].name = strndup(toks[s].str, (size_t)toks[s].len);
+        d->assigns[d->nassigns].type = t;
+        d->assigns[d->nassigns].order = d->nassigns;
+        d->nassigns++;
+    }
+
+    free(lhs);
+    free(ops);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: parse_type
+|*
+|* Description;
+|*
+|*     Parses a type: [tag] [IMPLICIT | EXPLICIT] type (constraints)
+|*
+|* Return:
+|*      The type
+|*      NULL: Not understood (reported) or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static asntype *parse_type(asnparser *p)
+{
+    const asntoken* k = NULL;
+    asntype*        t = NULL;
+    int             i = 0;
+
+    if ( ( t = (asntype *)calloc(1, sizeof(asntype)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory\n");
+        return NULL;
+    }
+
+    /* 1. Tag */
+
+    if (is_token(parse_tok(p, 0), "["))
+    {
+        p->pos++;
+        k = parse_tok(p, 0);
+
+        t->cls = (is_token(k, "UNIVERSAL") ? CLS_UNIVERSAL : is_token(k, "APPLICATION") ? CLS_APPLICATION :
+                  is_token(k, "PRIVATE") ? CLS_PRIVATE : CLS_CONTEXT);
+        if (t->cls != CLS_CONTEXT)
+            k = parse_tok(p, 1), p->pos++;
+
+        if (k->kind != TOK_NUMBER || ( t->tag = atoi(k->str) ) > DICT_MAX_TAG || !is_token(parse_tok(p, 1), "]"))
+        {
+            parse_error(p, "tag number");
+            type_free(t);
+            return NULL;
+        }
+
+        p->pos += 2;
+        t->has_tag = TRUE;
+        t->is_explicit = (p->tagging == TAGS_EXPLICIT);
+
+        if (is_token(parse_tok(p, 0), "IMPLICIT"))
+            { t->is_explicit = FALSE; p->pos++; }
+        else if (is_token(parse_tok(p, 0), "EXPLICIT"))
+            { t->is_explicit = TRUE; p->pos++; }
+    }
+
+
+    /* 2. Type */
+
+    k = parse_tok(p, 0);
+
+    if (is_token(k, "SEQUENCE") || is_token(k, "SET"))
+    {
+        /* 2.1. SEQUENCE { }, SEQUENCE [SIZE (...)] OF [identifier] Type */
+
+        t->utag = (is_token(k, "SEQUENCE") ? 16 : 17);
+        p->pos++;
+
+        if (is_token(parse_tok(p, 0), "{"))
+        {
+            t->kind = K_SEQ;
+            if (parse_comps(p, t) != 0)
+            {
+                type_free(t);
+                return NULL;
+            }
+        }
+        else
+        {
+            if (is_token(parse_tok(p, 0), "SIZE"))
+                p->pos++;
+            if (is_token(parse_tok(p, 0), "("))
+                parse_skip(p, FALSE);
+
+            t->kind = K_SEQOF;
+
+            if (!is_token(parse_tok(p, 0), "OF") || ( t->comps = (asncomp *)calloc(1, sizeof(asncomp)) ) == NULL)
+            {
+                parse_error(p, "OF");
+                type_free(t);
+                return NULL;
+            }
+            p->pos++;
+            t->ncomps = 1;
+
+            k = parse_tok(p, 0);
+            if (k->kind == TOK_WORD && islower((uchar)k->str[0]))
+            {
+                t->comps[0].ident = strndup(k->str, (size_t)k->len);
+                p->pos++;
+            }
+
+            if ( ( t->comps[0].type = parse_type(p) ) == NULL )
+            {
+                type_free(t);
+                return NULL;
+            }
+        }
+    }
+    else if (is_token(k, "CHOICE"))
+    {
+        /* 2.2. CHOICE { } */
+
+        t->kind = K_CHOICE;
+        p->pos++;
+
+        if (!is_token(parse_tok(p, 0), "{") || parse_comps(p, t) != 0)
+        {
+            parse_error(p, "{");
+            type_free(t);
+            return NULL;
+        }
+    }
+    else if (is_token(k, "ANY"))
+    {
+        /* 2.3. ANY [DEFINED BY identifier] */
+
+        t->kind = K_ANY;
+        p->pos += (is_token(parse_tok(p, 1), "DEFINED") ? 4 : 1);
+    }
+    else if (k->kind == TOK_WORD && isupper((uchar)k->str[0]))
+    {
+        /* 2.4. Built-in type, with its named numbers, or reference */
+
+        for (i = 0; builtins[i].word != NULL; i++)
+        {
+            if (is_token(k, builtins[i].word) && (builtins[i].word2 == NULL || is_token(parse_tok(p, 1), builtins[i].word2)))
+                break;
+        }
+
+        if (builtins[i].word != NULL)
+        {
+            t->kind = K_PRIM;
+            t->utag = builtins[i].utag;
+            p->pos += (builtins[i].word2 != NULL ? 2 : 1);
+        }
+        else
+        {
+            t->kind = K_REF;
+            p->pos++;
+
+            if (is_token(parse_tok(p, 0), ".") && parse_tok(p, 1)->kind == TOK_WORD) /* Module.Type */
+                k = parse_tok(p, 1), p->pos += 2;
+
+            if (is_token(parse_tok(p, 0), ".")) /* Field of a class of objects */
+                t->kind = K_ANY, p->pos += 3;
+
+            t->ref = strndup(k->str, (size_t)k->len);
+        }
+
+        if (is_token(parse_tok(p, 0), "{"))
+            parse_skip(p, FALSE);
+    }
+    else
+    {
+        parse_error(p, "type");
+        type_free(t);
+        return NULL;
+    }
+
+
+    /* 3. Constraints */
+
+    while (is_token(parse_tok(p, 0), "("))
+        parse_skip(p, FALSE);
+
+    return t;
+}
+
+
+/****************************************************************************
+|*
+|* Function: parse_comps
+|*
+|* Description;
+|*
+|*     Parses the components of a SEQUENCE, SET or CHOICE, from "{" to
+|*     "}". Extension markers, exceptions and version brackets are read
+|*     over. With AUTOMATIC TAGS, components without tag are numbered.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Not understood (reported) or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int parse_comps(asnparser *p, asntype *t)
+{
+    const asntoken* k = NULL;
+    asncomp*        comps_tmp = NULL;
+    asncomp*        c = NULL;
+    int             acomps = 0;
+    int             i = 0, tagged = FALSE;
+
+    for (p->pos++; ; )
+    {
+        k = parse_tok(p, 0);
+
+        /* 1. End, separators, extensions */
+
+        if (k->kind == TOK_END)
+        {
+            parse_error(p, "}");
+            return -1;
+        }
+
+        if (is_token(k, "}"))
+        {
+            p->pos++;
+            break;
+        }
+
+        if (is_token(k, ",") || is_token(k, ".") || (is_token(k, "]") && is_token(parse_tok(p, 1), "]")))
+        {
+            p->pos += (is_token(k, "]") ? 2 : 1);
+            continue;
+        }
+
+        if (is_token(k, "!"))
+        {
+            parse_skip(p, TRUE);
+            continue;
+        }
+
+        if (is_token(k, "[") && is_token(parse_tok(p, 1), "["))
+        {
+            p->pos += 2;
+            if (parse_tok(p, 0)->kind == TOK_NUMBER && is_token(parse_tok(p, 1), ":"))
+                p->pos += 2;
+            continue;
+        }
+
+
+        /* 2. Component: identifier Type, COMPONENTS OF Type */
+
+        if (t->ncomps == acomps)
+        {
+            acomps = (acomps > 0 ? acomps * 2 : 16);
+            if ( ( comps_tmp = (asncomp *)realloc(t->comps, (size_t)acomps * sizeof(asncomp)) ) == NULL )
+            {
+                fprintf(stderr, "Couldn't allocate memory\n");
+                return -1;
+            }
+            t->comps = comps_tmp;
+        }
+
+        c = &t->comps[t->ncomps];
+        memset(c, 0x00, sizeof(*c));
+
+        if (is_token(k, "COMPONENTS") && is_token(parse_tok(p, 1), "OF"))
+        {
+            c->is_components_of = TRUE;
+            p->pos += 2;
+        }
+        else if (k->kind == TOK_WORD && islower((uchar)k->str[0]))
+        {
+            c->ident = strndup(k->str, (size_t)k->len);
+            p->pos++;
+        }
+        else
+        {
+            parse_error(p, "component");
+            return -1;
+        }
+
+        if ( ( c->type = parse_type(p) ) == NULL )
+        {
+            free(c->ident);
+            return -1;
+        }
+
+        t->ncomps++;
+        tagged |= (c->type->has_tag && !c->is_components_of);
+
+        /* 2.1. OPTIONAL, DEFAULT value */
+
+        if (is_token(parse_tok(p, 0), "OPTIONAL"))
+            p->pos++;
+        else if (is_token(parse_tok(p, 0), "DEFAULT"))
+            parse_skip(p, TRUE);
+    }
+
+
+    /* 3. Automatic tags: [0], [1]... implicit, explicit for CHOICE (see type_content) */
+
+    if (p->tagging == TAGS_AUTOMATIC && !tagged)
+    {
+        for (i = 0; i < t->ncomps; i++)
+        {
+            if (t->comps[i].is_components_of)
+                continue;
+
+            t->comps[i].type->has_tag = TRUE;
+            t->comps[i].type->cls = CLS_CONTEXT;
+            t->comps[i].type->tag = i;
+            t->comps[i].type->is_explicit = FALSE;
+        }
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: parse_skip
+|*
+|* Description;
+|*
+|*     Reads over a group in brackets or braces, or, with to_comma, over
+|*     a value up to the "," or "}" which ends a component
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void parse_skip(asnparser *p, int to_comma)
+{
+    const asntoken* k = NULL;
+    int             depth = 0;
+
+    for (;; p->pos++)
+    {
+        k = parse_tok(p, 0);
+
+        if (k->kind == TOK_END)
+            return;
+
+        if (to_comma && depth == 0 && p->pos > 0 && (is_token(k, ",") || is_token(k, "}")))
+            return;
+
+        if (is_token(k, "(") || is_token(k, "{"))
+            depth++;
+        else if ((is_token(k, ")") || is_token(k, "}")) && --depth == 0 && !to_comma)
+        {
+            p->pos++;
+            return;
+        }
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: parse_tok
+|*
+|* Description;
+|*
+|*     Token ahead of the next one, or TOK_END after the assignment
+|*
+|* Return:
+|*      The token
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static const asntoken *parse_tok(const asnparser *p, int ahead)
+{
+    return (p->pos + ahead < p->limit ? &p->toks[p->pos + ahead] : &p->toks[p->ntoks - 1]);
+}
+
+
+/****************************************************************************
+|*
+|* Function: parse_error
+|*
+|* Description;
+|*
+|*     Reports what was expected at the next token
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void parse_error(const asnparser *p, const char *what)
+{
+    const asntoken* k = parse_tok(p, 0);
+
+    if (k->kind == TOK_END)
+        fprintf(stderr, "%s: %s expected at the end of the assignment\n", p->filename, what);
+    else
+        fprintf(stderr, "%s:%d: %s expected, not %.*s\n", p->filename, k->line, what, k->len, k->str);
+}
+
+
+/****************************************************************************
+|*
+|* Function: type_free
+|*
+|* Description;
+|*
+|*     Releases a type and its components
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void type_free(asntype *t)
+{
+    int             i = 0;
+
+    for (i = 0; i < t->ncomps; i++)
+    {
+        free(t->comps[i].ident);
+        if (t->comps[i].type != NULL)
+            type_free(t->comps[i].type);
+    }
+
+    free(t->comps);
+    free(t->ref);
+    free(t);
+}
+
+
+/****************************************************************************
+|*
+|* Function: type_resolve
+|*
+|* Description;
+|*
+|*     Type assigned to the reference of t (the first one given)
+|*
+|* Return:
+|*      The type
+|*      NULL: Not a reference or not in the specifications
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static asntype *type_resolve(const asndict *d, const asntype *t)
+{
+    asnassign       key;
+    long            lo = 0, hi = d->nassigns, mid = 0;
+
+    if (t->kind != K_REF)
+        return NULL;
+
+    key.name = t->ref;
+    key.order = -1;     /* Before any of the same name */
+
+    /* 1. First assignment of the name, by halves */
+
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        if (cmp_assign(&d->assigns[mid], &key) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return (lo < d->nassigns && strcmp(d->assigns[lo].name, t->ref) == 0 ? d->assigns[lo].type : NULL);
+}
+
+
+/****************************************************************************
+|*
+|* Function: type_is_choice
+|*
+|* Description;
+|*
+|*     Is t, without its own tag, a CHOICE or an open type? Their tags
+|*     cannot be replaced: a tag put on them is explicit.
+|*
+|* Return:
+|*      TRUE/FALSE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int type_is_choice(const asndict *d, const asntype *t, int nest)
+{
+    const asntype*  r = NULL;
+
+    if (t->kind == K_CHOICE || t->kind == K_ANY)
+        return TRUE;
+
+    if (nest < DICT_MAX_NEST && ( r = type_resolve(d, t) ) != NULL && !r->has_tag)
+        return type_is_choice(d, r, nest + 1);
+
+    return FALSE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: type_content
+|*
+|* Description;
+|*
+|*     Type in the schema of the children of an element of type t, found
+|*     by the outermost tag of t: the type without the tag for an explicit
+|*     tag, the components of a SEQUENCE or SET, the element of a
+|*     SEQUENCE OF, or what an implicit tag on a reference replaces.
+|*
+|* Return:
+|*      Type in the schema
+|*      0: No children known (primitive, open type)
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int type_content(asndict *d, asntype *t, unsigned int name, int nest)
+{
+    asntype*        r = NULL;
+
+    if (t->has_tag && (t->is_explicit || type_is_choice(d, t, 0)))
+        return schema_type(d, t, TRUE, name);
+
+    if (t->kind == K_SEQ || t->kind == K_SEQOF)
+        return schema_type(d, t, FALSE, 0);
+
+    if (nest < DICT_MAX_NEST && ( r = type_resolve(d, t) ) != NULL)
+        return type_content(d, r, name, nest + 1);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: type_children
+|*
+|* Description;
+|*
+|*     Adds to the type parent of the schema the elements which can stand
+|*     for an element of type t named name: one with the tag of t (its
+|*     own one, left out without own_tag, or the universal one), or one
+|*     per alternative of an untagged CHOICE. Through a reference, the
+|*     element is named after the type if the tag is the one of the type.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int type_children(asndict *d, int parent, asntype *t, unsigned int name, int own_tag, int nest)
+{
+    asntype*        r = NULL;
+    int             child = 0;
+    int             i = 0;
+
+    if (nest >= DICT_MAX_NEST)
+        return 0;
+
+    if (own_tag && t->has_tag)
+    {
+        if ( ( child = type_content(d, t, name, 0) ) < 0 )
+            return -1;
+        return schema_add(d, parent, t->cls, t->tag, name, child);
+    }
+
+    switch (t->kind)
+    {
+        case K_PRIM:
+            return schema_add(d, parent, CLS_UNIVERSAL, t->utag, name, 0);
+
+        case K_SEQ:
+        case K_SEQOF:
+            if ( ( child = schema_type(d, t, FALSE, 0) ) < 0 )
+                return -1;
+            return schema_add(d, parent, CLS_UNIVERSAL, t->utag, name, child);
+
+        case K_CHOICE:
+            for (i = 0; i < t->ncomps; i++)
+            {
+                if (type_children(d, parent, t->comps[i].type, name_add(d, t->comps[i].ident, -1), TRUE, nest + 1) != 0)
+                    return -1;
+            }
+            return 0;
+
+        case K_REF:
+            if ( ( r = type_resolve(d, t) ) == NULL )
+                return 0;
+            if (r->has_tag || name == 0)
+                name = name_add(d, t->ref, -1);
+            return type_children(d, parent, r, name, TRUE, nest + 1);
+
+        default:
+            return 0;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: seq_children
+|*
+|* Description;
+|*
+|*     Adds the components of the SEQUENCE or SET t to the type parent
+|*     of the schema, those of COMPONENTS OF included
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int seq_children(asndict *d, int parent, asntype *t, int nest)
+{
+    asntype*        r = NULL;
+    int             i = 0, n = 0;
+
+    for (i = 0; i < t->ncomps; i++)
+    {
+        if (t->comps[i].is_components_of)
+        {
+            for (r = t->comps[i].type, n = nest; r != NULL && r->kind == K_REF && n < DICT_MAX_NEST; n++)
+                r = type_resolve(d, r);
+
+            if (r != NULL && r->kind == K_SEQ && n < DICT_MAX_NEST && seq_children(d, parent, r, n + 1) != 0)
+                return -1;
+        }
+        else if (type_children(d, parent, t->comps[i].type, name_add(d, t->comps[i].ident, -1), TRUE, 0) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: schema_type
+|*
+|* Description;
+|*
+|*     Type of the schema for the children of t (is_wrap: of the explicit
+|*     tag of t, whose children are named name). Given the first time it
+|*     is asked for, and its children added later by schema_build(). The
+|*     type of a SEQUENCE OF or SET OF has SCHEMA_LIST, for the children
+|*     of its parent.
+|*
+|* Return:
+|*      Type in the schema
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    SCHEMA_LIST
+|*
+****************************************************************************/
+static int schema_type(asndict *d, asntype *t, int is_wrap, unsigned int name)
+{
+    asnwork*        work_tmp = NULL;
+    int*            id = (is_wrap ? &t->wrap_id : &t->id);
+    int             list = (!is_wrap && t->kind == K_SEQOF ? (int)SCHEMA_LIST : 0);
+
+    if (*id != 0)
+        return *id | list;
+
+    if (d->nwork == d->awork)
+    {
+        d->awork = (d->awork > 0 ? d->awork * 2 : 256);
+        if ( ( work_tmp = (asnwork *)realloc(d->work, (size_t)d->awork * sizeof(asnwork)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory\n");
+            return -1;
+        }
+        d->work = work_tmp;
+    }
+
+    d->work[d->nwork].type = t;
+    d->work[d->nwork].is_wrap = is_wrap;
+    d->work[d->nwork].name = name;
+
+    return ( *id = ++d->nwork ) | list;
+}
+
+
+/****************************************************************************
+|*
+|* Function: schema_add
+|*
+|* Description;
+|*
+|*     Adds a child of class and tag, named name and of type child, to the
+|*     type parent of the schema
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int schema_add(asndict *d, int parent, int cls, int tag, unsigned int name, int child)
+{
+    schemaent*      ents_tmp = NULL;
+
+    if (child < 0)
+        return -1;
+
+    if (d->nents == d->aents)
+    {
+        d->aents = (d->aents > 0 ? d->aents * 2 : 1024);
+        if ( ( ents_tmp = (schemaent *)realloc(d->ents, (size_t)d->aents * sizeof(schemaent)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory\n");
+            return -1;
+        }
+        d->ents = ents_tmp;
+    }
+
+    d->ents[d->nents].type = (unsigned int)parent;
+    d->ents[d->nents].key = schema_key(cls, tag);
+    d->ents[d->nents].name = name;
+    d->ents[d->nents].child = (unsigned int)child;
+    d->nents++;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: schema_build
+|*
+|* Description;
+|*
+|*     Builds the flat table from the tagged type assignments, and the
+|*     schema: at the top level (type 0) the elements of the type root,
+|*     if given, and the tagged type assignments; then the children of
+|*     each type of the schema, which may give new types, until all have
+|*     their children.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Unknown root or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int schema_build(asndict *d, const char *root)
+{
+    asntype         ref;
+    asnwork         w;
+    asnassign**     order = NULL;
+    asnassign*      a = NULL;
+    unsigned int    name = 0;
+    int             i = 0;
+    int             rc = 0;
+
+    /* 1. Top level: the elements of root */
+
+    if (root != NULL)
+    {
+        memset(&ref, 0x00, sizeof(ref));
+        ref.kind = K_REF;
+        ref.ref = (char *)root;
+
+        if (type_resolve(d, &ref) == NULL)
+        {
+            fprintf(stderr, "Type %s not in the specifications\n", root);
+            return -1;
+        }
+
+        if (type_children(d, 0, &ref, 0, TRUE, 0) != 0)
+            return -1;
+    }
+
+
+    /* 2. Tagged type assignments, in the order of the specifications */
+
+    if ( ( order = (asnassign **)malloc((size_t)d->nassigns * sizeof(asnassign *)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory\n");
+        return -1;
+    }
+
+    for (i = 0; i < d->nassigns; i++)
+        order[d->assigns[i].order] = &d->assigns[i];
+
+    for (i = 0; i < d->nassigns && rc == 0; i++)
+    {
+        a = order[i];
+
+        if (!a->type->has_tag || a->type->cls == CLS_UNIVERSAL)
+            continue;
+
+        name = name_add(d, a->name, -1);
+
+        if (name == 0 || flat_add(d, a->type->tag, name) != 0 ||
+                schema_add(d, 0, a->type->cls, a->type->tag, name, type_content(d, a->type, name, 0)) != 0)
+            rc = -1;
+    }
+
+    free(order);
+
+
+    /* 3. Children of the types, new ones included */
+
+    for (i = 0; i < d->nwork && rc == 0; i++)
+    {
+        w = d->work[i];
+
+        if (w.is_wrap)
+            rc = type_children(d, i + 1, w.type, w.name, FALSE, 0);
+        else if (w.type->kind == K_SEQ)
+            rc = seq_children(d, i + 1, w.type, 0);
+        else if (w.type->kind == K_SEQOF)
+            rc = type_children(d, i + 1, w.type->comps[0].type, name_add(d, w.type->comps[0].ident, -1), TRUE, 0);
+    }
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: flat_add
+|*
+|* Description;
+|*
+|*     Names tag in the flat table, unless it already has a name
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int flat_add(asndict *d, int tag, unsigned int name)
+{
+    unsigned int*   idx_tmp = NULL;
+    int             atags = 0;
+
+    /* 1. Room for the tag */
+
+    if (tag >= d->atags)
+    {
+        atags = (d->atags > 0 ? d->atags : MAXTAGS);
+        while (atags <= tag)
+            atags *= 2;
+
+        if ( ( idx_tmp = (unsigned int *)realloc(d->idx, (size_t)atags * sizeof(unsigned int)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory\n");
+            return -1;
+        }
+        memset(idx_tmp + d->atags, 0x00, (size_t)(atags - d->atags) * sizeof(unsigned int));
+
+        d->idx = idx_tmp;
+        d->atags = atags;
+    }
+
+
+    /* 2. First name given to the tag */
+
+    if (d->idx[tag] != 0)
+    {
+        if (d->idx[tag] != name)
+            fprintf(stderr, "Tag %d of %s already named %s, left out\n", tag, d->pool + name, d->pool + d->idx[tag]);
+        return 0;
+    }
+
+    d->idx[tag] = name;
+    d->count++;
+
+    if (tag >= d->ntags)
+        d->ntags = tag + 1;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: name_add
+|*
+|* Description;
+|*
+|*     Offset of the name str of len bytes (-1: up to the '\0') in the
+|*     names of the dictionary. Each name is stored once.
+|*
+|* Return:
+|*      Offset of the name
+|*      0: str is NULL, or no memory (reported)
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Hash grown by the number of names, not by their bytes
+|*
+****************************************************************************/
+static unsigned int name_add(asndict *d, const char *str, int len)
+{
+    unsigned int*   hash_tmp = NULL;
+    char*           pool_tmp = NULL;
+    unsigned int    h = 2166136261U;
+    unsigned int    i = 0, j = 0, off = 0;
+    int             n = 0;
+
+    if (str == NULL)
+        return 0;
+
+    if (len < 0)
+        len = (int)strlen(str);
+
+    /* 1. Already there? */
+
+    for (n = 0; n < len; n++)
+        h = (h ^ (uchar)str[n]) * 16777619U;
+
+    for (i = h & d->hmask; d->hash != NULL && ( off = d->hash[i] ) != 0; i = (i + 1) & d->hmask)
+    {
+        if (strncmp(d->pool + off, str, (size_t)len) == 0 && d->pool[off + len] == '\0')
+            return off;
+    }
+
+
+    /* 2. Room in the pool and in the hash, kept half free */
+
+    if (d->pool_len + len + 1 > d->pool_alloc)
+    {
+        d->pool_alloc = (d->pool_alloc > 0 ? d->pool_alloc * 2 : 65536) + len;
+        if ( ( pool_tmp = (char *)realloc(d->pool, (size_t)d->pool_alloc) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory\n");
+            return 0;
+        }
+        d->pool = pool_tmp;
+    }
+
+    if (d->hash == NULL || (d->nnames + 1) * 2 > d->hmask + 1)
+    {
+        if ( ( hash_tmp = (unsigned int *)calloc((size_t)(d->hmask + 1) * 4, sizeof(unsigned int)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory\n");
+            return 0;
+        }
+
+        for (j = 0; d->hash != NULL && j <= d->hmask; j++)
+        {
+            if ( ( off = d->hash[j] ) == 0 )
+                continue;
+
+            for (h = 2166136261U, n = 0; d->pool[off + n] != '\0'; n++)
+                h = (h ^ (uchar)d->pool[off + n]) * 16777619U;
+
+            for (i = h & ((d->hmask + 1) * 4 - 1); hash_tmp[i] != 0; i = (i + 1) & ((d->hmask + 1) * 4 - 1))
+                ;
+            hash_tmp[i] = off;
+        }
+
+        free(d->hash);
+        d->hash = hash_tmp;
+        d->hmask = (d->hmask + 1) * 4 - 1;
+
+        return name_add(d, str, len);
+    }
+
+
+    /* 3. New name. "" at offset 0 is not hashed */
+
+    off = (unsigned int)d->pool_len;
+    memcpy(d->pool + off, str, (size_t)len);
+    d->pool[off + len] = '\0';
+    d->pool_len += len + 1;
+
+    if (off != 0)
+    {
+        d->hash[i] = off;
+        d->nnames++;
+    }
+
+    return off;
+}
+
+
+/****************************************************************************
+|*
+|* Function: cmp_assign
+|*
+|* Description;
+|*
+|*     Order of the assignments: by name, then in the order given
+|*
+|* Return:
+|*      <0, 0, >0
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int cmp_assign(const void *a, const void *b)
+{
+    const asnassign* x = (const asnassign *)a;
+    const asnassign* y = (const asnassign *)b;
+    int             rc = strcmp(x->name, y->name);
+
+    return (rc != 0 ? rc : x->order - y->order);
+}
+
+
+/****************************************************************************
+|*
+|* Function: cmp_ent
+|*
+|* Description;
+|*
+|*     Order of the entries of the schema: by type, then by class and tag
+|*
+|* Return:
+|*      <0, 0, >0
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int cmp_ent(const void *a, const void *b)
+{
+    const schemaent* x = (const schemaent *)a;
+    const schemaent* y = (const schemaent *)b;
+
+    if (x->type != y->type)
+        return (x->type < y->type ? -1 : 1);
+
+    return (x->key < y->key ? -1 : x->key > y->key ? 1 : 0);
+}
+
+
+/****************************************************************************
+|*
+|* Function: dict_write
+|*
+|* Description;
+|*
+|*     Lays the flat table out as a tagmap_t, up to the highest tag
+|*     named, puts the children of the schema in a hash table at least
+|*     half free (the first child of a tag in a type is kept) and writes
+|*     both with dict_save()
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error writing or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int dict_write(const asndict *d, const char *filename)
+{
+    static const unsigned int no_tags[1] = { 0 };
+    tagmap_t        map;
+    schemaent*      ents = NULL;
+    const schemaent* e = NULL;
+    unsigned int    nents = 16;
+    unsigned int    i = 0;
+    long            n = 0;
+    int             rc = 0;
+
+    /* 1. Hash table of the schema */
+
+    while (nents < 2 * (unsigned long)d->nents)
+        nents *= 2;
+
+    if ( ( ents = (schemaent *)malloc((size_t)nents * sizeof(schemaent)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory\n");
+        return -1;
+    }
+
+    for (i = 0; i < nents; i++)
+    {
+        memset(&ents[i], 0x00, sizeof(schemaent));
+        ents[i].key = SCHEMA_EMPTY;
+    }
+
+    for (n = 0; n < d->nents; n++)
+    {
+        e = &d->ents[n];
+
+        for (i = schema_hash(e->type, e->key, nents - 1); ents[i].key != SCHEMA_EMPTY; i = (i + 1) & (nents - 1))
+        {
+            if (ents[i].type == e->type && ents[i].key == e->key)
+                break;
+        }
+
+        if (ents[i].key == SCHEMA_EMPTY)
+            ents[i] = *e;
+    }
+
+
+    /* 2. Flat table and schema */
+
+    map.idx = (d->ntags > 0 ? d->idx : no_tags);
+    map.names = d->pool;
+    map.ntags = d->ntags;
+    map.next = NULL;
+
+    rc = dict_save(&map, d->pool_len, ents, (d->nents > 0 ? nents : 0), filename);
+
+    free(ents);
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: dict_list
+|*
+|* Description;
+|*
+|*     Prints the tags with a name of the dictionary filename, then the
+|*     children of each type of its schema: type, tag, name, type of the
+|*     child
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Not a dictionary or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Lists marked with *
+|*
+****************************************************************************/
+static int dict_list(const char *filename)
+{
+    asn1dict        dict;
+    schemaent*      ents = NULL;
+    const schemaent* e = NULL;
+    const char*     name = NULL;
+    unsigned int    i = 0, n = 0;
+    int             tag = 0;
+
+    if (dict_load(&dict, filename, NULL) != 0)
+        return -1;
+
+    /* 1. Flat table */
+
+    for (tag = 0; tag < dict.tagmap.ntags; tag++)
+    {
+        if ( ( name = tagmap_name(&dict.tagmap, tag) ) != NULL )
+            printf("%d\t%s\n", tag, name);
+    }
+
+
+    /* 2. Schema, by type */
+
+    if (dict.schema.ents != NULL)
+    {
+        if ( ( ents = (schemaent *)malloc(((size_t)dict.schema.mask + 1) * sizeof(schemaent)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory\n");
+            dict_close(&dict);
+            return -1;
+        }
+
+        for (i = 0; i <= dict.schema.mask; i++)
+        {
+            if (dict.schema.ents[i].key != SCHEMA_EMPTY)
+                ents[n++] = dict.schema.ents[i];
+        }
+
+        qsort(ents, (size_t)n, sizeof(schemaent), cmp_ent);
+
+        printf("\n# type\ttag\tname\tchild type (*: list)\n");
+
+        for (i = 0; i < n; i++)
+        {
+            e = &ents[i];
+            printf("%u\t[%s%u]\t%s\t%u%s\n", e->type, class_names[e->key >> 30], e->key & 0x3fffffffU,
+                    dict.schema.names + e->name, e->child & ~SCHEMA_LIST, (e->child & SCHEMA_LIST ? "*" : ""));
+        }
+
+        free(ents);
+    }
+
+    dict_close(&dict);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: next_token
+|*
+|* Description;
+|*
+|*     Reads the next token of the specification. Comments ("--" to the
+|*     next "--" or the end of the line, and C-like) and strings are
+|*     jumped over.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void next_token(asnlexer *lx, asntoken *tok)
+{
+    const char*     p = lx->p;
+    const char*     end = lx->end;
+    char            quote = '\0';
+
+    /* 1. Blanks, comments and strings */
+
+    for (;;)
+    {
+        while (p < end && isspace((uchar)*p))
+        {
+            if (*p++ == '\n')
+                lx->line++;
+        }
+
+        if (p + 1 < end && p[0] == '-' && p[1] == '-')
+        {
+            for (p += 2; p < end && *p != '\n' && !(p[0] == '-' && p + 1 < end && p[1] == '-'); p++)
+                ;
+            if (p < end && *p == '-')
+                p += 2;
+            continue;
+        }
+
+        if (p + 1 < end && p[0] == '/' && p[1] == '*')
+        {
+            for (p += 2; p + 1 < end && !(p[0] == '*' && p[1] == '/'); p++)
+            {
+                if (*p == '\n')
+                    lx->line++;
+            }
+            p = (p + 1 < end ? p + 2 : end);
+            continue;
+        }
+
+        if (p < end && (*p == '"' || *p == '\''))
+        {
+            for (quote = *p++; p < end && *p != quote; p++)
+            {
+                if (*p == '\n')
+                    lx->line++;
+            }
+            if (p < end)
+                p++;
+            continue;
+        }
+
+        break;
+    }
+
+
+    /* 2. Token */
+
+    tok->str = p;
+    tok->line = lx->line;
+
+    if (p >= end)
+    {
+        tok->kind = TOK_END;
+    }
+    else if (isalpha((uchar)*p))
+    {
+        /* Hyphens inside the word, never two in a row: "--" starts a comment */
+        for (p++; p < end && (isalnum((uchar)*p) || (*p == '-' && p + 1 < end && isalnum((uchar)p[1]))); p++)
+            ;
+        tok->kind = TOK_WORD;
+    }
+    else if (isdigit((uchar)*p))
+    {
+        for (p++; p < end && isdigit((uchar)*p); p++)
+            ;
+        tok->kind = TOK_NUMBER;
+    }
+    else if (p + 2 < end && p[0] == ':' && p[1] == ':' && p[2] == '=')
+    {
+        p += 3;
+        tok->kind = TOK_ASSIGN;
+    }
+    else
+    {
+        p++;
+        tok->kind = TOK_CHAR;
+    }
+
+    tok->len = (int)(p - tok->str);
+    lx->p = p;
+}
+
+
+/****************************************************************************
+|*
+|* Function: is_token
+|*
+|* Description;
+|*
+|*     Checks if the token is the text str
+|*
+|* Return:
+|*      TRUE/FALSE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int is_token(const asntoken *tok, const char *str)
+{
+    return tok->kind != TOK_END && tok->len == (int)strlen(str) && strncmp(tok->str, str, (size_t)tok->len) == 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: usage
+|*
+|* Description;
+|*
+|*     Show usage
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void usage(const char *program_name)
+{
+    fprintf(stderr, "Usage: %s -o dictionary [-r type] specification.asn [...]\n", program_name);
+    fprintf(stderr, "       %s -l dictionary\n", program_name);
+    fprintf(stderr, "  -o : Dictionary written from the types of the specifications\n");
+    fprintf(stderr, "  -r : Type of the records at the top level of the files, if not tagged\n");
+    fprintf(stderr, "  -l : List the tags, names and schema of a dictionary\n");
+    fprintf(stderr, "The dictionary is read by readasn --dict\n");
+    exit(EXIT_FAILURE);
+}
+
+/* EOF */
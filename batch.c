@@ -0,0 +1,587 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: batch.c
+|*
+|* Description: Batch mode: dumps many files in one process. The files
+|*              (given as arguments, in a list file or as the content of
+|*              directories) are decoded by a pool of threads, one file
+|*              per thread at a time. Each dump goes to its own file in
+|*              an output directory or, otherwise, to the standard output
+|*              with the name of the file at the beginning of each line.
+|*              A file which cannot be decoded is reported and the batch
+|*              goes on with the others.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     CSV and TSV output
+|* 20261016                     Apache Arrow output, with -o only
+|* 20261016                     Tag names of the dictionaries (--dict)
+|* 20261016                     Schema of the dictionaries
+|* 20261016                     Typed values (--typed)
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Typedefs and structures */
+
+typedef struct _batchjob
+{
+    const batchopts* opts;      /* Options of the batch */
+    char**      files;          /* Files to decode */
+    int         nfiles;
+    int*        failed;         /* Files which could not be decoded */
+    int         next;           /* Next file to decode */
+    pthread_mutex_t lock;       /* Lock of next and of the shared output */
+} batchjob;
+
+
+/* 3. Prototypes */
+
+static int      add_file        (char ***files, int *nfiles, int *afiles, const char *name);
+static int      add_dir         (char ***files, int *nfiles, int *afiles, const char *dir);
+static int      add_list        (char ***files, int *nfiles, int *afiles, const char *list);
+static int      cmp_names       (const void *a, const void *b);
+static void*    batch_worker    (void *arg);
+static int      batch_file      (batchjob *job, const char *filename);
+
+
+/* 4. Global Variables */
+
+static const char* batch_suffix[] =             /* Suffix of the dumps, by format */
+{
+    "txt", "json", "csv", "tsv", "arrow"
+};
+
+static const asn1handler* batch_handler[] =     /* Callbacks writing each format */
+{
+    &print_handler, &json_handler, &csv_handler, &csv_handler, &csv_handler
+};
+
+
+/****************************************************************************
+|*
+|* Function: batch_run
+|*
+|* Description;
+|*
+|*     Dumps the files given as names (files or directories) and in the
+|*     list file (one name per line, "-" for stdin) with opts->nthreads
+|*     threads. The files of a directory are taken in alphabetical order.
+|*
+|* Return:
+|*      Number of files which could not be decoded
+|*     -1: Error preparing the batch
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int batch_run(char **names, int nnames, const char *list, const batchopts *opts)
+{
+    batchjob        job;
+    pthread_t*      threads = NULL;
+    struct stat     st;
+    int             afiles = 0, nthreads = 0, nfailed = 0;
+    int             i = 0, rc = 0;
+
+    memset(&job, 0x00, sizeof(job));
+    job.opts = opts;
+
+
+    /* 1. Files to decode */
+
+    for (i = 0; i < nnames && rc == 0; i++)
+    {
+        if (stat(names[i], &st) == 0 && S_ISDIR(st.st_mode))
+            rc = add_dir(&job.files, &job.nfiles, &afiles, names[i]);
+        else
+            rc = add_file(&job.files, &job.nfiles, &afiles, names[i]);
+    }
+
+    if (rc == 0 && list != NULL)
+        rc = add_list(&job.files, &job.nfiles, &afiles, list);
+
+    if (rc == 0 && opts->outdir != NULL && mkdir(opts->outdir, 0777) != 0 && errno != EEXIST)
+    {
+        fprintf(stderr, "Cannot create directory %s: %s\n", opts->outdir, strerror(errno));
+        rc = -1;
+    }
+
+    if (rc == 0 && ( job.failed = (int *)calloc((size_t)job.nfiles + 1, sizeof(int)) ) == NULL)
+    {
+        fprintf(stderr, "Couldn't allocate memory for %d files\n", job.nfiles);
+        rc = -1;
+    }
+
+
+    /* 2. Decode them with the threads */
+
+    if (rc == 0)
+    {
+        nthreads = (opts->nthreads < job.nfiles ? opts->nthreads : job.nfiles);
+
+        pthread_mutex_init(&job.lock, NULL);
+
+        if (nthreads > 1 && ( threads = (pthread_t *)calloc((size_t)nthreads, sizeof(pthread_t)) ) != NULL)
+        {
+            for (i = 0; i < nthreads; i++)
+            {
+                if (pthread_create(&threads[i], NULL, batch_worker, &job) != 0)
+                    break;
+            }
+
+            nthreads = i;
+
+            while (i-- > 0)
+                pthread_join(threads[i], NULL);
+        }
+
+        /* 2.1. One thread, or none could be started: this one */
+
+        if (nthreads <= 1)
+            (void)batch_worker(&job);
+
+        pthread_mutex_destroy(&job.lock);
+
+
+        /* 2.2. Report the files which failed */
+
+        for (i = 0; i < job.nfiles; i++)
+        {
+            if (job.failed[i])
+            {
+                fprintf(stderr, "Failed: %s\n", job.files[i]);
+                nfailed++;
+            }
+        }
+
+        if (nfailed > 0)
+            fprintf(stderr, "%d of %d files failed\n", nfailed, job.nfiles);
+    }
+
+
+    /* 3. Release */
+
+    for (i = 0; i < job.nfiles; i++)
+        free(job.files[i]);
+
+    free(job.files);
+    free(job.failed);
+    free(threads);
+
+    return (rc == 0 ? nfailed : -1);
+}
+
+
+/****************************************************************************
+|*
+|* Function: batch_worker
+|*
+|* Description;
+|*
+|*     Thread of the batch: decodes files until there are no more
+|*
+|* Return:
+|*      NULL
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void *batch_worker(void *arg)
+{
+    batchjob*   job = (batchjob *)arg;
+    int         i = 0;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&job->lock);
+        i = job->next++;
+        pthread_mutex_unlock(&job->lock);
+
+        if (i >= job->nfiles)
+            break;
+
+        if (batch_file(job, job->files[i]) != 0)
+            job->failed[i] = TRUE;
+    }
+
+    return NULL;
+}
+
+
+/****************************************************************************
+|*
+|* Function: batch_file
+|*
+|* Description;
+|*
+|*     Dumps one file to <outdir>/<name of the file>.txt (.json, .csv,
+|*     .tsv, .arrow) or, without output directory, to the shared output with
+|*     "<file>: " before each line of text
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error opening or decoding the file
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int batch_file(batchjob *job, const char *filename)
+{
+    const batchopts* opts = job->opts;
+    asn1ctx         ctx;
+    asn1output      out;
+    asn1printer     pr;
+    asn1filter      flt;
+    csvcols         cols;
+    asn1typed       typed;
+    const char*     base = NULL;
+    char*           path = NULL;
+    char*           tag = NULL;
+    int             fd = -1;
+    int             rc = 0;
+
+    memset(&pr, 0x00, sizeof(pr));
+    memset(&out, 0x00, sizeof(out));
+
+
+    /* 1. Input */
+
+    if (asn1_open(&ctx, filename, opts->max_depth) != 0)
+    {
+        fprintf(stderr, "%s: Error opening the file\n", filename);
+        return -1;
+    }
+
+    if (opts->tagmap != NULL)
+    {
+        asn1_tagmap(&ctx, opts->tagmap);
+        asn1_schema(&ctx, opts->schema);
+    }
+
+
+    /* 2. Output: own file or lines tagged with the name of the file */
+
+    if ( ( path = (char *)malloc(strlen(filename) + (opts->outdir ? strlen(opts->outdir) : 0) + 8) ) == NULL )
+    {
+        fprintf(stderr, "%s: Couldn't allocate memory\n", filename);
+        asn1_close(&ctx);
+        return -1;
+    }
+
+    if (opts->outdir != NULL)
+    {
+        base = strrchr(filename, '/');
+        sprintf(path, "%s/%s.%s", opts->outdir, (base != NULL ? base + 1 : filename),
+                batch_suffix[opts->format]);
+
+        if ( ( fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666) ) == -1 )
+        {
+            fprintf(stderr, "%s: Cannot open %s: %s\n", filename, path, strerror(errno));
+            rc = -1;
+        }
+        else if (output_init(&out, fd, opts->out_size) != 0)
+        {
+            rc = -1;
+        }
+    }
+    else
+    {
+        tag = path;
+        sprintf(tag, "%s: ", filename);
+
+        pr.tag = tag;
+        pr.shared = opts->out;
+        pr.lock = &job->lock;
+
+        if (output_init(&out, -1, PRINT_CHUNK_SIZE * 2) != 0)
+            rc = -1;
+    }
+
+    /* 2.1. Filter: with the tag names of the type of the file */
+
+    if (rc == 0 && opts->filter != NULL)
+    {
+        if (filter_compile(&flt, opts->filter, ctx.tagmap, ctx.schema) != 0)
+            rc = -1;
+        else
+            asn1_filter(&ctx, &flt);
+    }
+
+    /* 2.2. Columns: also with the tag names of the type of the file */
+
+    if (rc == 0 && opts->cols != NULL)
+    {
+        cols = *opts->cols;
+
+        if (csv_bind(&cols, ctx.tagmap, ctx.schema) != 0)
+            rc = -1;
+        else
+            pr.cols = &cols;
+    }
+
+    /* 2.3. Typed values: also with the tag names of the type of the file */
+
+    if (rc == 0 && opts->typed)
+    {
+        if (typed_init(&typed, &ctx) != 0)
+            rc = -1;
+        else
+            pr.typed = &typed;
+    }
+
+    pr.out = &out;
+    pr.name = filename;
+    pr.file = filename;
+    pr.use_tagnames = (opts->use_tagnames && ctx.tagmap != NULL);
+
+    if (!pr.use_tagnames)
+        ctx.tagmap = NULL;              /* The schema also tells the lists: kept */
+
+
+    /* 3. Decode */
+
+    if (rc == 0)
+    {
+        if (opts->format == FMT_TEXT)
+            print_header(&pr, &ctx);
+        else if (opts->format == FMT_ARROW)
+            rc = arrow_header(&pr);
+        else if (pr.cols != NULL && opts->outdir != NULL)
+            csv_header(&pr);
+
+        if (rc == 0 && asn1_decode(&ctx, batch_handler[opts->format], &pr) != 0)
+            rc = -1;
+
+        print_flush(&pr);
+        print_close(&pr);
+    }
+
+
+    /* 4. Close */
+
+    if (output_close(&out) != 0)
+        rc = -1;
+
+    if (fd != -1)
+        (void)close(fd);
+
+    if (pr.typed != NULL)
+        typed_close(pr.typed);
+
+    asn1_close(&ctx);
+    free(path);
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: add_file
+|*
+|* Description;
+|*
+|*     Adds a name to the list of files to decode
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int add_file(char ***files, int *nfiles, int *afiles, const char *name)
+{
+    char**      more = NULL;
+
+    if (*nfiles == *afiles)
+    {
+        if ( ( more = (char **)realloc(*files, (size_t)(*afiles + 256) * sizeof(char *)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the list of files\n");
+            return -1;
+        }
+        *files = more;
+        *afiles += 256;
+    }
+
+    if ( ( (*files)[*nfiles] = strdup(name) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the list of files\n");
+        return -1;
+    }
+
+    (*nfiles)++;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: add_dir
+|*
+|* Description;
+|*
+|*     Adds the regular files of a directory, in alphabetical order.
+|*     Hidden files are left out.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error reading the directory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int add_dir(char ***files, int *nfiles, int *afiles, const char *dir)
+{
+    DIR*            d = NULL;
+    struct dirent*  de = NULL;
+    struct stat     st;
+    char*           path = NULL;
+    int             first = *nfiles;
+    int             rc = 0;
+
+    if ( ( d = opendir(dir) ) == NULL )
+    {
+        fprintf(stderr, "Cannot open directory %s: %s\n", dir, strerror(errno));
+        return -1;
+    }
+
+    while (rc == 0 && ( de = readdir(d) ) != NULL)
+    {
+        if (de->d_name[0] == '.')
+            continue;
+
+        if ( ( path = (char *)malloc(strlen(dir) + strlen(de->d_name) + 2) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the list of files\n");
+            rc = -1;
+            break;
+        }
+
+        sprintf(path, "%s/%s", dir, de->d_name);
+
+        if (stat(path, &st) == 0 && S_ISREG(st.st_mode))
+            rc = add_file(files, nfiles, afiles, path);
+
+        free(path);
+    }
+
+    (void)closedir(d);
+
+    qsort(*files + first, (size_t)(*nfiles - first), sizeof(char *), cmp_names);
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: add_list
+|*
+|* Description;
+|*
+|*     Adds the files named in a list file, one per line. Empty lines are
+|*     left out.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error reading the list
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int add_list(char ***files, int *nfiles, int *afiles, const char *list)
+{
+    FILE*       fp = NULL;
+    char        line[4096];
+    size_t      len = 0;
+    int         rc = 0;
+
+    if (strcmp(list, "-") == 0)
+        fp = stdin;
+    else if ( ( fp = fopen(list, "r") ) == NULL )
+    {
+        fprintf(stderr, "Cannot open list %s: %s\n", list, strerror(errno));
+        return -1;
+    }
+
+    while (rc == 0 && fgets(line, sizeof(line), fp) != NULL)
+    {
+        len = strlen(line);
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            line[--len] = '\0';
+
+        if (len > 0)
+            rc = add_file(files, nfiles, afiles, line);
+    }
+
+    if (fp != stdin)
+        (void)fclose(fp);
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: cmp_names
+|*
+|* Description;
+|*
+|*     Compares two names for qsort()
+|*
+|* Return:
+|*      As strcmp()
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int cmp_names(const void *a, const void *b)
+{
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/* EOF */
@@ -0,0 +1,665 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: decode_bench.c
+|*
+|* Description: Microbenchmark of the decoders of the headers of the
+|*              elements: decode_tag() with tags of 1 to 4 octets,
+|*              decode_size() with the short, long and indefinite forms,
+|*              bcd_2_hexa() on tags and sizes, and the check of printable
+|*              values (hexa_encode_check() and hexa_printable()) on the
+|*              values found in TAP files. The mixes follow the tags,
+|*              sizes and values of a TAP file.
+|*
+|*              The decoders are linked from libreadasn (readasn.h). The
+|*              headers are decoded from memory, as from a mapped file.
+|*
+|*              Prints one line per measure: name and ns/op. With the
+|*              output of a former run (of another build) as argument, the
+|*              change against it is printed too:
+|*
+|*                  bench/decode_bench > before.txt
+|*                  (change and rebuild)
+|*                  bench/decode_bench before.txt
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Decoders linked from libreadasn, not included
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+#include "../readasn.h"
+
+
+/* 2. Defines */
+
+#define BENCH_ITEMS     (1 << 16)       /* Headers or values of each buffer */
+#define BENCH_OPS       (1L << 22)      /* Operations per run */
+#define BENCH_RUNS      3               /* Runs per measure: the fastest one counts */
+#define BENCH_MAX_BASE  256             /* Measures of the former run */
+
+
+/* 3. Types */
+
+typedef struct
+{
+    const char*     name;
+    int             weights[5];         /* Weight of each kind of header or value */
+} benchmix;
+
+typedef struct
+{
+    char            name[64];
+    double          ns;
+} benchbase;
+
+
+/* 4. Prototypes */
+
+static long     fill_tags       (uchar *buff, const int *weights);
+static long     fill_sizes      (uchar *buff, const int *weights);
+static long     fill_values     (uchar *buff, long *offs, long *lens, const int *weights);
+static int      pick            (const int *weights);
+static double   bench_tags      (const uchar *buff, long len, int (*decode)(asn1ctx *, asn1item *));
+static double   bench_hexa      (const int *weights);
+static double   bench_check     (const uchar *buff, const long *offs, const long *lens, int (*check)(char *, const uchar *, long));
+static double   elapsed         (const struct timespec *start);
+static void     report          (const char *name, double ns);
+static int      check_selected  (char *dst, const uchar *src, long len);
+
+
+/* 5. Global Variables */
+
+static benchbase    base[BENCH_MAX_BASE];       /* Measures of the former run */
+static int          nbase = 0;
+
+static const benchmix tag_mixes[] =             /* Octets of the tags: 1, 2, 3, 4 */
+{
+    { "1",      { 1, 0, 0, 0 } },
+    { "2",      { 0, 1, 0, 0 } },
+    { "3",      { 0, 0, 1, 0 } },
+    { "4",      { 0, 0, 0, 1 } },
+    { "tap",    { 20, 25, 55, 0 } },
+    { NULL,     { 0 } }
+};
+
+static const benchmix size_mixes[] =            /* Form of the sizes: short, 0x81, 0x82, 0x84, indefinite */
+{
+    { "short",  { 1, 0, 0, 0, 0 } },
+    { "long1",  { 0, 1, 0, 0, 0 } },
+    { "long2",  { 0, 0, 1, 0, 0 } },
+    { "long4",  { 0, 0, 0, 1, 0 } },
+    { "indef",  { 0, 0, 0, 0, 1 } },
+    { "tap",    { 90, 6, 3, 0, 1 } },
+    { NULL,     { 0 } }
+};
+
+static const benchmix value_mixes[] =           /* Values: integer, TBCD, time stamp, text, binary */
+{
+    { "int",    { 1, 0, 0, 0, 0 } },
+    { "tbcd",   { 0, 1, 0, 0, 0 } },
+    { "time",   { 0, 0, 1, 0, 0 } },
+    { "text",   { 0, 0, 0, 1, 0 } },
+    { "binary", { 0, 0, 0, 0, 1 } },
+    { "tap",    { 45, 20, 15, 15, 5 } },
+    { NULL,     { 0 } }
+};
+
+
+int main(int argc, char **argv)
+{
+    static uchar        buff[BENCH_ITEMS * 64];
+    static long         offs[BENCH_ITEMS];
+    static long         lens[BENCH_ITEMS];
+    FILE*               fp = NULL;
+    char                name[64];
+    long                len = 0;
+    int                 i = 0, k = 0;
+
+    struct
+    {
+        const char*     name;
+        int           (*check)(char *, const uchar *, long);
+    } kernels[] =
+    {
+        { "scalar",     hexa_encode_check_scalar },
+#ifdef HEXA_X86
+        { "sse2",       hexa_encode_check_sse2 },
+        { "avx2",       __builtin_cpu_supports("avx2") ? hexa_encode_check_avx2 : NULL },
+#endif
+        { "selected",   check_selected },
+    };
+
+    /* 1. Former run to compare with */
+
+    if (argc > 2)
+    {
+        fprintf(stderr, "Usage: %s [output of a former run]\n", argv[0]);
+        return 1;
+    }
+
+    if (argc == 2)
+    {
+        if ( ( fp = fopen(argv[1], "r") ) == NULL )
+        {
+            perror(argv[1]);
+            return 1;
+        }
+
+        while (nbase < BENCH_MAX_BASE && fscanf(fp, "%63s %lf%*[^\n]", base[nbase].name, &base[nbase].ns) == 2)
+            nbase++;
+
+        fclose(fp);
+    }
+
+    hexa_init();
+    srand(1);
+
+
+    /* 2. decode_tag() */
+
+    for (i = 0; tag_mixes[i].name != NULL; i++)
+    {
+        len = fill_tags(buff, tag_mixes[i].weights);
+        snprintf(name, sizeof(name), "decode_tag/%s", tag_mixes[i].name);
+        report(name, bench_tags(buff, len, decode_tag));
+    }
+
+
+    /* 3. decode_size() */
+
+    for (i = 0; size_mixes[i].name != NULL; i++)
+    {
+        len = fill_sizes(buff, size_mixes[i].weights);
+        snprintf(name, sizeof(name), "decode_size/%s", size_mixes[i].name);
+        report(name, bench_tags(buff, len, decode_size));
+    }
+
+
+    /* 4. bcd_2_hexa(): tags and sizes of 1 to 4 octets */
+
+    for (i = 0; tag_mixes[i].name != NULL; i++)
+    {
+        snprintf(name, sizeof(name), "bcd_2_hexa/%s", tag_mixes[i].name);
+        report(name, bench_hexa(tag_mixes[i].weights));
+    }
+
+
+    /* 5. is_printable: hexa_encode_check() and hexa_printable() */
+
+    for (i = 0; value_mixes[i].name != NULL; i++)
+    {
+        fill_values(buff, offs, lens, value_mixes[i].weights);
+
+        for (k = 0; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++)
+        {
+            if (kernels[k].check == NULL)
+                continue;
+
+            snprintf(name, sizeof(name), "is_printable/%s/%s", value_mixes[i].name, kernels[k].name);
+            report(name, bench_check(buff, offs, lens, kernels[k].check));
+        }
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: fill_tags
+|*
+|* Description;
+|*
+|*     Fills buff with BENCH_ITEMS tags, of 1 to 4 octets according to
+|*     weights
+|*
+|* Return:
+|*      Bytes written
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long fill_tags(uchar *buff, const int *weights)
+{
+    static const int    first[] = { 0, 31, 128, 16384 };    /* First tag of each number of octets */
+    static const int    count[] = { 31, 97, 16256, 2080768 };
+    long                len = 0;
+    int                 tag = 0;
+    int                 n = 0, i = 0;
+
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        n = pick(weights);
+        tag = first[n] + rand() % count[n];
+
+        if (n == 0)
+        {
+            buff[len++] = (uchar)(0x40 | tag);
+            continue;
+        }
+
+        buff[len++] = 0x5f;
+        for (; n > 0; n--)
+            buff[len++] = (uchar)((n > 1 ? 0x80 : 0x00) | ((tag >> (7 * (n - 1))) & 0x7f));
+    }
+
+    return len;
+}
+
+
+/****************************************************************************
+|*
+|* Function: fill_sizes
+|*
+|* Description;
+|*
+|*     Fills buff with BENCH_ITEMS sizes, of each form according to
+|*     weights
+|*
+|* Return:
+|*      Bytes written
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long fill_sizes(uchar *buff, const int *weights)
+{
+    static const int    octets[] = { 0, 1, 2, 4, 0 };
+    long                len = 0;
+    long                size = 0;
+    int                 n = 0, i = 0, k = 0;
+
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        k = pick(weights);
+
+        if (k == 0)
+        {
+            buff[len++] = (uchar)(rand() % 128);
+            continue;
+        }
+
+        if (k == 4)
+        {
+            buff[len++] = 0x80;
+            continue;
+        }
+
+        size = 128 + rand() % (k == 1 ? 128 : 65536 - 128);
+        buff[len++] = (uchar)(0x80 | octets[k]);
+        for (n = octets[k]; n > 0; n--)
+            buff[len++] = (uchar)(size >> (8 * (n - 1)));
+    }
+
+    return len;
+}
+
+
+/****************************************************************************
+|*
+|* Function: fill_values
+|*
+|* Description;
+|*
+|*     Fills buff with BENCH_ITEMS values of each kind according to
+|*     weights: integers (1-4 bytes), TBCD numbers (6-8), time stamps
+|*     (14 digits), text (2-8 letters), binary (16-64 bytes)
+|*
+|* Return:
+|*      Bytes written
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long fill_values(uchar *buff, long *offs, long *lens, const int *weights)
+{
+    long                len = 0;
+    long                n = 0;
+    long                j = 0;
+    int                 i = 0;
+
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        offs[i] = len;
+
+        switch (pick(weights))
+        {
+            case 0:
+                for (n = 1 + rand() % 4, j = 0; j < n; j++)
+                    buff[len + j] = (uchar)rand();
+                break;
+            case 1:
+                for (n = 6 + rand() % 3, j = 0; j < n; j++)
+                    buff[len + j] = (uchar)((rand() % 10) | (rand() % 10) << 4);
+                buff[len + n - 1] |= 0xf0;
+                break;
+            case 2:
+                for (n = 14, j = 0; j < n; j++)
+                    buff[len + j] = (uchar)('0' + rand() % 10);
+                break;
+            case 3:
+                for (n = 2 + rand() % 7, j = 0; j < n; j++)
+                    buff[len + j] = (uchar)('A' + rand() % 26);
+                break;
+            default:
+                for (n = 16 + rand() % 49, j = 0; j < n; j++)
+                    buff[len + j] = (uchar)rand();
+                break;
+        }
+
+        lens[i] = n;
+        len += n;
+    }
+
+    return len;
+}
+
+
+/****************************************************************************
+|*
+|* Function: pick
+|*
+|* Description;
+|*
+|*     Random kind, with the probabilities of weights (5 of them)
+|*
+|* Return:
+|*      Index of the kind
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int pick(const int *weights)
+{
+    int                 total = 0;
+    int                 r = 0;
+    int                 i = 0;
+
+    for (i = 0; i < 5; i++)
+        total += weights[i];
+
+    r = rand() % total;
+
+    for (i = 0; r >= weights[i]; i++)
+        r -= weights[i];
+
+    return i;
+}
+
+
+/****************************************************************************
+|*
+|* Function: bench_tags
+|*
+|* Description;
+|*
+|*     Decodes the BENCH_ITEMS headers of buff with decode (decode_tag()
+|*     or decode_size()) until BENCH_OPS calls, BENCH_RUNS times
+|*
+|* Return:
+|*      Nanoseconds per call
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static double bench_tags(const uchar *buff, long len, int (*decode)(asn1ctx *, asn1item *))
+{
+    struct timespec     start;
+    asn1ctx             ctx;
+    asn1item            item;
+    double              ns = 0, best = 0;
+    long                pass = 0;
+    int                 run = 0;
+    int                 i = 0;
+
+    memset(&ctx, 0x00, sizeof(ctx));
+    memset(&item, 0x00, sizeof(item));
+    ctx.in.mode = IN_MMAP;
+    ctx.in.map = buff;
+    ctx.in.len = len;
+    ctx.in.is_view = TRUE;
+
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for (pass = 0; pass < BENCH_OPS / BENCH_ITEMS; pass++)
+        {
+            ctx.in.pos = ctx.pos = 0;
+
+            for (i = 0; i < BENCH_ITEMS; i++)
+            {
+                if (decode(&ctx, &item) != 0)
+                {
+                    fprintf(stderr, "Error decoding the headers of the benchmark\n");
+                    exit(EXIT_FAILURE);
+                }
+                __asm__ volatile("" : : "r"(&item) : "memory");
+            }
+        }
+
+        ns = elapsed(&start) / (double)(pass * BENCH_ITEMS);
+        if (run == 0 || ns < best)
+            best = ns;
+    }
+
+    return best;
+}
+
+
+/****************************************************************************
+|*
+|* Function: bench_hexa
+|*
+|* Description;
+|*
+|*     Converts tags of 1 to 4 octets, according to weights, with
+|*     bcd_2_hexa(), BENCH_RUNS times
+|*
+|* Return:
+|*      Nanoseconds per call
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static double bench_hexa(const int *weights)
+{
+    static uchar        lens[BENCH_ITEMS];
+    struct timespec     start;
+    uchar               src[4] = { 0x7f, 0x81, 0x13, 0x00 };
+    char                dst[16];
+    double              ns = 0, best = 0;
+    long                pass = 0;
+    int                 run = 0;
+    int                 i = 0;
+
+    for (i = 0; i < BENCH_ITEMS; i++)
+        lens[i] = (uchar)(1 + pick(weights));
+
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for (pass = 0; pass < BENCH_OPS / BENCH_ITEMS; pass++)
+        {
+            for (i = 0; i < BENCH_ITEMS; i++)
+            {
+                bcd_2_hexa(dst, src, lens[i]);
+                __asm__ volatile("" : : "r"(dst) : "memory");
+            }
+        }
+
+        ns = elapsed(&start) / (double)(pass * BENCH_ITEMS);
+        if (run == 0 || ns < best)
+            best = ns;
+    }
+
+    return best;
+}
+
+
+/****************************************************************************
+|*
+|* Function: bench_check
+|*
+|* Description;
+|*
+|*     Converts the BENCH_ITEMS values of buff with check and tells if
+|*     they are printable, until BENCH_OPS calls, BENCH_RUNS times
+|*
+|* Return:
+|*      Nanoseconds per value
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static double bench_check(const uchar *buff, const long *offs, const long *lens, int (*check)(char *, const uchar *, long))
+{
+    struct timespec     start;
+    char                dst[2 * 64 + 1];
+    double              ns = 0, best = 0;
+    long                pass = 0;
+    int                 printable = 0;
+    int                 run = 0;
+    int                 i = 0;
+
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for (pass = 0; pass < BENCH_OPS / BENCH_ITEMS; pass++)
+        {
+            for (i = 0; i < BENCH_ITEMS; i++)
+            {
+                printable += hexa_printable(check(dst, buff + offs[i], lens[i]), lens[i]);
+                __asm__ volatile("" : : "r"(dst) : "memory");
+            }
+        }
+
+        ns = elapsed(&start) / (double)(pass * BENCH_ITEMS);
+        if (run == 0 || ns < best)
+            best = ns;
+    }
+
+    __asm__ volatile("" : : "r"(printable));
+
+    return best;
+}
+
+
+/****************************************************************************
+|*
+|* Function: elapsed
+|*
+|* Description;
+|*
+|*     Nanoseconds since start
+|*
+|* Return:
+|*      The nanoseconds
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static double elapsed(const struct timespec *start)
+{
+    struct timespec     end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+
+/****************************************************************************
+|*
+|* Function: report
+|*
+|* Description;
+|*
+|*     Prints a measure and, if the former run has it, the change
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void report(const char *name, double ns)
+{
+    int                 i = 0;
+
+    printf("%-32s %9.2f ns/op", name, ns);
+
+    for (i = 0; i < nbase; i++)
+    {
+        if (strcmp(base[i].name, name) == 0)
+        {
+            printf("  was %9.2f  %+7.1f%%", base[i].ns, (ns - base[i].ns) * 100.0 / base[i].ns);
+            break;
+        }
+    }
+
+    printf("\n");
+    fflush(stdout);
+}
+
+
+/****************************************************************************
+|*
+|* Function: check_selected
+|*
+|* Description;
+|*
+|*     hexa_encode_check() as called by the printer: the kernel chosen
+|*     for the length
+|*
+|* Return:
+|*      Flags of hexa_encode_check()
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int check_selected(char *dst, const uchar *src, long len)
+{
+    return hexa_encode_check(dst, src, len);
+}
+
+/* EOF */
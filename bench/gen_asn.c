@@ -0,0 +1,1051 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: gen_asn.c
+|*
+|* Description: Generator of synthetic TAP 3.09, TAP 3.12, NRTRDE 2.01 and
+|*              RAP 1.05 files for the benchmarks. The files are described
+|*              by templates of tag names, whose numbers are looked up in
+|*              the tag names of readasn (tagnames.c). The records are
+|*              mobile originated calls with changing values, and the
+|*              counts and totals of the trailers match them.
+|*
+|*              -d adds levels of nesting to each record (constructed
+|*              elements with tag 0, not in the specifications) and -i
+|*              encodes some records with indefinite length.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Numbers and IMEI in BCD, dialled digits in ASCII
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+
+#include "../readasn.h"
+
+
+/* 2. Defines */
+
+#define GEN_MAX_NODES   64              /* Nodes of a template */
+#define GEN_MAX_DEPTH   (MAXDEPTH + 16) /* Constructed elements open at once */
+#define GEN_APPL        0x40            /* Class of the tags: application */
+#define GEN_BASE_TIME   1776297600L     /* 2026-04-16 00:00:00: time of the first call */
+
+/* Values of the nodes of the templates */
+enum
+{
+    V_CONS,         /* Constructed element: the nodes after it, one level deeper */
+    V_RECORDS,      /* Constructed element with the records */
+    V_SENDER, V_RECIPIENT, V_FILESEQ, V_NRTSEQ,
+    V_FILETIME, V_FIRSTTIME, V_LASTTIME, V_CALLTIME,
+    V_UTC, V_ZERO, V_ONE, V_VER, V_REL, V_RAPVER, V_RAPREL,
+    V_CURRENCY, V_TAPCURRENCY, V_DECIMALS, V_RATE, V_RATEDECIMALS,
+    V_RECID, V_IMSI, V_MSISDN, V_CALLED, V_DIALLED, V_IMEI, V_LAC, V_CELL,
+    V_DURATION, V_TELESERVICE, V_CHARGEDITEM, V_CHARGETYPE, V_CHARGE,
+    V_TOTAL, V_COUNT, V_ERRORCODE
+};
+
+
+/* 3. Types */
+
+typedef struct
+{
+    int         depth;          /* Level in the template: children follow one level deeper */
+    const char* name;           /* Name of the tag, looked up in tagnames.c */
+    int         val;            /* V_*: constructed or value of a primitive */
+} gennode;
+
+typedef struct
+{
+    const char*     type;       /* Name given with -t */
+    const tagmap_t* map;        /* Names of the tags */
+    int             ver;        /* Specification and release versions */
+    int             rel;
+    const gennode*  file;       /* Template of the file, with V_RECORDS */
+    const gennode*  record;     /* Template of each record */
+} genspec;
+
+typedef struct
+{
+    uchar*      buff;           /* File being generated */
+    long        len;
+    long        size;
+    long        open[GEN_MAX_DEPTH]; /* Position of the length of each constructed element open */
+    int         top;
+} genbuf;
+
+typedef struct
+{
+    const genspec*  spec;
+    int         file_tags[GEN_MAX_NODES]; /* Numbers of the tags of the templates */
+    int         record_tags[GEN_MAX_NODES];
+    long        nrec;           /* Records to generate */
+    int         nesting;        /* Levels added to each record */
+    int         indef;          /* Every indef records one has indefinite length. 0: none */
+    unsigned    seed;           /* State of the random values */
+    long        recno;          /* Record being generated */
+    long        duration;       /* Values of the record */
+    long        charge;
+    long long   total;          /* Sum of the charges */
+} genstate;
+
+
+/* 4. Prototypes */
+
+static int      gen_bind        (const gennode *t, int *tags, const tagmap_t *map, const char *type);
+static void     gen_template    (genbuf *b, genstate *st, const gennode *t, const int *tags, int indef);
+static void     gen_records     (genbuf *b, genstate *st);
+static void     gen_value       (genbuf *b, genstate *st, int val);
+static void     gen_open        (genbuf *b, int tag, int indef);
+static void     gen_close       (genbuf *b);
+static void     gen_tag         (genbuf *b, int cons, int tag);
+static void     gen_int         (genbuf *b, long long value);
+static void     gen_text        (genbuf *b, const char *str);
+static void     gen_tbcd        (genbuf *b, const char *digits);
+static void     gen_bcd         (genbuf *b, const char *digits);
+static void     gen_time        (genbuf *b, long t);
+static void     gen_put         (genbuf *b, const void *data, long len);
+static unsigned gen_rand        (genstate *st, unsigned max);
+static void     usage           (const char *program_name);
+
+
+/* 5. Templates */
+
+#define TAP_RECORD(NAME) \
+    { 0, NAME,                      V_CONS }, \
+    { 1, "MoBasicCallInformation",  V_CONS }, \
+    { 2, "ChargeableSubscriber",    V_CONS }, \
+    { 3, "SimChargeableSubscriber", V_CONS }, \
+    { 4, "Imsi",                    V_IMSI }, \
+    { 4, "Msisdn",                  V_MSISDN }, \
+    { 2, "Destination",             V_CONS }, \
+    { 3, "CalledNumber",            V_CALLED }, \
+    { 2, "CallEventStartTimeStamp", V_CONS }, \
+    { 3, "LocalTimeStamp",          V_CALLTIME }, \
+    { 3, "UtcTimeOffsetCode",       V_ZERO }, \
+    { 2, "TotalCallEventDuration",  V_DURATION }, \
+    { 1, "LocationInformation",     V_CONS }, \
+    { 2, "NetworkLocation",         V_CONS }, \
+    { 3, "RecEntityCode",           V_ONE }, \
+    { 3, "LocationArea",            V_LAC }, \
+    { 3, "CellId",                  V_CELL }, \
+    { 1, "ImeiOrEsn",               V_CONS }, \
+    { 2, "Imei",                    V_IMEI }, \
+    { 1, "BasicServiceUsedList",    V_CONS }, \
+    { 2, "BasicServiceUsed",        V_CONS }, \
+    { 3, "BasicService",            V_CONS }, \
+    { 4, "BasicServiceCode",        V_CONS }, \
+    { 5, "TeleServiceCode",         V_TELESERVICE }, \
+    { 3, "ChargeInformationList",   V_CONS }, \
+    { 4, "ChargeInformation",       V_CONS }, \
+    { 5, "ChargedItem",             V_CHARGEDITEM }, \
+    { 5, "ChargeDetailList",        V_CONS }, \
+    { 6, "ChargeDetail",            V_CONS }, \
+    { 7, "ChargeType",              V_CHARGETYPE }, \
+    { 7, "Charge",                  V_CHARGE }, \
+    { 7, "ChargeableUnits",         V_DURATION }, \
+    { 7, "ChargedUnits",            V_DURATION }, \
+    { -1, NULL, 0 }
+
+#define TAP_BATCH_CONTROL_INFO \
+    { 1, "BatchControlInfo",        V_CONS }, \
+    { 2, "Sender",                  V_SENDER }, \
+    { 2, "Recipient",               V_RECIPIENT }, \
+    { 2, "FileSequenceNumber",      V_FILESEQ }, \
+    { 2, "FileCreationTimeStamp",   V_CONS }, \
+    { 3, "LocalTimeStamp",          V_FILETIME }, \
+    { 3, "UtcTimeOffset",           V_UTC }, \
+    { 2, "TransferCutOffTimeStamp", V_CONS }, \
+    { 3, "LocalTimeStamp",          V_FILETIME }, \
+    { 3, "UtcTimeOffset",           V_UTC }, \
+    { 2, "FileAvailableTimeStamp",  V_CONS }, \
+    { 3, "LocalTimeStamp",          V_FILETIME }, \
+    { 3, "UtcTimeOffset",           V_UTC }, \
+    { 2, "SpecificationVersionNumber", V_VER }, \
+    { 2, "ReleaseVersionNumber",    V_REL }
+
+#define TAP_AUDIT_CONTROL_INFO \
+    { 1, "AuditControlInfo",        V_CONS }, \
+    { 2, "EarliestCallTimeStamp",   V_CONS }, \
+    { 3, "LocalTimeStamp",          V_FIRSTTIME }, \
+    { 3, "UtcTimeOffset",           V_UTC }, \
+    { 2, "LatestCallTimeStamp",     V_CONS }, \
+    { 3, "LocalTimeStamp",          V_LASTTIME }, \
+    { 3, "UtcTimeOffset",           V_UTC }, \
+    { 2, "TotalCharge",             V_TOTAL }, \
+    { 2, "TotalTaxValue",           V_ZERO }, \
+    { 2, "TotalDiscountValue",      V_ZERO }, \
+    { 2, "CallEventDetailsCount",   V_COUNT }
+
+static const gennode tap_record[] = { TAP_RECORD("MobileOriginatedCall") };
+
+static const gennode tap309_file[] =
+{
+    { 0, "TransferBatch",           V_CONS },
+    TAP_BATCH_CONTROL_INFO,
+    { 1, "AccountingInfo",          V_CONS },
+    { 2, "LocalCurrency",           V_CURRENCY },
+    { 2, "TapCurrency",             V_TAPCURRENCY },
+    { 2, "CurrencyConversion",      V_CONS },
+    { 3, "ExchangeRateDefinition",  V_CONS },
+    { 4, "ExchangeRateCode",        V_ONE },
+    { 4, "NumberOfDecimalPlaces",   V_RATEDECIMALS },
+    { 4, "ExchangeRate",            V_RATE },
+    { 2, "TapDecimalPlaces",        V_DECIMALS },
+    { 1, "NetworkInfo",             V_CONS },
+    { 2, "UtcTimeOffsetInfo",       V_CONS },
+    { 3, "UtcTimeOffsetDefinition", V_CONS },
+    { 4, "UtcTimeOffsetCode",       V_ZERO },
+    { 4, "UtcTimeOffset",           V_UTC },
+    { 2, "RecEntityTable",          V_CONS },
+    { 3, "RecEntityDefinition",     V_CONS },
+    { 4, "RecEntityCode",           V_ONE },
+    { 4, "RecEntityType",           V_ONE },
+    { 4, "RecEntityId",             V_RECID },
+    { 1, "CallEventDetailList",     V_RECORDS },
+    TAP_AUDIT_CONTROL_INFO,
+    { -1, NULL, 0 }
+};
+
+static const gennode tap312_file[] =
+{
+    { 0, "TransferBatch",           V_CONS },
+    TAP_BATCH_CONTROL_INFO,
+    { 1, "AccountingInfo",          V_CONS },
+    { 2, "LocalCurrency",           V_CURRENCY },
+    { 2, "TapCurrency",             V_TAPCURRENCY },
+    { 2, "CurrencyConversionList",  V_CONS },
+    { 3, "CurrencyConversion",      V_CONS },
+    { 4, "ExchangeRateCode",        V_ONE },
+    { 4, "NumberOfDecimalPlaces",   V_RATEDECIMALS },
+    { 4, "ExchangeRate",            V_RATE },
+    { 2, "TapDecimalPlaces",        V_DECIMALS },
+    { 1, "NetworkInfo",             V_CONS },
+    { 2, "UtcTimeOffsetInfoList",   V_CONS },
+    { 3, "UtcTimeOffsetInfo",       V_CONS },
+    { 4, "UtcTimeOffsetCode",       V_ZERO },
+    { 4, "UtcTimeOffset",           V_UTC },
+    { 2, "RecEntityInfoList",       V_CONS },
+    { 3, "RecEntityInformation",    V_CONS },
+    { 4, "RecEntityCode",           V_ONE },
+    { 4, "RecEntityType",           V_ONE },
+    { 4, "RecEntityId",             V_RECID },
+    { 1, "CallEventDetailList",     V_RECORDS },
+    TAP_AUDIT_CONTROL_INFO,
+    { -1, NULL, 0 }
+};
+
+static const gennode nrt_file[] =
+{
+    { 0, "Nrtrde",                  V_CONS },
+    { 1, "SpecificationVersionNumber", V_VER },
+    { 1, "ReleaseVersionNumber",    V_REL },
+    { 1, "Sender",                  V_SENDER },
+    { 1, "Recipient",               V_RECIPIENT },
+    { 1, "SequenceNumber",          V_NRTSEQ },
+    { 1, "FileAvailableTimeStamp",  V_FILETIME },
+    { 1, "UtcTimeOffset",           V_UTC },
+    { 1, "CallEventsCount",         V_COUNT },
+    { 1, "CallEventList",           V_RECORDS },
+    { -1, NULL, 0 }
+};
+
+static const gennode nrt_record[] =
+{
+    { 0, "Moc",                     V_CONS },
+    { 1, "Imsi",                    V_IMSI },
+    { 1, "Imei",                    V_IMEI },
+    { 1, "CallEventStartTimeStamp", V_CALLTIME },
+    { 1, "UtcTimeOffset",           V_UTC },
+    { 1, "CallEventDuration",       V_DURATION },
+    { 1, "CauseForTermination",     V_ZERO },
+    { 1, "TeleServiceCode",         V_TELESERVICE },
+    { 1, "DialledDigits",           V_DIALLED },
+    { 1, "ConnectedNumber",         V_CALLED },
+    { 1, "RecEntityId",             V_RECID },
+    { 1, "ChargeAmount",            V_CHARGE },
+    { -1, NULL, 0 }
+};
+
+static const gennode rap_file[] =
+{
+    { 0, "ReturnBatch",             V_CONS },
+    { 1, "RapBatchControlInfo",     V_CONS },
+    { 2, "Sender",                  V_SENDER },
+    { 2, "Recipient",               V_RECIPIENT },
+    { 2, "RapFileSequenceNumber",   V_FILESEQ },
+    { 2, "RapFileCreationTimeStamp", V_CONS },
+    { 3, "LocalTimeStamp",          V_FILETIME },
+    { 3, "UtcTimeOffset",           V_UTC },
+    { 2, "RapFileAvailableTimeStamp", V_CONS },
+    { 3, "LocalTimeStamp",          V_FILETIME },
+    { 3, "UtcTimeOffset",           V_UTC },
+    { 2, "SpecificationVersionNumber", V_VER },
+    { 2, "ReleaseVersionNumber",    V_REL },
+    { 2, "RapSpecificationVersionNumber", V_RAPVER },
+    { 2, "RapReleaseVersionNumber", V_RAPREL },
+    { 2, "TapDecimalPlaces",        V_DECIMALS },
+    { 1, "ReturnDetailList",        V_RECORDS },
+    { 1, "RapAuditControlInfo",     V_CONS },
+    { 2, "TotalSevereReturnValue",  V_TOTAL },
+    { 2, "ReturnDetailsCount",      V_COUNT },
+    { -1, NULL, 0 }
+};
+
+static const gennode rap_record[] =
+{
+    { 0, "SevereReturn",            V_CONS },
+    { 1, "FileSequenceNumber",      V_FILESEQ },
+    { 1, "MobileOriginatedCall",    V_CONS },
+    { 2, "MoBasicCallInformation",  V_CONS },
+    { 3, "ChargeableSubscriber",    V_CONS },
+    { 4, "SimChargeableSubscriber", V_CONS },
+    { 5, "Imsi",                    V_IMSI },
+    { 3, "CallEventStartTimeStamp", V_CONS },
+    { 4, "LocalTimeStamp",          V_CALLTIME },
+    { 4, "UtcTimeOffsetCode",       V_ZERO },
+    { 3, "TotalCallEventDuration",  V_DURATION },
+    { 2, "BasicServiceUsedList",    V_CONS },
+    { 3, "BasicServiceUsed",        V_CONS },
+    { 4, "ChargeInformationList",   V_CONS },
+    { 5, "ChargeInformation",       V_CONS },
+    { 6, "ChargedItem",             V_CHARGEDITEM },
+    { 6, "ChargeDetailList",        V_CONS },
+    { 7, "ChargeDetail",            V_CONS },
+    { 8, "ChargeType",              V_CHARGETYPE },
+    { 8, "Charge",                  V_CHARGE },
+    { 1, "ErrorDetailList",         V_CONS },
+    { 2, "ErrorDetail",             V_CONS },
+    { 3, "ItemOffset",              V_ONE },
+    { 3, "ErrorCode",               V_ERRORCODE },
+    { -1, NULL, 0 }
+};
+
+static tagmap_t rap_map;                        /* RAP names chained to the TAP 3.12 ones */
+
+static const genspec specs[] =
+{
+    { "tap309", &tap03le09_tagname_map, 3, 9,  tap309_file, tap_record },
+    { "tap312", &tap03ge10_tagname_map, 3, 12, tap312_file, tap_record },
+    { "nrt",    &nrt0201_tagname_map,   2, 1,  nrt_file,    nrt_record },
+    { "rap",    &rap_map,               3, 12, rap_file,    rap_record },
+    { NULL,     NULL,                   0, 0,  NULL,        NULL }
+};
+
+
+int main(int argc, char **argv)
+{
+    genbuf          b;
+    genstate        st;
+    FILE*           fp = stdout;
+    const char*     type = "tap312";
+    const char*     filename = NULL;
+    long            size = 0;
+    long            one = 0;
+    unsigned        seed = 1;
+    int             opt = 0;
+    int             i = 0;
+
+    memset(&b, 0x00, sizeof(b));
+    memset(&st, 0x00, sizeof(st));
+    st.nrec = 10000;
+
+    rap_map = rap01XX_tagname_map;
+    rap_map.next = &tap03ge10_tagname_map;
+
+
+    /* 1. Checking parameters */
+
+    while ( ( opt = getopt(argc, argv, "t:r:s:d:i:S:o:") ) != -1 )
+    {
+        switch (opt)
+        {
+            case 't': /* 1.1. -t : Type of file */
+                type = optarg;
+                break;
+            case 'r': /* 1.2. -r : Records */
+                if ( ( st.nrec = atol(optarg) ) < 0 )
+                    usage(argv[0]);
+                break;
+            case 's': /* 1.3. -s : Size in MB, instead of the records */
+                if ( ( size = atol(optarg) << 20 ) <= 0 )
+                    usage(argv[0]);
+                break;
+            case 'd': /* 1.4. -d : Levels of nesting added to the records */
+                if ( ( st.nesting = atoi(optarg) ) < 0 || st.nesting > MAXDEPTH )
+                    usage(argv[0]);
+                break;
+            case 'i': /* 1.5. -i : One record of indefinite length every N */
+                if ( ( st.indef = atoi(optarg) ) < 0 )
+                    usage(argv[0]);
+                break;
+            case 'S': /* 1.6. -S : Seed of the values */
+                seed = (unsigned)atol(optarg);
+                break;
+            case 'o': /* 1.7. -o : Output file */
+                filename = optarg;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (optind != argc)
+        usage(argv[0]);
+
+    st.seed = seed;
+
+    for (i = 0; specs[i].type != NULL && strcmp(specs[i].type, type) != 0; i++)
+        ;
+
+    if ( ( st.spec = &specs[i] )->type == NULL )
+        usage(argv[0]);
+
+    if (gen_bind(st.spec->file, st.file_tags, st.spec->map, type) != 0 ||
+            gen_bind(st.spec->record, st.record_tags, st.spec->map, type) != 0)
+        exit(EXIT_FAILURE);
+
+
+    /* 2. Size: records of the size of the first one */
+
+    if (size > 0)
+    {
+        st.nrec = 1;
+        gen_records(&b, &st);
+        one = b.len;
+        st.nrec = (size + one - 1) / one;
+        b.len = 0;
+        st.total = 0;
+        st.seed = seed;
+    }
+
+
+    /* 3. File */
+
+    gen_template(&b, &st, st.spec->file, st.file_tags, FALSE);
+
+    while (b.top > 0)
+        gen_close(&b);
+
+    if (filename != NULL && ( fp = fopen(filename, "wb") ) == NULL)
+    {
+        perror(filename);
+        exit(EXIT_FAILURE);
+    }
+
+    if (fwrite(b.buff, 1, (size_t)b.len, fp) != (size_t)b.len || (fp != stdout && fclose(fp) != 0))
+    {
+        perror("Error writing the file");
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(stderr, "%s: %ld records, %ld bytes\n", type, st.nrec, b.len);
+
+    free(b.buff);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_bind
+|*
+|* Description;
+|*
+|*     Looks up the numbers of the tags of the template t in map
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Unknown tag name
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int gen_bind(const gennode *t, int *tags, const tagmap_t *map, const char *type)
+{
+    int             classes = 0;
+    int             i = 0;
+
+    for (i = 0; t[i].name != NULL; i++)
+    {
+        if (filter_lookup(map, NULL, t[i].name, (int)strlen(t[i].name), &tags[i], &classes, 1) != 1)
+        {
+            fprintf(stderr, "Unknown tag name for %s: %s\n", type, t[i].name);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_template
+|*
+|* Description;
+|*
+|*     Appends the elements of the template t, those of depth 0 with
+|*     indefinite length if indef. The last ones are left open.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_template(genbuf *b, genstate *st, const gennode *t, const int *tags, int indef)
+{
+    int             top = b->top;
+    int             i = 0;
+
+    for (i = 0; t[i].name != NULL; i++)
+    {
+        /* 1. Close the elements which are not parents of this one */
+
+        while (b->top > top + t[i].depth)
+            gen_close(b);
+
+        /* 2. The element */
+
+        switch (t[i].val)
+        {
+            case V_CONS:
+                gen_open(b, tags[i], (indef && t[i].depth == 0));
+                break;
+            case V_RECORDS:
+                gen_open(b, tags[i], FALSE);
+                gen_records(b, st);
+                gen_close(b);
+                break;
+            default:
+                gen_tag(b, 0, tags[i]);
+                gen_value(b, st, t[i].val);
+                break;
+        }
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_records
+|*
+|* Description;
+|*
+|*     Appends st->nrec records, each one with its values, the levels of
+|*     nesting asked for and, one every st->indef, with indefinite length
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_records(genbuf *b, genstate *st)
+{
+    int             top = 0;
+    int             i = 0;
+
+    for (st->recno = 0; st->recno < st->nrec; st->recno++)
+    {
+        st->duration = 1 + gen_rand(st, 3600);
+        st->charge = st->duration * (10 + gen_rand(st, 90));
+        st->total += st->charge;
+
+        top = b->top;
+        gen_template(b, st, st->spec->record, st->record_tags, (st->indef > 0 && st->recno % st->indef == st->indef - 1));
+
+        while (b->top > top + 1)
+            gen_close(b);
+
+        for (i = 0; i < st->nesting; i++)
+            gen_open(b, 0, FALSE);
+
+        while (b->top > top)
+            gen_close(b);
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_value
+|*
+|* Description;
+|*
+|*     Appends the length and the value val of a primitive
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Numbers and IMEI in BCD, dialled digits in ASCII
+|*
+****************************************************************************/
+static void gen_value(genbuf *b, genstate *st, int val)
+{
+    char            str[32];
+    long            last = GEN_BASE_TIME + (st->nrec > 0 ? st->nrec - 1 : 0) * 60;
+
+    switch (val)
+    {
+        case V_SENDER:      gen_text(b, "ABCDE"); break;
+        case V_RECIPIENT:   gen_text(b, "FGHIJ"); break;
+        case V_FILESEQ:     gen_text(b, "00001"); break;
+        case V_NRTSEQ:      gen_text(b, "0000001"); break;
+        case V_FILETIME:    gen_time(b, last + 3600); break;
+        case V_FIRSTTIME:   gen_time(b, GEN_BASE_TIME); break;
+        case V_LASTTIME:    gen_time(b, last); break;
+        case V_CALLTIME:    gen_time(b, GEN_BASE_TIME + st->recno * 60); break;
+        case V_UTC:         gen_text(b, "+0100"); break;
+        case V_ZERO:        gen_int(b, 0); break;
+        case V_ONE:         gen_int(b, 1); break;
+        case V_VER:         gen_int(b, st->spec->ver); break;
+        case V_REL:         gen_int(b, st->spec->rel); break;
+        case V_RAPVER:      gen_int(b, 1); break;
+        case V_RAPREL:      gen_int(b, 5); break;
+        case V_CURRENCY:    gen_text(b, "EUR"); break;
+        case V_TAPCURRENCY: gen_text(b, "SDR"); break;
+        case V_DECIMALS:    gen_int(b, 3); break;
+        case V_RATE:        gen_int(b, 116342); break;
+        case V_RATEDECIMALS: gen_int(b, 5); break;
+        case V_RECID:       gen_text(b, "34600000001"); break;
+        case V_IMSI:
+            snprintf(str, sizeof(str), "21401%010ld", st->recno % 10000000000L);
+            gen_tbcd(b, str);
+            break;
+        case V_MSISDN:
+            snprintf(str, sizeof(str), "34600%06ld", st->recno % 1000000L);
+            gen_tbcd(b, str);
+            break;
+        case V_CALLED:
+            snprintf(str, sizeof(str), "3491%07u", gen_rand(st, 10000000));
+            gen_bcd(b, str);
+            break;
+        case V_DIALLED:
+            snprintf(str, sizeof(str), "3491%07u", gen_rand(st, 10000000));
+            gen_text(b, str);
+            break;
+        case V_IMEI:
+            snprintf(str, sizeof(str), "35%012ld", st->recno % 1000000000000L);
+            gen_bcd(b, str);
+            break;
+        case V_LAC:         gen_int(b, 1000 + gen_rand(st, 64)); break;
+        case V_CELL:        gen_int(b, gen_rand(st, 65536)); break;
+        case V_DURATION:    gen_int(b, st->duration); break;
+        case V_TELESERVICE: gen_text(b, "11"); break;
+        case V_CHARGEDITEM: gen_text(b, "D"); break;
+        case V_CHARGETYPE:  gen_text(b, "00"); break;
+        case V_CHARGE:      gen_int(b, st->charge); break;
+        case V_TOTAL:       gen_int(b, st->total); break;
+        case V_COUNT:       gen_int(b, st->nrec); break;
+        case V_ERRORCODE:   gen_int(b, 30); break;
+        default:            gen_text(b, ""); break;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_open
+|*
+|* Description;
+|*
+|*     Starts a constructed element. The length is written by gen_close(),
+|*     when known: one byte is kept for it here.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_open(genbuf *b, int tag, int indef)
+{
+    if (b->top == GEN_MAX_DEPTH)
+    {
+        fprintf(stderr, "Too many levels of nesting (maximum %d)\n", GEN_MAX_DEPTH);
+        exit(EXIT_FAILURE);
+    }
+
+    gen_tag(b, 1, tag);
+    gen_put(b, (indef ? "\x80" : "\x00"), 1);
+
+    b->open[b->top++] = b->len - 1;
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_close
+|*
+|* Description;
+|*
+|*     Ends the last constructed element started: adds the End of
+|*     indefinite length or writes its length, moving the content if the
+|*     length takes more than one byte
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_close(genbuf *b)
+{
+    long            pos = b->open[--b->top];
+    long            len = b->len - pos - 1;
+    int             n = 0;
+    int             i = 0;
+
+    /* 1. Indefinite length */
+
+    if (b->buff[pos] == 0x80)
+    {
+        gen_put(b, "\x00\x00", 2);
+        return;
+    }
+
+    /* 2. Short form */
+
+    if (len < 0x80)
+    {
+        b->buff[pos] = (uchar)len;
+        return;
+    }
+
+    /* 3. Long form: 0x80 + number of bytes, then the bytes */
+
+    for (n = 1; n < (int)sizeof(len) && (len >> (8 * n)) != 0; n++)
+        ;
+
+    gen_put(b, "\x00\x00\x00\x00\x00\x00\x00\x00", n);
+    memmove(b->buff + pos + 1 + n, b->buff + pos + 1, (size_t)len);
+
+    b->buff[pos] = (uchar)(0x80 | n);
+    for (i = 0; i < n; i++)
+        b->buff[pos + 1 + i] = (uchar)(len >> (8 * (n - 1 - i)));
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_tag
+|*
+|* Description;
+|*
+|*     Appends an application tag: one byte up to 30, else 0x1f and the
+|*     number in base 128
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_tag(genbuf *b, int cons, int tag)
+{
+    uchar           tag_x[8];
+    int             n = sizeof(tag_x);
+    uchar           first = (uchar)(GEN_APPL | (cons ? 0x20 : 0x00));
+
+    if (tag < 0x1f)
+    {
+        first |= (uchar)tag;
+        gen_put(b, &first, 1);
+        return;
+    }
+
+    tag_x[--n] = (uchar)(tag & 0x7f);
+    for (tag >>= 7; tag != 0; tag >>= 7)
+        tag_x[--n] = (uchar)(0x80 | (tag & 0x7f));
+    tag_x[--n] = (uchar)(first | 0x1f);
+
+    gen_put(b, tag_x + n, (long)sizeof(tag_x) - n);
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_int
+|*
+|* Description;
+|*
+|*     Appends the length and the value of an integer, in the fewest bytes
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_int(genbuf *b, long long value)
+{
+    uchar           val[9];
+    int             n = 1;
+    int             i = 0;
+
+    while (n < 8 && (value >> (8 * n - 1)) != 0 && (value >> (8 * n - 1)) != -1)
+        n++;
+
+    val[0] = (uchar)n;
+    for (i = 0; i < n; i++)
+        val[1 + i] = (uchar)(value >> (8 * (n - 1 - i)));
+
+    gen_put(b, val, n + 1);
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_text
+|*
+|* Description;
+|*
+|*     Appends the length and the characters of str
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_text(genbuf *b, const char *str)
+{
+    uchar           len = (uchar)strlen(str);
+
+    gen_put(b, &len, 1);
+    gen_put(b, str, len);
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_tbcd
+|*
+|* Description;
+|*
+|*     Appends the length and the digits in TBCD: two per byte, the first
+|*     one in the low nibble, and 0xf after an odd number of digits
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_tbcd(genbuf *b, const char *digits)
+{
+    uchar           val[17];
+    int             len = (int)strlen(digits);
+    int             i = 0;
+
+    val[0] = (uchar)((len + 1) / 2);
+
+    for (i = 0; i < len; i += 2)
+        val[1 + i / 2] = (uchar)((digits[i] - '0') | (i + 1 < len ? (digits[i + 1] - '0') << 4 : 0xf0));
+
+    gen_put(b, val, val[0] + 1);
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_bcd
+|*
+|* Description;
+|*
+|*     Same as gen_tbcd() with the first digit in the high nibble
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_bcd(genbuf *b, const char *digits)
+{
+    uchar           val[17];
+    int             len = (int)strlen(digits);
+    int             i = 0;
+
+    val[0] = (uchar)((len + 1) / 2);
+
+    for (i = 0; i < len; i += 2)
+        val[1 + i / 2] = (uchar)((digits[i] - '0') << 4 | (i + 1 < len ? digits[i + 1] - '0' : 0x0f));
+
+    gen_put(b, val, val[0] + 1);
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_time
+|*
+|* Description;
+|*
+|*     Appends the length and a time stamp YYYYMMDDHHMMSS of t seconds
+|*     since 1970 (UTC)
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_time(genbuf *b, long t)
+{
+    char            str[32];
+    time_t          tt = (time_t)t;
+    struct tm       tm;
+
+    gmtime_r(&tt, &tm);
+    strftime(str, sizeof(str), "%Y%m%d%H%M%S", &tm);
+
+    gen_text(b, str);
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_put
+|*
+|* Description;
+|*
+|*     Appends len bytes to the file, growing it if needed
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void gen_put(genbuf *b, const void *data, long len)
+{
+    uchar*          buff = NULL;
+    long            size = b->size;
+
+    if (b->len + len > size)
+    {
+        while (b->len + len > size)
+            size = (size == 0 ? 1L << 20 : size * 2);
+
+        if ( ( buff = (uchar *)realloc(b->buff, (size_t)size) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate %ld bytes for the file\n", size);
+            exit(EXIT_FAILURE);
+        }
+
+        b->buff = buff;
+        b->size = size;
+    }
+
+    memcpy(b->buff + b->len, data, (size_t)len);
+    b->len += len;
+}
+
+
+/****************************************************************************
+|*
+|* Function: gen_rand
+|*
+|* Description;
+|*
+|*     Random number from 0 to max - 1 (xorshift), the same ones for the
+|*     same seed
+|*
+|* Return:
+|*      The number
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static unsigned gen_rand(genstate *st, unsigned max)
+{
+    unsigned        x = (st->seed != 0 ? st->seed : 1);
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    st->seed = x;
+
+    return x % max;
+}
+
+
+/****************************************************************************
+|*
+|* Function: usage
+|*
+|* Description;
+|*
+|*     Show usage
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void usage(const char *program_name)
+{
+    int             i = 0;
+
+    fprintf(stderr, "Usage: %s [-t type] [-r records | -s MB] [-d levels] [-i N] [-S seed] [-o file]\n", program_name);
+    fprintf(stderr, "  -t : Type of file:");
+    for (i = 0; specs[i].type != NULL; i++)
+        fprintf(stderr, " %s", specs[i].type);
+    fprintf(stderr, ". Default: tap312\n");
+    fprintf(stderr, "  -r : Number of records. Default: 10000\n");
+    fprintf(stderr, "  -s : Size of the file in MB, instead of -r\n");
+    fprintf(stderr, "  -d : Levels of nesting added to each record (not in the specifications)\n");
+    fprintf(stderr, "  -i : One record every N with indefinite length. Default: none\n");
+    fprintf(stderr, "  -S : Seed of the values. Default: 1\n");
+    fprintf(stderr, "  -o : Output file. Default: the standard output\n");
+    exit(EXIT_FAILURE);
+}
+
+/* EOF */
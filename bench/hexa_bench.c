@@ -0,0 +1,173 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: hexa_bench.c
+|*
+|* Description: Microbenchmark of the hexadecimal kernels against the
+|*              former sprintf("%02x") per byte. Sizes are the ones found
+|*              in TAP files: tags and sizes (1-3 bytes), Msisdn (6),
+|*              Imsi (8), and longer values.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+#include "../readasn.h"
+
+
+/* 2. Defines */
+
+#define BENCH_BYTES (64L << 20)         /* Bytes converted per measure */
+
+
+/* 3. Prototypes */
+
+static void     hexa_sprintf    (char *dst, const uchar *src, long len);
+static double   bench           (void (*encode)(char *, const uchar *, long), const uchar *src, char *dst, long len);
+
+
+int main(void)
+{
+    static const long   sizes[] = { 1, 3, 6, 8, 16, 64, 1024 };
+    uchar               src[1024];
+    char                dst[2 * 1024 + 1];
+    double              base = 0, ns = 0;
+    unsigned            i = 0, k = 0;
+
+    struct
+    {
+        const char*     name;
+        void          (*encode)(char *, const uchar *, long);
+    } kernels[] =
+    {
+        { "sprintf",    hexa_sprintf },
+        { "scalar",     hexa_encode_scalar },
+#ifdef HEXA_X86
+        { "sse2",       hexa_encode_sse2 },
+        { "avx2",       __builtin_cpu_supports("avx2") ? hexa_encode_avx2 : NULL },
+#endif
+        { "selected",   hexa_encode },
+    };
+
+    srand(1);
+    for (i = 0; i < sizeof(src); i++)
+        src[i] = (uchar)rand();
+
+    printf("%-10s", "bytes");
+    for (k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+        printf("%18s", kernels[k].name);
+    printf("\n");
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        printf("%-10ld", sizes[i]);
+
+        for (k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+        {
+            if (kernels[k].encode == NULL)
+            {
+                printf("%18s", "n/a");
+                continue;
+            }
+
+            ns = bench(kernels[k].encode, src, dst, sizes[i]);
+            if (k == 0)
+                base = ns;
+
+            printf("%9.2fns %5.1fx", ns, base / ns);
+        }
+        printf("\n");
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: bench
+|*
+|* Description;
+|*
+|*     Converts BENCH_BYTES in strings of len bytes
+|*
+|* Return:
+|*      Nanoseconds per call
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static double bench(void (*encode)(char *, const uchar *, long), const uchar *src, char *dst, long len)
+{
+    struct timespec     start, end;
+    long                i = 0, calls = BENCH_BYTES / len;
+
+    if (calls > 20000000)
+        calls = 20000000;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; i < calls; i++)
+    {
+        encode(dst, src, len);
+        __asm__ volatile("" : : "r"(dst) : "memory");
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec)) / (double)calls;
+}
+
+
+/****************************************************************************
+|*
+|* Function: hexa_sprintf
+|*
+|* Description;
+|*
+|*     Former conversion of bcd_2_hexa()
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void hexa_sprintf(char *dst, const uchar *src, long len)
+{
+    long        i = 0;
+
+    for (i = 0; i < len; i++)
+        sprintf(&dst[i*2], "%02x", (unsigned) src[i]);
+}
+
+/* EOF */
@@ -0,0 +1,152 @@
+#!/bin/sh
+#############################################################################
+#
+# tap3edit Tools (http://www.tap3edit.com)
+#
+# Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+#
+# Script: readasn_bench.sh
+#
+# Description: Throughput of readasn on files made by gen_asn: MB/s and
+#              records/s for each type of file, output mode and input
+#              (mapped file, pipe, threads). The best of BENCH_RUNS runs
+#              is reported. The output goes to /dev/null.
+#
+#              Environment:
+#              BENCH_MB      Size of the files in MB. Default: 32
+#              BENCH_RUNS    Runs of each measure. Default: 3
+#              BENCH_THREADS Threads of the input "threads". Default: 4
+#              BENCH_TYPES   Types of file. Default: tap309 tap312 nrt rap
+#              BENCH_MODES   Output modes. Default: all of them
+#              BENCH_INPUTS  Inputs. Default: file pipe threads
+#
+# Modifications:
+#
+# When         Who     Pos     What
+# 20261016                     Initial Version
+#
+#############################################################################
+
+BENCH_DIR=$(dirname "$0")
+READASN=${READASN:-$BENCH_DIR/../readasn}
+GEN_ASN=${GEN_ASN:-$BENCH_DIR/gen_asn}
+
+BENCH_MB=${BENCH_MB:-32}
+BENCH_RUNS=${BENCH_RUNS:-3}
+BENCH_THREADS=${BENCH_THREADS:-4}
+BENCH_TYPES=${BENCH_TYPES:-"tap309 tap312 nrt rap"}
+BENCH_MODES=${BENCH_MODES:-"text text-n filter json csv tsv arrow stats validate"}
+BENCH_INPUTS=${BENCH_INPUTS:-"file pipe threads"}
+
+COLUMNS_ARG="recno,pos,record,Imsi:hex"
+
+set -f                                  # "**/Imsi" of -f is not a file name
+
+TMP_DIR=$(mktemp -d "${TMPDIR:-/tmp}/readasn_bench.XXXXXX") || exit 1
+trap 'rm -rf "$TMP_DIR"' EXIT INT TERM
+
+
+# 1. Options of readasn for each mode
+
+mode_args()
+{
+    case $1 in
+        text)       echo "" ;;
+        text-n)     echo "-n" ;;
+        filter)     echo "-f **/Imsi" ;;
+        json)       echo "-F json" ;;
+        csv)        echo "-F csv -c $COLUMNS_ARG" ;;
+        tsv)        echo "-F tsv -c $COLUMNS_ARG" ;;
+        arrow)      echo "-F arrow -c $COLUMNS_ARG" ;;
+        stats)      echo "--stats" ;;
+        validate)   echo "--validate" ;;
+        *)          echo "Unknown mode: $1" >&2; exit 1 ;;
+    esac
+}
+
+
+# 2. One run: elapsed nanoseconds, or nothing on error
+
+run_once()
+{
+    input=$1; file=$2; shift 2
+
+    start=$(date +%s%N)
+    case $input in
+        file)       "$READASN" "$@" "$file" > /dev/null ;;
+        pipe)       cat "$file" | "$READASN" "$@" - > /dev/null ;;
+        threads)    "$READASN" -j "$BENCH_THREADS" "$@" "$file" > /dev/null ;;
+        *)          echo "Unknown input: $input" >&2; return 1 ;;
+    esac
+    rc=$?
+    end=$(date +%s%N)
+
+    [ $rc -eq 0 ] && echo $((end - start))
+}
+
+
+# 3. Files and measures
+
+printf "%-8s %-9s %-8s %10s %12s %9s\n" "type" "mode" "input" "MB/s" "records/s" "seconds"
+
+for type in $BENCH_TYPES
+do
+    file=$TMP_DIR/$type.dat
+
+    # 3.1. File of BENCH_MB, with the number of records told by gen_asn
+
+    info=$("$GEN_ASN" -t "$type" -s "$BENCH_MB" -o "$file" 2>&1) || { echo "$info" >&2; exit 1; }
+    records=$(echo "$info" | sed -n 's/.*: \([0-9]*\) records, \([0-9]*\) bytes/\1/p')
+    bytes=$(echo "$info" | sed -n 's/.*: \([0-9]*\) records, \([0-9]*\) bytes/\2/p')
+
+    for mode in $BENCH_MODES
+    do
+        args=$(mode_args "$mode") || exit 1
+
+        for input in $BENCH_INPUTS
+        do
+            # 3.2. Best of BENCH_RUNS
+
+            best=""
+            run=0
+            while [ $run -lt "$BENCH_RUNS" ]
+            do
+                ns=$(run_once "$input" "$file" $args)
+                if [ -z "$ns" ]
+                then
+                    best=""
+                    break
+                fi
+                if [ -z "$best" ] || [ "$ns" -lt "$best" ]
+                then
+                    best=$ns
+                fi
+                run=$((run + 1))
+            done
+
+            if [ -z "$best" ]
+            then
+                printf "%-8s %-9s %-8s %10s %12s %9s\n" "$type" "$mode" "$input" "error" "-" "-"
+                continue
+            fi
+
+            awk -v t="$type" -v m="$mode" -v i="$input" -v ns="$best" -v b="$bytes" -v r="$records" 'BEGIN {
+                s = ns / 1e9
+                printf "%-8s %-9s %-8s %10.1f %12.0f %9.3f\n", t, m, i, b / 1048576 / s, r / s, s
+            }'
+        done
+    done
+done
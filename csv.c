@@ -0,0 +1,780 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: csv.c
+|*
+|* Description: Flat export of the root records: one row per record
+|*              (call event of TAP, NRT record, ...) with the columns
+|*              asked for, as in "recno,record,Imsi:hex,ChargeAmount".
+|*              A column is the first primitive of the record with the
+|*              tag, or recno, pos, record (its tag name) or file. The
+|*              rows are written as each record ends.
+|*
+|*              CSV fields are quoted when needed (RFC 4180). TSV fields
+|*              have their tabs, End of Lines and backslashes escaped.
+|*
+|*              A column without conversion has one for all its rows,
+|*              chosen by csv_bind() from the name of its tag: number for
+|*              the INTEGER elements of TAP, NRT and RAP, hexadecimal for
+|*              the BCD and octet strings, text for the others. A column
+|*              of the same type in every row loads as such (and is int64
+|*              in the Arrow output).
+|*
+|*              With --typed, columns without conversion of tags with a
+|*              typed value (typed.c) have the typed value, except the
+|*              int64 columns of the Arrow output. The full time stamp
+|*              with its offset is in the column of UtcTimeOffset (or
+|*              UtcTimeOffsetCode), not in the one of LocalTimeStamp.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Rows of the Arrow output (arrow.c)
+|* 20261016                     Typed values (--typed)
+|* 20261016                     Conversion chosen once per column, by tag
+|* 20261016                     Columns named in the schema, matched by class and tag
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static int      csv_start_cons  (void *user, const asn1event *ev);
+static int      csv_primitive   (void *user, const asn1event *ev);
+static int      csv_end_cons    (void *user, const asn1event *ev);
+static int      csv_start_row   (asn1printer *pr, const asn1event *ev);
+static int      csv_conv        (const char *name);
+static void     csv_value       (asn1output *out, const uchar *value, long len, const csvcol *col);
+static void     csv_field       (asn1printer *pr, const char *str, long len);
+static void     csv_write       (asn1printer *pr);
+
+
+/* 3. Global Variables */
+
+const asn1handler csv_handler =                 /* Callbacks writing CSV and TSV rows */
+{
+    csv_start_cons,
+    csv_primitive,
+    csv_end_cons,
+    print_error,
+    NULL
+};
+
+static const struct                             /* Columns which are not tags */
+{
+    const char* name;
+    int         kind;
+} csv_specials[] =
+{
+    { "recno",  COL_RECNO },
+    { "pos",    COL_POS },
+    { "record", COL_RECORD },
+    { "file",   COL_FILE },
+    { NULL,     0 }
+};
+
+static const char* csv_numbers[] =              /* INTEGER elements of TAP, NRT and RAP */
+{
+    "AbsoluteAmount", "AdvisedCharge", "AgeOfLocation", "CallEventDetailsCount",
+    "CallEventDuration", "CallEventsCount", "CallTypeLevel1", "CallTypeLevel2",
+    "CallTypeLevel3", "CamelInvocationFee", "CamelServiceKey", "CamelServiceLevel",
+    "CauseForTerm", "CauseForTermination", "CellId", "Charge", "ChargeAmount",
+    "ChargeableUnits", "ChargedUnits", "ChargeRefundIndicator", "ChargingId",
+    "ClirIndicator", "ContentProviderIdType", "ContentTransactionCode",
+    "ContentTransactionType", "DataVolume", "DataVolumeIncoming", "DataVolumeOutgoing",
+    "DefaultCallHandlingIndicator", "Discount", "DiscountCode", "DiscountRate",
+    "DiscountValue", "DiscountableAmount", "ErrorCode", "ExchangeRate",
+    "ExchangeRateCode", "FixedDiscountValue", "ItemLevel", "ItemOccurrence",
+    "ItemOffset", "LocationArea", "MessageDescriptionCode", "MessageStatus",
+    "MessageType", "NumberOfDecimalPlaces", "ObjectType", "PaymentMethod",
+    "RapReleaseVersionNumber", "RapSpecificationVersionNumber", "RecEntityCode",
+    "RecEntityType", "ReleaseVersionNumber", "ReturnDetailsCount",
+    "SpecificationVersionNumber", "TapDecimalPlaces", "TaxCode", "TaxValue",
+    "TaxableAmount", "TotalAdvisedCharge", "TotalAdvisedChargeRefund",
+    "TotalCallEventDuration", "TotalCharge", "TotalChargeRefund", "TotalCommission",
+    "TotalCommissionRefund", "TotalDataVolume", "TotalDiscountRefund",
+    "TotalDiscountValue", "TotalSevereReturnTax", "TotalSevereReturnValue",
+    "TotalTaxRefund", "TotalTaxValue", "TotalTransactionDuration",
+    "TransparencyIndicator", "UtcTimeOffsetCode",
+    NULL
+};
+
+static const char* csv_binaries[] =             /* BCD and octet strings of TAP, NRT and RAP */
+{
+    "Imsi", "Msisdn", "Imei", "Min", "Mdn", "CallingNumber", "CalledNumber",
+    "ConnectedNumber", "ThirdPartyNumber", "CamelDestinationNumber", "CallReference",
+    NULL
+};
+
+
+/****************************************************************************
+|*
+|* Function: csv_compile
+|*
+|* Description;
+|*
+|*     Reads the columns of spec: names separated by commas, each one
+|*     with an optional :text, :int or :hex. The tags are looked up later
+|*     by csv_bind(), with the tag map of each file.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Wrong list of columns
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int csv_compile(csvcols *cols, const char *spec, char sep)
+{
+    csvcol*         col = NULL;
+    const char*     p = spec;
+    const char*     end = NULL;
+    const char*     conv = NULL;
+    int             len = 0;
+    int             i = 0;
+
+    memset(cols, 0x00, sizeof(*cols));
+    cols->sep = sep;
+
+    for (;;)
+    {
+        /* 1. Next column: up to "," or the end */
+
+        while (isspace((unsigned char)*p))
+            p++;
+
+        for (end = p; *end != '\0' && *end != ','; end++)
+            ;
+
+        for (len = (int)(end - p); len > 0 && isspace((unsigned char)p[len - 1]); len--)
+            ;
+
+        if (len == 0 || cols->ncols == CSV_MAX_COLS)
+        {
+            fprintf(stderr, "Wrong list of columns (empty or more than %d) at: \"%s\"\n", CSV_MAX_COLS, p);
+            return -1;
+        }
+
+        col = &cols->cols[cols->ncols++];
+        col->kind = COL_TAG;
+        col->conv = CONV_AUTO;
+        col->is_auto = TRUE;
+
+
+        /* 2. Conversion */
+
+        if ( ( conv = memchr(p, ':', (size_t)len) ) != NULL )
+        {
+            i = (int)(p + len - conv);
+
+            if (i == 5 && strncmp(conv, ":text", 5) == 0)
+                col->conv = CONV_TEXT;
+            else if (i == 4 && strncmp(conv, ":int", 4) == 0)
+                col->conv = CONV_INT;
+            else if (i == 4 && strncmp(conv, ":hex", 4) == 0)
+                col->conv = CONV_HEX;
+            else
+            {
+                fprintf(stderr, "Unknown conversion of column: %.*s\n", len, p);
+                return -1;
+            }
+
+            len = (int)(conv - p);
+            col->is_auto = FALSE;
+        }
+
+        if (len == 0 || len >= CSV_NAME_LEN)
+        {
+            fprintf(stderr, "Wrong name of column: %.*s\n", len, p);
+            return -1;
+        }
+
+        memcpy(col->name, p, (size_t)len);
+        col->name[len] = '\0';
+
+
+        /* 3. Columns which are not tags */
+
+        for (i = 0; csv_specials[i].name != NULL; i++)
+        {
+            if (strcmp(col->name, csv_specials[i].name) == 0)
+                col->kind = csv_specials[i].kind;
+        }
+
+        if (*end == '\0')
+            break;
+
+        p = end + 1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_bind
+|*
+|* Description;
+|*
+|*     Looks up the tags of the columns in the tag map and the schema
+|*     (NULL: none) of the file, and chooses the conversion of the
+|*     columns without one
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Unknown tag name
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Conversion of the columns without one
+|* 20261016    Names of the schema, and class of the tags
+|*
+****************************************************************************/
+int csv_bind(csvcols *cols, const tagmap_t *map, const asn1schema *schema)
+{
+    csvcol*         col = NULL;
+    const char*     p = NULL;
+    int             i = 0;
+
+    for (i = 0; i < cols->ncols; i++)
+    {
+        col = &cols->cols[i];
+
+        if (col->kind != COL_TAG)
+            continue;
+
+        /* 1. Tag number */
+
+        for (p = col->name; isdigit((unsigned char)*p); p++)
+            ;
+
+        if (*p == '\0')
+        {
+            col->tags[0] = atoi(col->name);
+            col->classes[0] = CLASSES_ANY;
+            col->ntags = 1;
+
+            if (col->is_auto)
+                col->conv = csv_conv(tagmap_name(map, col->tags[0]));
+            continue;
+        }
+
+        /* 2. Tag name */
+
+        if ( ( col->ntags = filter_lookup(map, schema, col->name, (int)strlen(col->name), col->tags, col->classes, FILTER_STEP_TAGS) ) == 0 )
+        {
+            fprintf(stderr, "Unknown tag name in the columns: %s%s\n", col->name,
+                    (map == NULL && schema == NULL ? " (no tag names for this file, use numbers)" : ""));
+            return -1;
+        }
+
+        if (col->is_auto)
+            col->conv = csv_conv(col->name);
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_header
+|*
+|* Description;
+|*
+|*     Writes the row with the names of the columns
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void csv_header(asn1printer *pr)
+{
+    int             i = 0;
+
+    for (i = 0; i < pr->cols->ncols; i++)
+    {
+        if (i > 0)
+            output_putc(pr->out, pr->cols->sep);
+
+        csv_field(pr, pr->cols->cols[i].name, (long)strlen(pr->cols->cols[i].name));
+    }
+
+    print_eol(pr);
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_start_cons
+|*
+|* Description;
+|*
+|*     Starts a row at the beginning of a record
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int csv_start_cons(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+
+    if (ev->is_record && (pr->row == NULL || pr->row->depth == -1))
+        return (csv_start_row(pr, ev) == 0 ? ASN1_CONTINUE : ASN1_STOP);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_primitive
+|*
+|* Description;
+|*
+|*     Keeps the value of the first primitive of the record for each
+|*     column with its tag. A primitive record is a row by itself. The
+|*     typed values are found for all the primitives: some of them (time
+|*     stamps, decimals) are needed by the ones after.
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Typed values
+|* 20261016    Conversion chosen by csv_bind()
+|* 20261016    No typed value in the int64 columns of the Arrow output
+|* 20261016    Class of the tags
+|*
+****************************************************************************/
+static int csv_primitive(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+    csvrow*         row = pr->row;
+    const csvcol*   col = NULL;
+    char            typed[TYPED_MAX_LEN];
+    long            n = 0;
+    int             is_alone = FALSE;
+    int             i = 0;
+    int             t = 0;
+
+    if (ev->is_eoe)
+        return ASN1_CONTINUE;
+
+    if (pr->typed != NULL)
+        n = typed_value(pr->typed, ev, typed);
+
+    if (row == NULL || row->depth == -1)
+    {
+        if (!ev->is_record)
+            return ASN1_CONTINUE;
+
+        if (csv_start_row(pr, ev) != 0)
+            return ASN1_STOP;
+
+        row = pr->row;
+        is_alone = TRUE;
+    }
+
+    for (i = 0; i < pr->cols->ncols; i++)
+    {
+        col = &pr->cols->cols[i];
+
+        if (col->kind != COL_TAG || row->val[i] != -1)
+            continue;
+
+        for (t = 0; t < col->ntags; t++)
+        {
+            if (col->tags[t] == ev->item->tag && (col->classes[t] >> ev->item->class & 1))
+            {
+                row->val[i] = row->vals.len;
+                if (n > 0 && col->is_auto && !(pr->arrow != NULL && col->conv == CONV_INT))
+                    output_write(&row->vals, typed, n);
+                else
+                    csv_value(&row->vals, ev->value, ev->item->size, col);
+                row->vlen[i] = row->vals.len - row->val[i];
+                break;
+            }
+        }
+    }
+
+    if (is_alone)
+        csv_write(pr);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_end_cons
+|*
+|* Description;
+|*
+|*     Writes the row at the end of its record
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int csv_end_cons(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+
+    if (pr->row != NULL && pr->row->depth == ev->depth && ev->is_record)
+        csv_write(pr);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_start_row
+|*
+|* Description;
+|*
+|*     Starts an empty row for the record of ev
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int csv_start_row(asn1printer *pr, const asn1event *ev)
+{
+    csvrow*         row = pr->row;
+    int             i = 0;
+
+    if (row == NULL)
+    {
+        if ( ( row = (csvrow *)calloc(1, sizeof(csvrow)) ) == NULL ||
+                output_init(&row->vals, -1, OUTPUT_MIN_SIZE * 16) != 0 )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the rows\n");
+            free(row);
+            return -1;
+        }
+        pr->row = row;
+    }
+
+    row->depth = ev->depth;
+    row->pos = ev->pos;
+    row->recno = ev->recno;
+    row->tag = ev->item->tag;
+    row->name = ev->name;
+    row->vals.len = 0;
+
+    for (i = 0; i < pr->cols->ncols; i++)
+        row->val[i] = -1;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_write
+|*
+|* Description;
+|*
+|*     Writes the row of the record just finished, or adds it to the
+|*     columns of the Arrow output
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    File column also with a single file
+|*
+****************************************************************************/
+static void csv_write(asn1printer *pr)
+{
+    csvrow*         row = pr->row;
+    asn1output*     out = pr->out;
+    const csvcol*   col = NULL;
+    int             i = 0;
+
+    /* 1. Arrow output: the row goes to its columns */
+
+    if (pr->arrow != NULL)
+    {
+        arrow_row(pr);
+        row->depth = -1;
+        return;
+    }
+
+
+    /* 2. Text */
+
+    for (i = 0; i < pr->cols->ncols; i++)
+    {
+        col = &pr->cols->cols[i];
+
+        if (i > 0)
+            output_putc(out, pr->cols->sep);
+
+        switch (col->kind)
+        {
+            case COL_RECNO:
+                output_dec(out, row->recno);
+                break;
+            case COL_POS:
+                output_dec(out, row->pos);
+                break;
+            case COL_RECORD:
+                if (pr->use_tagnames && row->name != NULL)
+                    csv_field(pr, row->name, (long)strlen(row->name));
+                else
+                    output_dec(out, row->tag);
+                break;
+            case COL_FILE:
+                if (pr->file != NULL)
+                    csv_field(pr, pr->file, (long)strlen(pr->file));
+                break;
+            default:
+                if (row->val[i] != -1)
+                    csv_field(pr, row->vals.buff + row->val[i], row->vlen[i]);
+                break;
+        }
+    }
+
+    print_eol(pr);
+
+    row->depth = -1;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_conv
+|*
+|* Description;
+|*
+|*     Conversion of a column without one, by the name of its tag (NULL:
+|*     unknown): CONV_INT for the INTEGER elements, CONV_HEX for the BCD
+|*     and octet strings and for tags without name, else CONV_TEXT
+|*
+|* Return:
+|*      CONV_INT, CONV_HEX or CONV_TEXT
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int csv_conv(const char *name)
+{
+    int             i = 0;
+
+    if (name == NULL)
+        return CONV_HEX;
+
+    for (i = 0; csv_numbers[i] != NULL; i++)
+    {
+        if (strcmp(name, csv_numbers[i]) == 0)
+            return CONV_INT;
+    }
+
+    for (i = 0; csv_binaries[i] != NULL; i++)
+    {
+        if (strcmp(name, csv_binaries[i]) == 0)
+            return CONV_HEX;
+    }
+
+    return CONV_TEXT;
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_value
+|*
+|* Description;
+|*
+|*     Writes a value with the conversion of its column. Numbers are
+|*     signed (two's complement), from the first 8 bytes at most. Values
+|*     which are not printable in a text column chosen by csv_bind() are
+|*     written in hexadecimal: still a string.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Conversion chosen by csv_bind(). Signed numbers
+|*
+****************************************************************************/
+static void csv_value(asn1output *out, const uchar *value, long len, const csvcol *col)
+{
+    long long       sum_up = 0;
+    long            i = 0;
+    int             conv = col->conv;
+
+    if (conv == CONV_TEXT && col->is_auto && !hexa_printable(hexa_encode_check(NULL, value, len), len))
+        conv = CONV_HEX;
+
+    switch (conv)
+    {
+        case CONV_TEXT:
+            output_write(out, (const char *)value, len);
+            break;
+        case CONV_INT:
+            if (len > 0)
+                sum_up = (signed char)value[0];
+            for (i = 1; i < len && i < (long)sizeof(sum_up); i++)
+                sum_up = (long long)((unsigned long long)sum_up << 8 | value[i]);
+            output_dec(out, sum_up);
+            break;
+        default:
+            output_hexa(out, value, len);
+            break;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_field
+|*
+|* Description;
+|*
+|*     Writes a field: between quotes (doubled inside) in CSV if it has
+|*     separators, quotes or End of Lines; with \t, \n, \r and \\ escaped
+|*     in TSV
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void csv_field(asn1printer *pr, const char *str, long len)
+{
+    asn1output*     out = pr->out;
+    long            i = 0;
+    long            from = 0;
+
+    /* 1. TSV */
+
+    if (pr->cols->sep == '\t')
+    {
+        for (i = 0; i < len; i++)
+        {
+            if (str[i] != '\t' && str[i] != '\n' && str[i] != '\r' && str[i] != '\\')
+                continue;
+
+            output_write(out, str + from, i - from);
+            from = i + 1;
+
+            output_putc(out, '\\');
+            output_putc(out, (str[i] == '\t' ? 't' : (str[i] == '\n' ? 'n' : (str[i] == '\r' ? 'r' : '\\'))));
+        }
+
+        output_write(out, str + from, len - from);
+        return;
+    }
+
+
+    /* 2. CSV */
+
+    for (i = 0; i < len; i++)
+    {
+        if (str[i] == pr->cols->sep || str[i] == '"' || str[i] == '\n' || str[i] == '\r')
+            break;
+    }
+
+    if (i == len)
+    {
+        output_write(out, str, len);
+        return;
+    }
+
+    output_putc(out, '"');
+
+    for (i = 0; i < len; i++)
+    {
+        if (str[i] == '"')
+        {
+            output_write(out, str + from, i + 1 - from);
+            from = i;
+        }
+    }
+
+    output_write(out, str + from, len - from);
+    output_putc(out, '"');
+}
+
+
+/****************************************************************************
+|*
+|* Function: csv_close
+|*
+|* Description;
+|*
+|*     Releases the row kept by the printer
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void csv_close(asn1printer *pr)
+{
+    if (pr->row == NULL)
+        return;
+
+    (void)output_close(&pr->row->vals);
+    free(pr->row);
+    pr->row = NULL;
+}
+
+/* EOF */
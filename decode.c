@@ -0,0 +1,1658 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: decode.c
+|*
+|* Description: ASN.1 decoder of libreadasn. All the state of a decoding
+|*              is kept in an asn1ctx, so that several files can be
+|*              decoded at the same time. Nothing is formatted here: the
+|*              elements found are passed to the callbacks of an
+|*              asn1handler, which decide what to do with them.
+|*
+|* Author: Javier Gutierrez (JG)
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version (decoder moved from readasn.c)
+|* 20261016                     Views and ranges for parallel decoding
+|* 20261016                     Filter of tag paths in decode_asn()
+|* 20261016                     Records and lists of records in the events
+|* 20261016                     Values of the primitives jumped over (asn1_no_values)
+|* 20261016                     Strict checks and code of the first error (asn1_strict)
+|* 20261016                     Names of the tags given by the caller (asn1_tagmap)
+|* 20261016                     Names of the children by the type of the parent (asn1_schema)
+|* 20261016                     Header of the primitives cut short by the end of the input
+|* 20261016                     Lists: SEQUENCE OF of the schema, or named "...List"
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static int      decode_asn      (asn1ctx *ctx);
+static int      get_file_type   (asn1input *in, int *file_type, gsmainfo_t *gsminfo);
+static void     select_tagmap   (asn1ctx *ctx);
+static int      is_record_list  (int file_type, int tag);
+static const char* decode_name  (const asn1ctx *ctx, int type, const asn1item *item, int *child);
+static int      decode_is_seqof (const asn1ctx *ctx, const asn1item *item);
+static void     decode_error    (asn1ctx *ctx, int code, long pos, const char *format, ...);
+static long     frame_end       (const asn1ctx *ctx);
+
+
+/****************************************************************************
+|*
+|* Function: asn1_open
+|*
+|* Description;
+|*
+|*     Opens a file ("-" for stdin) to be decoded and recognizes its type.
+|*     The root records are numbered according to the type of the file.
+|*     The context points into itself: it must not be copied once open.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error opening the file
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Frame of the whole input besides the max_depth levels
+|*
+****************************************************************************/
+int asn1_open(asn1ctx *ctx, const char *filename, int max_depth)
+{
+    memset(ctx, 0x00, sizeof(*ctx));
+
+    ctx->file_type = FT_UNK;
+    ctx->max_depth = (max_depth > 0 ? max_depth : MAXDEPTH);
+
+
+    /* 1. Stack of frames of the decoder: the whole input and max_depth levels */
+
+    if ( ( ctx->frames = (asn1frame *)malloc((size_t)(ctx->max_depth + 1) * sizeof(asn1frame)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for %d levels of depth\n", ctx->max_depth);
+        return -1;
+    }
+
+
+    /* 2. Open Input File */
+
+    if ( input_open(&ctx->in, filename) != 0 )
+    {
+        free(ctx->frames);
+        ctx->frames = NULL;
+        return -1;
+    }
+
+
+    /* 3. Get File Type and the names of its tags */
+
+    if ( get_file_type(&ctx->in, &ctx->file_type, &ctx->gsmainfo) != 0)
+    {
+        fprintf(stderr, "Error getting the type of file %s\n", filename);
+        asn1_close(ctx);
+        return -1;
+    }
+
+    select_tagmap(ctx);
+
+
+    /* 4. The first frame is the whole input */
+
+    memset(&ctx->frames[0], 0x00, sizeof(asn1frame));
+    ctx->frames[0].size = (ctx->in.len < 0 ? LONG_MAX : ctx->in.len); /* Unknown for streams */
+    ctx->frames[0].is_root = (ctx->file_type == FT_UNK ? TRUE : FALSE);
+    ctx->frames[0].recno = (ctx->file_type == FT_UNK ? 1 : 0);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_close
+|*
+|* Description;
+|*
+|*     Closes the input and releases the context
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void asn1_close(asn1ctx *ctx)
+{
+    input_close(&ctx->in);
+
+    free(ctx->frames);
+    ctx->frames = NULL;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_open_view
+|*
+|* Description;
+|*
+|*     Opens a second context over the file of parent, which has to be
+|*     mapped, so that parts of it can be decoded by another thread. The
+|*     view must be closed before parent. Use asn1_range() to choose the
+|*     elements to decode.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error opening the view
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Names telling the lists
+|* 20261016    Frame of the whole input besides the max_depth levels
+|*
+****************************************************************************/
+int asn1_open_view(asn1ctx *ctx, const asn1ctx *parent)
+{
+    memset(ctx, 0x00, sizeof(*ctx));
+
+    ctx->file_type = parent->file_type;
+    ctx->gsmainfo = parent->gsmainfo;
+    ctx->max_depth = parent->max_depth;
+    ctx->schema = parent->schema;
+
+    /* The RAP names are chained in the context itself */
+    ctx->rap_tagmap = parent->rap_tagmap;
+    ctx->tagmap = (parent->tagmap == &parent->rap_tagmap ? &ctx->rap_tagmap : parent->tagmap);
+    ctx->listmap = (parent->listmap == &parent->rap_tagmap ? &ctx->rap_tagmap : parent->listmap);
+
+    if ( ( ctx->frames = (asn1frame *)malloc((size_t)(ctx->max_depth + 1) * sizeof(asn1frame)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for %d levels of depth\n", ctx->max_depth);
+        return -1;
+    }
+
+    if (input_view(&ctx->in, &parent->in) != 0)
+    {
+        free(ctx->frames);
+        ctx->frames = NULL;
+        return -1;
+    }
+
+    return asn1_range(ctx, 0, ctx->in.len, 0, parent->frames[0].recno);
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_range
+|*
+|* Description;
+|*
+|*     Restarts the decoding at pos, limited to the elements within size.
+|*     They are returned at depth and with the record number recno, as if
+|*     they had been found inside the constructed elements around them.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error moving in the input
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int asn1_range(asn1ctx *ctx, long pos, long size, int depth, int recno)
+{
+    asn1frame*      f = &ctx->frames[0];
+
+    memset(f, 0x00, sizeof(*f));
+    f->size = size;
+    f->loc_pos = pos;
+    f->depth = depth;
+    f->recno = recno;
+    f->match = (ctx->filter != NULL ? ctx->filter->start : 0);
+
+    ctx->top = 0;
+    ctx->pos = pos;
+    ctx->is_pending = FALSE;
+    ctx->is_done = FALSE;
+    ctx->is_empty = FALSE;
+
+    if (input_seek(&ctx->in, pos) != 0)
+    {
+        decode_error(ctx, ASN1_ERR_IO, pos, "Error moving to position: %ld", pos);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_rewind
+|*
+|* Description;
+|*
+|*     Goes back to an element already returned (or skipped) of the
+|*     constructed element of frame top, which had the record number
+|*     recno. The constructed elements entered after it are left.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error moving in the input
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int asn1_rewind(asn1ctx *ctx, int top, long pos, int recno)
+{
+    asn1frame*      f = &ctx->frames[top];
+
+    if (ctx->is_done && ctx->top == top)
+    {
+        f->size -= ctx->pos - f->loc_pos;
+        f->loc_pos = ctx->pos;
+    }
+
+    f->size += f->loc_pos - pos;
+    f->loc_pos = pos;
+    f->recno = recno;
+    f->is_eoe = FALSE;
+
+    ctx->top = top;
+    ctx->pos = pos;
+    ctx->is_pending = FALSE;
+    ctx->is_done = FALSE;
+    ctx->is_empty = FALSE;
+
+    if (input_seek(&ctx->in, pos) != 0)
+    {
+        decode_error(ctx, ASN1_ERR_IO, pos, "Error moving to position: %ld", pos);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_filter
+|*
+|* Description;
+|*
+|*     Passes to the callbacks of asn1_decode() only the elements selected
+|*     by flt (NULL: all), with all their children. The paths of flt
+|*     start at the current constructed element.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void asn1_filter(asn1ctx *ctx, const asn1filter *flt)
+{
+    ctx->filter = flt;
+    ctx->frames[ctx->top].match = (flt != NULL ? flt->start : 0);
+    ctx->frames[ctx->top].is_selected = FALSE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_no_values
+|*
+|* Description;
+|*
+|*     With no_values, the values of the primitives are jumped over
+|*     instead of read: only the tags and sizes are decoded, and the
+|*     events of the primitives come with no value (NULL)
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void asn1_no_values(asn1ctx *ctx, int no_values)
+{
+    ctx->no_values = no_values;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_strict
+|*
+|* Description;
+|*
+|*     With strict, asn1_next() also stops with an error on what it
+|*     otherwise goes over: trash bytes, elements longer than the element
+|*     around, End of indefinite length missing or out of place
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void asn1_strict(asn1ctx *ctx, int strict)
+{
+    ctx->strict = strict;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_tagmap
+|*
+|* Description;
+|*
+|*     Names the tags with map (a dictionary loaded with dict_load())
+|*     instead of the built-in names of the type of file. map has to
+|*     outlive the context and its views.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Names telling the lists
+|*
+****************************************************************************/
+void asn1_tagmap(asn1ctx *ctx, const tagmap_t *map)
+{
+    ctx->tagmap = map;
+    ctx->listmap = map;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_schema
+|*
+|* Description;
+|*
+|*     Names the elements by their class and tag in the type of the
+|*     constructed element around them (see decode_name()), with the
+|*     schema of a dictionary. NULL: by their tag only, with the tagmap.
+|*     The types are followed from the current constructed element on.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void asn1_schema(asn1ctx *ctx, const asn1schema *schema)
+{
+    ctx->schema = schema;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_decode
+|*
+|* Description;
+|*
+|*     Decodes the rest of the file passing the elements found to the
+|*     callbacks of handler
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding
+|*      ASN1_STOP: Stopped by a callback
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int asn1_decode(asn1ctx *ctx, const asn1handler *handler, void *user)
+{
+    ctx->handler = handler;
+    ctx->user = user;
+
+    return decode_asn(ctx);
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_tagname
+|*
+|* Description;
+|*
+|*     Name of a tag in the type of file being decoded
+|*
+|* Return:
+|*      Name of the tag or NULL if unknown
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+const char *asn1_tagname(const asn1ctx *ctx, int tag)
+{
+    return tagmap_name(ctx->tagmap, tag);
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_next
+|*
+|* Description;
+|*
+|*     Decodes the next element of the current constructed element. A
+|*     constructed element returned before and not entered is skipped.
+|*     The values of primitives are read (in place if the file is
+|*     mapped). The End of an indefinite length is returned as an
+|*     element with is_eoe set.
+|*
+|* Return:
+|*      ASN1_ELEM: Element found
+|*      ASN1_LEAVE: End of the current constructed element (back to its
+|*                  parent). ev describes the constructed element.
+|*      ASN1_END: End of the input
+|*     -1: Error decoding
+|*
+|* Modifications:
+|* 20261016    Initial version (loop of decode_asn)
+|* 20261016    Values jumped over with no_values
+|* 20261016    Strict checks
+|* 20261016    Primitives cut short by the end of the input (is_cut)
+|* 20261016    Lists (is_seqof)
+|* 20261016    Element running past the end of the file told with its position
+|*
+****************************************************************************/
+int asn1_next(asn1ctx *ctx, asn1event *ev)
+{
+    asn1input*          in = &ctx->in;
+    asn1frame*          frames = ctx->frames;
+    asn1frame*          f = NULL;
+    asn1item*           a_item = &ctx->item;
+    const uchar*        value = NULL;
+    long                end = 0;
+
+    /* 1. Constructed element neither entered nor skipped: skip it */
+
+    if (ctx->is_pending && asn1_skip(ctx) != 0)
+        return -1;
+
+    f = &frames[ctx->top];
+
+
+    /* 2. Previous element finished: account it in the frame */
+
+    if (ctx->is_done)
+    {
+        f->size -= ctx->pos - f->loc_pos ; //a_item.size;
+        f->loc_pos = ctx->pos;
+
+        if (f->is_root)
+        {
+            f->recno++;
+        }
+
+        ctx->is_done = FALSE;
+    }
+
+    ev->value = NULL;
+    ev->is_eoe = FALSE;
+    ev->is_cut = FALSE;
+    ev->is_seqof = FALSE;
+
+    for (;;)
+    {
+        /* 3. Is the frame finished? */
+
+        if (ctx->is_empty)
+        {
+            /* 3.1. Empty constructed: it ends where it starts */
+
+            ctx->is_empty = FALSE;
+            ctx->is_done = TRUE;
+
+            ev->item = a_item;
+            ev->name = decode_name(ctx, f->type, a_item, &ctx->item_type);
+            ev->pos = ev->vpos = ctx->pos;
+            ev->depth = f->depth;
+            ev->recno = f->recno;
+            ev->is_record = f->is_root;
+            ev->is_list = is_record_list(ctx->file_type, a_item->tag);
+            return ASN1_LEAVE;
+        }
+
+        if (f->is_eoe || !(f->size > 0 || f->is_indef) ||
+                (ctx->top == 0 && in->len < 0 && input_eof(in))) /* Input of unknown size (stream): stop at its end */
+        {
+            if (ctx->top == 0)
+            {
+                return ASN1_END;
+            }
+
+            /* 3.2. Back to the parent: close its constructed element */
+
+            f = &frames[--ctx->top];
+            ctx->is_done = TRUE;
+
+            ev->item = &frames[ctx->top + 1].item;
+            ev->name = decode_name(ctx, f->type, ev->item, &ctx->item_type);
+            ev->pos = ev->vpos = ctx->pos;
+            ev->depth = f->depth;
+            ev->recno = f->recno;
+            ev->is_record = f->is_root;
+            ev->is_list = frames[ctx->top + 1].is_root;
+            return ASN1_LEAVE;
+        }
+
+        /* 3.3. Strict: an element of indefinite length ends before the one around */
+
+        if (ctx->strict && f->is_indef && ( end = frame_end(ctx) ) >= 0 && ctx->pos >= end)
+        {
+            decode_error(ctx, ASN1_ERR_EOE, ctx->pos, "Missing End of indefinite length at position: %ld", ctx->pos);
+            return -1;
+        }
+
+
+        /* 4. TAG:   decode */
+
+        if (decode_tag(ctx, a_item) == -1)
+        {
+            decode_error(ctx, ASN1_ERR_TAG, ctx->pos, "Error decoding tag at position: %ld", ctx->pos);
+            return -1;
+        }
+
+
+        /* 5. SIZE:  decode */
+
+        if (decode_size(ctx, a_item) == -1)
+        {
+            decode_error(ctx, ASN1_ERR_SIZE, ctx->pos, "Error decoding size at position: %ld", ctx->pos);
+            return -1;
+        }
+
+
+        /* 6. Did we find 2 null bytes or trash byte? */
+
+        if ( a_item->tag == 0 && a_item->size == 0 && f->is_indef)
+        {
+
+            /* 6.1. End of indefinite length found */
+
+            f->is_eoe = TRUE;
+
+            ev->item = a_item;
+            ev->name = NULL;
+            ev->pos = f->loc_pos;
+            ev->vpos = ctx->pos;
+            ev->depth = f->depth;
+            ev->recno = f->recno;
+            ev->is_record = FALSE;
+            ev->is_list = FALSE;
+            ev->is_eoe = TRUE;
+            return ASN1_ELEM;
+        }
+        else if ( a_item->tag_x[0] == 0x00 && ctx->strict )
+        {
+
+            /* 6.2. Strict: End of indefinite length out of place or trash byte */
+
+            if (a_item->size == 0)
+                decode_error(ctx, ASN1_ERR_EOE, f->loc_pos, "End of indefinite length out of an element of indefinite length at position: %ld", f->loc_pos);
+            else
+                decode_error(ctx, ASN1_ERR_TRASH, f->loc_pos, "Trash byte at position: %ld", f->loc_pos);
+            return -1;
+        }
+        else if ( a_item->tag_x[0] == 0x00 && a_item->size != 0 && ! f->is_indef)
+        {
+
+            /* 6.3. Trash byte: Rewind one byte in order to try to recover and keep decoding */
+
+            f->loc_pos++;
+            ctx->pos = f->loc_pos;
+            f->size--;
+            if (input_seek(in, ctx->pos) != 0) // rewind 1 byte
+            {
+                decode_error(ctx, ASN1_ERR_IO, ctx->pos, "Error moving 1 byte back in file: %s", strerror(errno));
+                return -1;
+            }
+            continue;
+        }
+
+        /* 6.4. Strict: the element fits in the one around */
+
+        if (ctx->strict && ( end = frame_end(ctx) ) >= 0 && ctx->pos + a_item->size > end)
+        {
+            if (end == in->len)
+                decode_error(ctx, ASN1_ERR_TRUNC, f->loc_pos, "Element at %ld runs past the end of the file (%ld)", f->loc_pos, end);
+            else
+                decode_error(ctx, ASN1_ERR_LENGTH, f->loc_pos, "Element longer than the one around at position: %ld", f->loc_pos);
+            return -1;
+        }
+
+        break;
+    }
+
+
+    /* 7. VALUE: Primitive or Constructed */
+
+    ev->item = a_item;
+    ev->name = decode_name(ctx, f->type, a_item, &ctx->item_type);
+    ev->pos = f->loc_pos;
+    ev->vpos = ctx->pos;
+    ev->depth = f->depth;
+    ev->recno = f->recno;
+    ev->is_record = f->is_root;
+    ev->is_list = (a_item->pc == 1 && is_record_list(ctx->file_type, a_item->tag));
+    ev->is_seqof = (a_item->pc == 1 && decode_is_seqof(ctx, a_item));
+
+    if (a_item->pc == 0 && ctx->no_values)
+    {
+        /* 7.1. Primitive without value: jump over it, checking it is there */
+
+        if (input_seek(in, ctx->pos + a_item->size) != 0 || (in->len >= 0 && ctx->pos + a_item->size > in->len))
+        {
+            decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+            return -1;
+        }
+
+        ctx->pos += a_item->size;
+        ctx->is_done = TRUE;
+    }
+    else if (a_item->pc == 0)
+    {
+        /* 7.2. Primitive: Read element (in place if the file is mapped) */
+
+        if ( ( value = input_read(in, a_item->size) ) == NULL )
+        {
+            decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+            ev->is_cut = TRUE;
+            return -1;
+        }
+
+        ctx->pos += a_item->size;
+        ctx->is_done = TRUE;
+
+        ev->value = value;
+    }
+    else
+    {
+        /* 7.3. Constructed: entered or skipped afterwards */
+
+        ctx->is_pending = TRUE;
+    }
+
+    return ASN1_ELEM;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_enter
+|*
+|* Description;
+|*
+|*     Descends into the constructed element returned by asn1_next(): the
+|*     following calls return its children.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No constructed element to enter or nesting too deep
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Type of the schema without SCHEMA_LIST
+|* 20261016    max_depth constructed elements can be entered, not one less
+|*
+****************************************************************************/
+int asn1_enter(asn1ctx *ctx)
+{
+    asn1frame*          frames = ctx->frames;
+    asn1frame*          f = &frames[ctx->top];
+    asn1frame*          child = NULL;
+    const asn1item*     a_item = &ctx->item;
+    int                 file_type = ctx->file_type;
+
+    if (!ctx->is_pending)
+    {
+        decode_error(ctx, ASN1_ERR_IO, ctx->pos, "No constructed element to enter at position: %ld", ctx->pos);
+        return -1;
+    }
+
+    ctx->is_pending = FALSE;
+
+    /* 1. Empty constructed: nothing to push */
+
+    if (!a_item->size_x[0]) // If size == 0x80 then it's an indifinite constructed, if 0x00 might be an empty constructed.
+    {
+        ctx->is_empty = TRUE;
+        return 0;
+    }
+
+
+    /* 2. Push a frame to decode the constructed element */
+
+    if (f->depth >= ctx->max_depth) /* Depth also counts the elements around a range */
+    {
+        decode_error(ctx, ASN1_ERR_DEPTH, ctx->pos, "Found nesting deeper than %d levels at position: %ld", ctx->max_depth, ctx->pos);
+        return -1;
+    }
+
+    child = &frames[ctx->top + 1];
+    child->size = a_item->size;
+    child->loc_pos = ctx->pos;
+    child->depth = f->depth + 1;
+    child->is_indef = (a_item->size == 0 ? TRUE : FALSE);
+    child->is_eoe = FALSE;
+    child->item = *a_item;
+    child->type = (int)((unsigned int)ctx->item_type & ~SCHEMA_LIST);
+
+    child->is_root = is_record_list(file_type, a_item->tag);
+    child->recno = (child->is_root ? 1 : f->recno);
+
+    ctx->top++;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: asn1_skip
+|*
+|* Description;
+|*
+|*     Jumps over the constructed element returned by asn1_next() using
+|*     its length, without decoding its children. If there is no such
+|*     element, jumps to the end of the current constructed element: the
+|*     next call to asn1_next() returns ASN1_LEAVE. Elements of
+|*     indefinite length have to be walked to find their end.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding or moving in the input
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int asn1_skip(asn1ctx *ctx)
+{
+    asn1frame*          f = &ctx->frames[ctx->top];
+    asn1event           ev;
+    int                 rc = 0;
+
+    /* 1. Constructed element returned by asn1_next() */
+
+    if (ctx->is_pending)
+    {
+        /* 1.1. Indefinite length: walk its children up to its end */
+
+        if (ctx->item.size_x[0] && ctx->item.size == 0)
+        {
+            if (asn1_enter(ctx) != 0 || asn1_skip(ctx) != 0)
+                return -1;
+
+            return asn1_next(ctx, &ev) == ASN1_LEAVE ? 0 : -1;
+        }
+
+        /* 1.2. Definite length: jump over it */
+
+        ctx->is_pending = FALSE;
+        ctx->is_done = TRUE;
+        ctx->pos += ctx->item.size;
+
+        if (input_seek(&ctx->in, ctx->pos) != 0)
+        {
+            decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+            return -1;
+        }
+
+        return 0;
+    }
+
+
+    /* 2. Rest of the current constructed element */
+
+    if (ctx->is_empty)
+        return 0;
+
+    if (f->is_indef)
+    {
+        /* 2.1. Indefinite length: up to its End of indefinite length */
+
+        while ( ( rc = asn1_next(ctx, &ev) ) == ASN1_ELEM && !ev.is_eoe)
+            ;
+
+        return rc == ASN1_ELEM ? 0 : -1;
+    }
+
+    /* 2.2. Definite length: jump to its end */
+
+    if (ctx->is_done)
+    {
+        f->size -= ctx->pos - f->loc_pos;
+        ctx->is_done = FALSE;
+    }
+
+    ctx->pos += f->size;
+    f->loc_pos = ctx->pos;
+    f->size = 0;
+
+    if (input_seek(&ctx->in, ctx->pos) != 0)
+    {
+        decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: decode_asn
+|*
+|* Description;
+|*
+|*     Decodes the tag items up to the end of the input, entering all the
+|*     constructed elements, and passes them to the callbacks of the
+|*     handler. With a filter, only the elements selected and their
+|*     children are passed: the constructed elements in which nothing can
+|*     be selected are skipped by their length, and the others are walked
+|*     silently.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding
+|*      ASN1_STOP: Stopped by a callback
+|*
+|*
+|* Author: Javier Gutierrez (JG)
+|*
+|* Modifications:
+|* 20050707    JG    Initial version
+|* 20261016          Iterative version with an explicit stack of frames
+|* 20261016          Elements passed to the callbacks of the handler
+|* 20261016          Built on asn1_next()
+|* 20261016          Filter of tag paths
+|* 20261016          Header of a primitive cut short (cut callback)
+|*
+****************************************************************************/
+static int decode_asn(asn1ctx *ctx)
+{
+    const asn1handler*  h = ctx->handler;
+    const asn1filter*   flt = ctx->filter;
+    asn1frame*          f = NULL;
+    asn1event           ev;
+    unsigned long long  match = 0;
+    int                 top = ctx->top;
+    int                 rc = 0;
+
+    memset(&ev, 0x00, sizeof(ev));
+
+    while ( ( rc = asn1_next(ctx, &ev) ) != ASN1_END )
+    {
+        f = &ctx->frames[ctx->top];
+
+        /* 1. Filter: elements not selected are walked or skipped silently */
+
+        if (flt != NULL && rc == ASN1_ELEM && !f->is_selected)
+        {
+            if (ev.is_eoe)
+                continue;
+
+            match = filter_next(flt, f->match, ev.item->class, ev.item->tag);
+
+            if (!(match & flt->accept))
+            {
+                if (ev.item->pc == 0)
+                    continue;
+
+                if (match == 0 || !ev.item->size_x[0])
+                {
+                    if (asn1_skip(ctx) != 0)
+                        return -1;
+                }
+                else
+                {
+                    if (asn1_enter(ctx) != 0)
+                        return -1;
+
+                    ctx->frames[ctx->top].match = match;
+                    ctx->frames[ctx->top].is_selected = FALSE;
+                }
+
+                top = ctx->top;
+                continue;
+            }
+        }
+
+        if (flt != NULL && rc == ASN1_LEAVE && ctx->top < top && !ctx->frames[ctx->top + 1].is_selected)
+        {
+            top = ctx->top;
+            continue;
+        }
+
+
+        /* 2. Elements to the callbacks */
+
+        switch (rc)
+        {
+            case ASN1_ELEM:
+                if (ev.item->pc == 0 || ev.is_eoe)
+                {
+                    if (h->primitive != NULL && h->primitive(ctx->user, &ev) != 0)
+                        return ASN1_STOP;
+                }
+                else
+                {
+                    if (h->start_cons != NULL && h->start_cons(ctx->user, &ev) != 0)
+                        return ASN1_STOP;
+
+                    if (asn1_enter(ctx) != 0)
+                        return -1;
+
+                    if (ctx->top > top)
+                        ctx->frames[ctx->top].is_selected = TRUE;
+                }
+                break;
+            case ASN1_LEAVE:
+                if (h->end_cons != NULL && h->end_cons(ctx->user, &ev) != 0)
+                    return ASN1_STOP;
+                break;
+            default:
+                /* 2.1. Primitive cut short by the end of the input: its header, if selected */
+
+                if (ev.is_cut && h->cut != NULL &&
+                        (flt == NULL || f->is_selected || (filter_next(flt, f->match, ev.item->class, ev.item->tag) & flt->accept)))
+                    h->cut(ctx->user, &ev);
+
+                return -1;
+        }
+
+        top = ctx->top;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: decode_tag
+|*
+|* Description;
+|*
+|*     decodes tag into a asn1item
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding
+|*
+|*
+|* Author: Javier Gutierrez (JG)
+|*
+|* Modifications:
+|* 20050715    JG    Initial version
+|* 20261016          Not static: measured by bench/decode_bench.c
+|*
+****************************************************************************/
+int decode_tag(
+    asn1ctx*    ctx,        /* Context of the decoding */
+    asn1item*   a_item      /* pointer asn1item where to store the information */
+)
+{
+    uchar       buffin;
+    int         c, i;
+
+
+    a_item->tag = 0;
+
+    /* 1. Read from file */
+
+    if ( ( c = input_getc(&ctx->in) ) == EOF )
+    {
+        decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+        return -1;
+    }
+    buffin = (uchar)c;
+    ctx->pos++;
+
+
+    /* 2. Store class, primitive/constructed info and hexa tag */
+
+    a_item->class = (unsigned) buffin>>6;
+    a_item->pc = (unsigned) (buffin>>5)&0x1;
+    a_item->tag_x[0] = buffin;
+    a_item->tag_l = 1;
+
+
+    /* 3. Work according to number of tag octets */
+
+    if ( ( buffin & 0x1F ) == 0x1F )
+    {
+        /* 3.1 Tag has more than one octect */
+
+        for(i = 1; i<=4; i++)
+        {
+            if ( ( c = input_getc(&ctx->in) ) == EOF )
+            {
+                decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+                return -1;
+            }
+            buffin = (uchar)c;
+            ctx->pos++;
+
+            a_item->tag <<= 7;
+            a_item->tag += (int)(buffin&0x7F);
+            a_item->tag_x[i] = buffin;
+            a_item->tag_l += 1;
+
+            if ( (buffin>>7) == 0 )
+                break;
+
+        }
+
+        if ( i>3 )
+        {
+            decode_error(ctx, ASN1_ERR_TAG, ctx->pos, "Found tag bigger than 4 bytes at position: %ld", ctx->pos);
+            return -1;
+        }
+
+    }
+    else
+    {
+        /* 3.2 Tag has just one octect */
+
+        a_item->tag = (int)buffin&0x1F;
+    }
+
+    bcd_2_hexa(a_item->tag_h, a_item->tag_x, a_item->tag_l);
+
+    return 0;
+
+}
+
+
+/****************************************************************************
+|*
+|* Function: decode_size
+|*
+|* Description;
+|*
+|*     decodes size into a asn1item
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding
+|*
+|*
+|* Author: Javier Gutierrez (JG)
+|*
+|* Modifications:
+|* 20050715    JG    Initial version
+|* 20261016          Not static: measured by bench/decode_bench.c
+|*
+****************************************************************************/
+int decode_size(
+    asn1ctx*    ctx,          /* Context of the decoding */
+    asn1item*   a_item        /* pointer asn1item where to store the information */
+)
+{
+    uchar       buffin;
+    int         c, i;
+
+
+    a_item->size = 0;
+
+
+    /* 1. Read from file */
+
+    if ( ( c = input_getc(&ctx->in) ) == EOF )
+    {
+        if (a_item->tag_x[0] == 0x00) /* To avoid giving error on trash bytes */
+        {
+            a_item->size = 1;
+            return 0;
+        }
+        decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+        return -1;
+    }
+    buffin = (uchar)c;
+    ctx->pos++;
+
+
+    /* 2. Storing size_x */
+
+    a_item->size_x[0] = buffin;
+    a_item->size_l = 1;
+
+
+    /* 3. Work according the number of octets */
+
+    if (buffin>>7)
+    {
+        /* 3.1. Size with more than one octet */
+
+        for(i = 1; (i <= (int)(a_item->size_x[0] & 0x7F)) && (i <= 4); i++)
+        {
+            if ( ( c = input_getc(&ctx->in) ) == EOF )
+            {
+                decode_error(ctx, ASN1_ERR_TRUNC, ctx->pos, "Found end of file too soon at position: %ld", ctx->pos);
+                return -1;
+            }
+            buffin = (uchar)c;
+            ctx->pos++;
+
+            a_item->size <<= 8;
+            a_item->size += (int)buffin;
+            a_item->size_x[i] = buffin;
+            a_item->size_l += 1;
+        }
+
+        if ( i>7 )
+        {
+            decode_error(ctx, ASN1_ERR_SIZE, ctx->pos, "Found size bigger than 8 bytes at position: %ld", ctx->pos);
+            return -1;
+        }
+
+
+    }
+    else
+    {
+        /* 3.2. Size with just one octet */
+
+        a_item->size = (int)(buffin);
+    }
+
+    bcd_2_hexa(a_item->size_h, a_item->size_x, a_item->size_l);
+
+    return 0;
+
+}
+
+
+/****************************************************************************
+|*
+|* Function: bcd_2_hexa
+|*
+|* Description;
+|*
+|*     Converts a bcd chain into an hexadecimal string
+|*
+|* Return:
+|*      void
+|*
+|*
+|* Author: Javier Gutierrez (JG)
+|*
+|* Modifications:
+|* 20050719    JG    Initial version
+|* 20261016          Not static: measured by bench/decode_bench.c
+|*
+****************************************************************************/
+void bcd_2_hexa(
+    char*           str2,   /* String to store the converted value */
+    const uchar*    str1,   /* String to convert */
+    const int       len     /* Because the string can contain \0 we cannot use strlen() */
+)
+{
+    hexa_encode(str2, str1, (long)len);
+
+    str2[len*2] = '\0';
+
+}
+
+
+/****************************************************************************
+|*
+|* Function: decode_error
+|*
+|* Description;
+|*
+|*     Reports an error to the handler or, if it has no error callback,
+|*     to stderr. The first one is kept in the context: its code
+|*     (ASN1_ERR_*) and the position pos where it was found.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Code and position of the first error
+|*
+****************************************************************************/
+static void decode_error(asn1ctx *ctx, int code, long pos, const char *format, ...)
+{
+    va_list     args;
+    char        msg[256];
+
+    if (ctx->error == 0)
+    {
+        ctx->error = code;
+        ctx->error_pos = pos;
+    }
+
+    va_start(args, format);
+    vsnprintf(msg, sizeof(msg), format, args);
+    va_end(args);
+
+    if (ctx->handler != NULL && ctx->handler->error != NULL)
+        ctx->handler->error(ctx->user, ctx->pos, msg);
+    else
+        fprintf(stderr, "%s\n", msg);
+}
+
+
+/****************************************************************************
+|*
+|* Function: frame_end
+|*
+|* Description;
+|*
+|*     End of the element being decoded: that of the current constructed
+|*     element or, if it has indefinite length, of the first one around
+|*     with a length
+|*
+|* Return:
+|*      Position of the end
+|*     -1: Unknown (stream)
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long frame_end(const asn1ctx *ctx)
+{
+    const asn1frame*    f = NULL;
+    int                 i = 0;
+
+    for (i = ctx->top; i >= 0; i--)
+    {
+        f = &ctx->frames[i];
+
+        if (f->is_indef)
+            continue;
+
+        if (i == 0 && ctx->in.len < 0)
+            return -1;
+
+        return f->loc_pos + f->size;
+    }
+
+    return -1;
+}
+
+
+/****************************************************************************
+|*
+|* Function: is_record_list
+|*
+|* Description;
+|*
+|*     Is a constructed element with tag the list of the root records of
+|*     the type of file? CallEventDetailList (TAP), the list of NRT
+|*     records and ReturnDetailList (RAP).
+|*
+|* Return:
+|*      TRUE or FALSE
+|*
+|* Modifications:
+|* 20261016    Initial version (moved from asn1_enter)
+|*
+****************************************************************************/
+static int is_record_list(int file_type, int tag)
+{
+    switch (file_type)
+    {
+        case FT_TAP: return (tag == 3 ? TRUE : FALSE);
+        case FT_NRT: return (tag == 2 ? TRUE : FALSE);
+        case FT_RAP: return (tag == 536 ? TRUE : FALSE);
+        default:     return FALSE;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: decode_name
+|*
+|* Description;
+|*
+|*     Names item, found in a constructed element of type. With a schema,
+|*     class and tag are looked up in the children of type, then at the
+|*     top level (unknown type, or an element out of its place), and
+|*     only then by the tag alone, except for the universal class which
+|*     the tagmap does not tell apart. child is the type of item.
+|*
+|* Return:
+|*      Name of the element or NULL if unknown
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static const char *decode_name(const asn1ctx *ctx, int type, const asn1item *item, int *child)
+{
+    const schemaent* e = NULL;
+
+    *child = 0;
+
+    if (ctx->schema == NULL)
+        return tagmap_name(ctx->tagmap, item->tag);
+
+    if ( ( e = schema_find(ctx->schema, type, item->class, item->tag) ) != NULL ||
+            (type != 0 && ( e = schema_find(ctx->schema, 0, item->class, item->tag) ) != NULL) )
+    {
+        *child = (int)e->child;
+        return (e->name != 0 ? ctx->schema->names + e->name : NULL);
+    }
+
+    return (item->class != 0 ? tagmap_name(ctx->tagmap, item->tag) : NULL);
+}
+
+
+/****************************************************************************
+|*
+|* Function: decode_is_seqof
+|*
+|* Description;
+|*
+|*     Tells if item, just named by decode_name(), is a list: its type is
+|*     a SEQUENCE OF or SET OF in the schema or, out of the schema, its
+|*     name ends with "List", as all the lists of TAP, NRT and RAP do.
+|*     The names of listmap are kept without tag names (-n), so that the
+|*     output has the same shape.
+|*
+|* Return:
+|*      TRUE or FALSE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int decode_is_seqof(const asn1ctx *ctx, const asn1item *item)
+{
+    const char*     name = NULL;
+    size_t          len = 0;
+
+    if (ctx->item_type != 0)
+        return ((unsigned int)ctx->item_type & SCHEMA_LIST) != 0;
+
+    if (ctx->schema != NULL && item->class == 0)
+        return FALSE;
+
+    if ( ( name = tagmap_name(ctx->listmap, item->tag) ) == NULL )
+        return FALSE;
+
+    len = strlen(name);
+
+    return (len >= 4 && strcmp(name + len - 4, "List") == 0);
+}
+
+
+/****************************************************************************
+|*
+|* Function: select_tagmap
+|*
+|* Description;
+|*
+|*     Chooses the names of the tags according to the type of file. RAP
+|*     names are looked up before the TAP ones.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version (moved from main)
+|* 20261016    Names telling the lists
+|*
+****************************************************************************/
+static void select_tagmap(asn1ctx *ctx)
+{
+    int             file_type = ctx->file_type;
+    gsmainfo_t*     gsmainfo = &ctx->gsmainfo;
+
+    ctx->tagmap = NULL;
+
+    if (
+            ((file_type == FT_TAP || file_type == FT_NOT || file_type == FT_RAP) && gsmainfo->ver == 3) ||
+            (file_type == FT_ACK && gsmainfo->ver == 0)
+       )
+    {
+        if (gsmainfo->rel <= 9)
+        {
+            ctx->tagmap = &tap03le09_tagname_map;
+        }
+        else
+        {
+            ctx->tagmap = &tap03ge10_tagname_map;
+        }
+
+        if (((file_type == FT_RAP || file_type == FT_ACK) && gsmainfo->rap_ver == 1))
+        {
+            ctx->rap_tagmap = rap01XX_tagname_map;
+            ctx->rap_tagmap.next = ctx->tagmap;
+            ctx->tagmap = &ctx->rap_tagmap;
+        }
+
+    }
+    else if (file_type == FT_NRT)
+    {
+        ctx->tagmap = &nrt0201_tagname_map;
+    }
+
+    ctx->listmap = ctx->tagmap;
+}
+
+
+/****************************************************************************
+|*
+|* Function: get_file_type
+|*
+|* Description;
+|*
+|*     Show usage
+|*
+|* Return:
+|*      int
+|*
+|* Author: Javier Gutierrez (JG)
+|*
+|* Modifications:
+|* 20120306    JG    Initial version
+|*
+****************************************************************************/
+static int get_file_type(asn1input *in, int *file_type, gsmainfo_t *gsmainfo)
+{
+    uchar       buffin_str[200]; /* First bytes of the file */
+    int         buffin_len = 200, i = 0;
+
+    memset(buffin_str, 0x00, sizeof(buffin_str));
+
+    if (in == NULL || file_type == NULL || gsmainfo == NULL)
+    {
+        fprintf(stderr, "Passed NULL Arguments");
+        return -1;
+    }
+
+    if (input_peek(in, buffin_str, (long)buffin_len) == 0)
+    {
+        fprintf(stderr, "Error reading file at position: %d\n", 1);
+        return -1;
+    }
+
+    /*
+     * We try to recognize the type of the file with this algorithm:
+     *
+     * Regular expression   File type   Description
+     * ^61.+5f814405        FT_TAP      TAP file
+     * ^62                  FT_NOT      Notification file
+     * ^7f8416              FT_RAP      RAP file
+     * ^7f8417              FT_ACK      Acknowledge file
+     * ^61.+5f2901          FT_NRT      NRTRDE file
+     * Otherwise            FT_UNK      Any other ASN.1 file
+     *
+     */
+    switch(buffin_str[0])
+    {
+        case 0x61: /* TAP or NRT */
+            for (i = 1; i < 150; i++)
+            {
+                if (buffin_str[i] == 0x5f &&
+                        buffin_str[i + 1] == 0x81 &&
+                        buffin_str[i + 2] == 0x49 &&
+                        buffin_str[i + 3] == 0x01)
+                {
+                    gsmainfo->ver = (int)buffin_str[i + 4];
+                }
+
+                if (buffin_str[i] == 0x5f &&
+                        buffin_str[i + 1] == 0x81 &&
+                        buffin_str[i + 2] == 0x3d &&
+                        buffin_str[i + 3] == 0x01)
+                {
+                    gsmainfo->rel = (int)buffin_str[i + 4];
+                    *file_type =  FT_TAP;
+                    break;
+                }
+
+            }
+            for (i = 1; i < 28; i++)
+            {
+                if (buffin_str[i] == 0x5f &&
+                        buffin_str[i + 1] == 0x29 &&
+                        buffin_str[i + 2] == 0x01)
+                {
+                    gsmainfo->ver = (int)buffin_str[i + 3];
+                }
+
+                if (buffin_str[i] == 0x5f &&
+                        buffin_str[i + 1] == 0x25 &&
+                        buffin_str[i + 2] == 0x01)
+                {
+                    gsmainfo->rel = (int)buffin_str[i + 3];
+                    *file_type =  FT_NRT;
+                    break;
+                }
+            }
+            break;
+        case 0x62:
+            for (i = 1; i < 150; i++)
+            {
+                if (buffin_str[i] == 0x5f &&
+                        buffin_str[i + 1] == 0x81 &&
+                        buffin_str[i + 2] == 0x49 &&
+                        buffin_str[i + 3] == 0x01)
+                {
+                    gsmainfo->ver = (int)buffin_str[i + 4];
+                }
+
+                if (buffin_str[i] == 0x5f &&
+                        buffin_str[i + 1] == 0x81 &&
+                        buffin_str[i + 2] == 0x3d &&
+                        buffin_str[i + 3] == 0x01)
+                {
+                    gsmainfo->rel = (int)buffin_str[i + 4];
+                    *file_type =  FT_NOT;
+                    break;
+                }
+
+            }
+            break;
+        case 0x7f: /* RAP or ACK */
+            if (buffin_str[1] == 0x84 && buffin_str[2] == 0x16)
+            {
+                for (i = 1; i < 150; i++)
+                {
+                    if (buffin_str[i] == 0x5f &&
+                            buffin_str[i + 1] == 0x81 &&
+                            buffin_str[i + 2] == 0x49 &&
+                            buffin_str[i + 3] == 0x01)
+                    {
+                        gsmainfo->ver = (int)buffin_str[i + 4];
+                    }
+
+                    if (buffin_str[i] == 0x5f &&
+                            buffin_str[i + 1] == 0x81 &&
+                            buffin_str[i + 2] == 0x3d &&
+                            buffin_str[i + 3] == 0x01)
+                    {
+                        gsmainfo->rel = (int)buffin_str[i + 4];
+                    }
+
+                    if (buffin_str[i] == 0x5f &&
+                            buffin_str[i + 1] == 0x84 &&
+                            buffin_str[i + 2] == 0x20 &&
+                            buffin_str[i + 3] == 0x01)
+                    {
+                        gsmainfo->rap_ver = (int)buffin_str[i + 4];
+                    }
+
+                    if (buffin_str[i] == 0x5f &&
+                            buffin_str[i + 1] == 0x84 &&
+                            buffin_str[i + 2] == 0x1f &&
+                            buffin_str[i + 3] == 0x01)
+                    {
+                        gsmainfo->rap_rel = (int)buffin_str[i + 4];
+                        *file_type =  FT_RAP;
+                        break;
+                    }
+
+                }
+            }
+            if (buffin_str[1] == 0x84 && buffin_str[2] == 0x17)
+            {
+                gsmainfo->rap_ver = 1; /* Ack files have no version */
+                gsmainfo->rap_rel = 5;
+                *file_type =  FT_ACK;
+            }
+            break;
+        default:
+            *file_type = FT_UNK;
+    }
+
+    return 0;
+}
+
+/* EOF */
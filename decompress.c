@@ -0,0 +1,532 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: decompress.c
+|*
+|* Description: Decompression of the input on the fly. Compressed files
+|*              and pipes are recognized by their first bytes (gzip,
+|*              bzip2, zstd) and read as streams: the decompressed bytes
+|*              go straight into the ring of the input (input.c), with no
+|*              temporary files. Mapped files are decompressed from the
+|*              mapping, pipes from a buffer of what read() gives.
+|*
+|*              Concatenated streams (gzip members, bzip2 streams, zstd
+|*              frames) are decompressed one after the other. Each format
+|*              is there only if its library was found when building
+|*              (HAVE_ZLIB, HAVE_BZLIB, HAVE_ZSTD, set by the makefile).
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_BZLIB
+#include <bzlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+
+#include "readasn.h"
+
+
+/* 2. Defines */
+
+#define DECOMP_CHUNK    (1L << 30)      /* Most compressed bytes given at once (uInt of zlib) */
+
+
+/* 3. Types */
+
+struct _asn1decomp
+{
+    int             kind;           /* COMP_GZIP, COMP_BZIP2, COMP_ZSTD */
+    const uchar*    map;            /* Compressed file mapped. NULL: read from fd */
+    long            map_len;
+    int             fd;             /* Compressed stream */
+    uchar*          buff;           /* Compressed bytes read from fd */
+    const uchar*    next;           /* Compressed bytes not decompressed yet */
+    long            avail;
+    int             eof;            /* No more compressed bytes */
+    int             is_end;         /* End of a compressed stream: another one may follow */
+#ifdef HAVE_ZLIB
+    z_stream        gz;
+#endif
+#ifdef HAVE_BZLIB
+    bz_stream       bz;
+#endif
+#ifdef HAVE_ZSTD
+    ZSTD_DStream*   zs;
+#endif
+};
+
+
+/* 4. Prototypes */
+
+static int      decomp_init     (asn1decomp *z);
+static void     decomp_end      (asn1decomp *z);
+static int      decomp_step     (asn1decomp *z, uchar *dst, long room, long *got);
+static int      decomp_source   (asn1decomp *z);
+
+
+/* 5. Global Variables */
+
+static const char* comp_names[] = { "", "gzip", "bzip2", "zstd" };  /* Names of COMP_* */
+
+
+/****************************************************************************
+|*
+|* Function: decompress_detect
+|*
+|* Description;
+|*
+|*     Recognizes a compressed input by its first len bytes
+|*
+|* Return:
+|*      COMP_GZIP, COMP_BZIP2, COMP_ZSTD
+|*      COMP_NONE: Not compressed
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int decompress_detect(const uchar *magic, long len)
+{
+    if (len >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+        return COMP_GZIP;
+
+    if (len >= 4 && magic[0] == 'B' && magic[1] == 'Z' && magic[2] == 'h' && magic[3] >= '1' && magic[3] <= '9')
+        return COMP_BZIP2;
+
+    if (len >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd)
+        return COMP_ZSTD;
+
+    return COMP_NONE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: decompress_open
+|*
+|* Description;
+|*
+|*     Starts decompressing the input in: from the mapping map of len
+|*     bytes or, if map is NULL, from fd, starting with the len bytes of
+|*     pending already read from it. The mapping is released by
+|*     decompress_close().
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Format not built in or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int decompress_open(asn1input *in, int kind, const uchar *map, int fd, const uchar *pending, long len)
+{
+    asn1decomp*     z = NULL;
+
+    if ( ( z = (asn1decomp *)calloc(1, sizeof(asn1decomp)) ) == NULL ||
+            (map == NULL && ( z->buff = (uchar *)malloc(INPUT_RING_SIZE * sizeof(uchar)) ) == NULL) )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the decompression\n");
+        free(z);
+        return -1;
+    }
+
+    z->kind = kind;
+    z->fd = fd;
+
+    /* 1. Source: the whole mapping, or what was read from fd */
+
+    if (map != NULL)
+    {
+        z->map = z->next = map;
+        z->map_len = z->avail = len;
+        z->eof = TRUE;
+    }
+    else
+    {
+        memcpy(z->buff, pending, (size_t)len);
+        z->next = z->buff;
+        z->avail = len;
+    }
+
+    /* 2. Decompressor */
+
+    if (decomp_init(z) != 0)
+    {
+        free(z->buff);
+        free(z);
+        return -1;
+    }
+
+    in->decomp = z;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: decompress_read
+|*
+|* Description;
+|*
+|*     Decompresses up to room bytes into dst. Returns as soon as some
+|*     bytes are out, so decoding starts before the whole input is read.
+|*
+|* Return:
+|*     >0: Number of bytes decompressed
+|*      0: End of the input
+|*     -1: Error reading or corrupt input
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+long decompress_read(asn1input *in, uchar *dst, long room)
+{
+    asn1decomp*     z = in->decomp;
+    long            got = 0;
+    int             rc = 0;
+
+    for (;;)
+    {
+        /* 1. More compressed bytes */
+
+        if (z->avail == 0 && !z->eof && decomp_source(z) != 0)
+            return -1;
+
+        if (z->avail == 0 && z->eof)
+        {
+            if (z->is_end)
+                return 0;
+
+            fprintf(stderr, "The %s input ends too soon\n", comp_names[z->kind]);
+            return -1;
+        }
+
+        /* 2. Next stream after the end of one */
+
+        if (z->is_end)
+        {
+            decomp_end(z);
+            if (decomp_init(z) != 0)
+                return -1;
+            z->is_end = FALSE;
+        }
+
+        /* 3. Decompress */
+
+        if ( ( rc = decomp_step(z, dst, room, &got) ) < 0 )
+            return -1;
+
+        z->is_end = (rc == 1);
+
+        if (got > 0)
+            return got;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: decompress_close
+|*
+|* Description;
+|*
+|*     Releases the decompressor, its buffer and the mapping
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void decompress_close(asn1input *in)
+{
+    asn1decomp*     z = in->decomp;
+
+    if (z == NULL)
+        return;
+
+    decomp_end(z);
+
+    if (z->map != NULL)
+        (void)munmap((void *)z->map, (size_t)z->map_len);
+
+    free(z->buff);
+    free(z);
+
+    in->decomp = NULL;
+}
+
+
+/****************************************************************************
+|*
+|* Function: decomp_source
+|*
+|* Description;
+|*
+|*     Reads compressed bytes from the stream into the buffer
+|*
+|* Return:
+|*      0: Successful, also at the end of the stream (eof set)
+|*     -1: Error reading
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int decomp_source(asn1decomp *z)
+{
+    ssize_t         got = 0;
+
+    do
+    {
+        got = read(z->fd, z->buff, INPUT_RING_SIZE);
+    }
+    while (got == -1 && errno == EINTR);
+
+    if (got == -1)
+    {
+        fprintf(stderr, "Error reading input: %s\n", strerror(errno));
+        return -1;
+    }
+
+    z->next = z->buff;
+    z->avail = (long)got;
+    z->eof = (got == 0);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: decomp_init
+|*
+|* Description;
+|*
+|*     Starts the decompressor of the format of z
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Format not built in or error of the library
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int decomp_init(asn1decomp *z)
+{
+    switch (z->kind)
+    {
+#ifdef HAVE_ZLIB
+        case COMP_GZIP:
+            memset(&z->gz, 0x00, sizeof(z->gz));
+            if (inflateInit2(&z->gz, 15 + 16) == Z_OK)  /* 15 + 16: gzip header */
+                return 0;
+            break;
+#endif
+#ifdef HAVE_BZLIB
+        case COMP_BZIP2:
+            memset(&z->bz, 0x00, sizeof(z->bz));
+            if (BZ2_bzDecompressInit(&z->bz, 0, 0) == BZ_OK)
+                return 0;
+            break;
+#endif
+#ifdef HAVE_ZSTD
+        case COMP_ZSTD:
+            if ( ( z->zs = ZSTD_createDStream() ) != NULL && !ZSTD_isError(ZSTD_initDStream(z->zs)) )
+                return 0;
+            break;
+#endif
+        default:
+            fprintf(stderr, "The input is compressed with %s, which this build of readasn cannot read\n", comp_names[z->kind]);
+            return -1;
+    }
+
+    fprintf(stderr, "Couldn't start the %s decompression\n", comp_names[z->kind]);
+    return -1;
+}
+
+
+/****************************************************************************
+|*
+|* Function: decomp_end
+|*
+|* Description;
+|*
+|*     Releases the decompressor of the format of z
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void decomp_end(asn1decomp *z)
+{
+    switch (z->kind)
+    {
+#ifdef HAVE_ZLIB
+        case COMP_GZIP:
+            (void)inflateEnd(&z->gz);
+            break;
+#endif
+#ifdef HAVE_BZLIB
+        case COMP_BZIP2:
+            (void)BZ2_bzDecompressEnd(&z->bz);
+            break;
+#endif
+#ifdef HAVE_ZSTD
+        case COMP_ZSTD:
+            (void)ZSTD_freeDStream(z->zs);
+            z->zs = NULL;
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: decomp_step
+|*
+|* Description;
+|*
+|*     Decompresses the compressed bytes available into dst, up to room
+|*     bytes. got is the number of bytes out.
+|*
+|* Return:
+|*      0: Successful
+|*      1: End of a compressed stream
+|*     -1: Corrupt input
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int decomp_step(asn1decomp *z, uchar *dst, long room, long *got)
+{
+    long            avail = (z->avail < DECOMP_CHUNK ? z->avail : DECOMP_CHUNK);
+    long            used = 0;
+    const char*     msg = "corrupt data";
+    int             rc = 0;
+
+    *got = 0;
+
+    switch (z->kind)
+    {
+#ifdef HAVE_ZLIB
+        case COMP_GZIP:
+            z->gz.next_in = (Bytef *)z->next;
+            z->gz.avail_in = (uInt)avail;
+            z->gz.next_out = (Bytef *)dst;
+            z->gz.avail_out = (uInt)(room < DECOMP_CHUNK ? room : DECOMP_CHUNK);
+
+            rc = inflate(&z->gz, Z_NO_FLUSH);
+
+            used = avail - (long)z->gz.avail_in;
+            *got = (long)((uchar *)z->gz.next_out - dst);
+
+            if (rc == Z_STREAM_END)
+                rc = 1;
+            else if (rc == Z_OK || rc == Z_BUF_ERROR)
+                rc = 0;
+            else
+            {
+                msg = (z->gz.msg != NULL ? z->gz.msg : msg);
+                rc = -1;
+            }
+            break;
+#endif
+#ifdef HAVE_BZLIB
+        case COMP_BZIP2:
+            z->bz.next_in = (char *)z->next;
+            z->bz.avail_in = (unsigned int)avail;
+            z->bz.next_out = (char *)dst;
+            z->bz.avail_out = (unsigned int)(room < DECOMP_CHUNK ? room : DECOMP_CHUNK);
+
+            rc = BZ2_bzDecompress(&z->bz);
+
+            used = avail - (long)z->bz.avail_in;
+            *got = (long)((uchar *)z->bz.next_out - dst);
+
+            rc = (rc == BZ_STREAM_END ? 1 : (rc == BZ_OK ? 0 : -1));
+            break;
+#endif
+#ifdef HAVE_ZSTD
+        case COMP_ZSTD:
+        {
+            ZSTD_inBuffer   zin = { z->next, (size_t)avail, 0 };
+            ZSTD_outBuffer  zout = { dst, (size_t)room, 0 };
+            size_t          ret = ZSTD_decompressStream(z->zs, &zout, &zin);
+
+            used = (long)zin.pos;
+            *got = (long)zout.pos;
+
+            if (ZSTD_isError(ret))
+            {
+                msg = ZSTD_getErrorName(ret);
+                rc = -1;
+            }
+            else
+                rc = (ret == 0 ? 1 : 0);    /* 0: end of a frame */
+            break;
+        }
+#endif
+        default:
+            (void)avail;    /* No library built in */
+            rc = -1;
+            break;
+    }
+
+    z->next += used;
+    z->avail -= used;
+
+    if (rc < 0)
+        fprintf(stderr, "Error decompressing the %s input: %s\n", comp_names[z->kind], msg);
+
+    return rc;
+}
+
+/* EOF */
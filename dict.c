@@ -0,0 +1,269 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: dict.c
+|*
+|* Description: Dictionaries of tag names, written by asn2dict from ASN.1
+|*              specifications. A dictionary has the layout of a tagmap_t:
+|*              a header, the offset of the name of each tag (0: no name)
+|*              and the names one after the other, starting with "". It
+|*              is mapped in memory and used in place, so loading it
+|*              costs the same whatever its size and a lookup is an
+|*              index into an array, as with the built-in tables.
+|*
+|*              A dictionary can also hold a schema: the name and type of
+|*              each child (class and tag) of each type, in a hash table
+|*              after the names (see schema_find()).
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Schema: names of the children by type
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+#include "readasn.h"
+
+
+/****************************************************************************
+|*
+|* Function: dict_save
+|*
+|* Description;
+|*
+|*     Writes the names of map (not the ones chained with next) and the
+|*     nents entries of the schema ents (0: none) to filename. names_len
+|*     is the size of map->names. It is written aside and renamed, so
+|*     that a reader never finds half a dictionary.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error writing the dictionary
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int dict_save(const tagmap_t *map, long names_len, const schemaent *ents, unsigned int nents, const char *filename)
+{
+    static const char pad[4] = { 0, 0, 0, 0 };
+    asn1dicthead    head;
+    char*           tmp = NULL;
+    FILE*           fp = NULL;
+    int             rc = 0;
+
+    /* 1. Header */
+
+    memset(&head, 0x00, sizeof(head));
+    memcpy(head.magic, DICT_MAGIC, sizeof(head.magic));
+    head.version = DICT_VERSION;
+    head.ntags = (unsigned int)map->ntags;
+    head.names_len = (unsigned int)((names_len + 3) & ~3L); /* The entries after them are aligned */
+    head.nents = nents;
+
+
+    /* 2. Header, index and names to <file>.tmp, then renamed */
+
+    if ( ( tmp = (char *)malloc(strlen(filename) + sizeof(".tmp")) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory\n");
+        return -1;
+    }
+    strcat(strcpy(tmp, filename), ".tmp");
+
+    if ( ( fp = fopen(tmp, "wb") ) == NULL )
+    {
+        fprintf(stderr, "Cannot write the dictionary %s: %s\n", tmp, strerror(errno));
+        rc = -1;
+    }
+    else
+    {
+        if (fwrite(&head, sizeof(head), 1, fp) != 1 ||
+                (map->ntags > 0 && fwrite(map->idx, sizeof(unsigned int), (size_t)map->ntags, fp) != (size_t)map->ntags) ||
+                fwrite(map->names, 1, (size_t)names_len, fp) != (size_t)names_len ||
+                fwrite(pad, 1, (size_t)(head.names_len - names_len), fp) != (size_t)(head.names_len - names_len) ||
+                (nents > 0 && fwrite(ents, sizeof(schemaent), (size_t)nents, fp) != (size_t)nents))
+            rc = -1;
+
+        if (fclose(fp) != 0)
+            rc = -1;
+
+        if (rc == 0 && rename(tmp, filename) != 0)
+            rc = -1;
+
+        if (rc != 0)
+        {
+            fprintf(stderr, "Cannot write the dictionary %s: %s\n", filename, strerror(errno));
+            (void)unlink(tmp);
+        }
+    }
+
+    free(tmp);
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: dict_load
+|*
+|* Description;
+|*
+|*     Maps the dictionary filename. Tags without name in it are looked
+|*     up in next (NULL: none), so several dictionaries can be chained.
+|*     The offsets are checked once here: lookups do not check them.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Cannot be read or not a dictionary
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int dict_load(asn1dict *dict, const char *filename, const tagmap_t *next)
+{
+    const asn1dicthead* head = NULL;
+    const unsigned int* idx = NULL;
+    const char*     names = NULL;
+    const schemaent* ents = NULL;
+    struct stat     st;
+    void*           map = NULL;
+    unsigned int    i = 0;
+    unsigned int    nfree = 0;
+    int             damaged = FALSE;
+    int             fd = -1;
+
+    memset(dict, 0x00, sizeof(*dict));
+
+    /* 1. Map it */
+
+    if ( ( fd = open(filename, O_RDONLY) ) == -1 )
+    {
+        fprintf(stderr, "Cannot open the dictionary %s: %s\n", filename, strerror(errno));
+        return -1;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(asn1dicthead) ||
+            ( map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) ) == MAP_FAILED)
+    {
+        fprintf(stderr, "Not a dictionary of tag names: %s\n", filename);
+        (void)close(fd);
+        return -1;
+    }
+
+    (void)close(fd);
+
+
+    /* 2. Same layout, sizes that match and names ended */
+
+    head = (const asn1dicthead *)map;
+    idx = (const unsigned int *)((const char *)map + sizeof(asn1dicthead));
+    names = (const char *)(idx + head->ntags);
+    ents = (const schemaent *)(names + head->names_len);
+
+    if (memcmp(head->magic, DICT_MAGIC, sizeof(head->magic)) != 0 ||
+            head->version != DICT_VERSION ||
+            head->ntags > INT_MAX / sizeof(unsigned int) ||
+            head->names_len == 0 || head->names_len % 4 != 0 ||
+            (head->nents & (head->nents - 1)) != 0 || /* Power of 2 */
+            (long long)st.st_size != (long long)sizeof(asn1dicthead) + head->ntags * (long long)sizeof(unsigned int) +
+                head->names_len + head->nents * (long long)sizeof(schemaent) ||
+            names[0] != '\0' || names[head->names_len - 1] != '\0')
+    {
+        fprintf(stderr, "Not a dictionary of tag names: %s\n", filename);
+        (void)munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+
+    /* 3. Offsets within the names, and a free entry in the schema: lookups stop there */
+
+    for (i = 0; i < head->ntags; i++)
+        damaged |= (idx[i] >= head->names_len);
+
+    for (i = 0; i < head->nents; i++)
+    {
+        damaged |= (ents[i].name >= head->names_len);
+        nfree += (ents[i].key == SCHEMA_EMPTY);
+    }
+
+    if (damaged || (head->nents > 0 && nfree == 0))
+    {
+        fprintf(stderr, "Dictionary damaged: %s\n", filename);
+        (void)munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+
+    dict->map = map;
+    dict->map_len = (long)st.st_size;
+    dict->tagmap.idx = idx;
+    dict->tagmap.names = names;
+    dict->tagmap.ntags = (int)head->ntags;
+    dict->tagmap.next = next;
+
+    if (head->nents > 0)
+    {
+        dict->schema.ents = ents;
+        dict->schema.mask = head->nents - 1;
+        dict->schema.names = names;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: dict_close
+|*
+|* Description;
+|*
+|*     Releases the mapping of the dictionary
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void dict_close(asn1dict *dict)
+{
+    if (dict->map != NULL)
+        (void)munmap(dict->map, (size_t)dict->map_len);
+
+    memset(dict, 0x00, sizeof(*dict));
+}
+
+/* EOF */
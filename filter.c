@@ -0,0 +1,398 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: filter.c
+|*
+|* Description: Filter of the elements by tag paths, as in
+|*              "TransferBatch/AuditControlInfo/TotalCharge". Each step
+|*              is a tag name, a tag number, a star (any element) or two
+|*              stars (any number of elements, also none). Paths start at
+|*              the top of the file and are separated by commas.
+|*
+|*              The paths are compiled into a list of steps and matched
+|*              as an automaton whose states are the steps which can
+|*              match the next element, kept as a bit mask in each frame.
+|*              A constructed element with no state left is not walked.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Look up of tag names shared with csv.c
+|* 20261016                     Names of the schema, and class of the tags
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static unsigned long long filter_closure(const asn1filter *flt, unsigned long long match);
+static int      filter_add_tag  (int *tags, int *classes, int n, int max, int tag, int cls);
+static int      filter_step     (asn1step *step, const char *token, int len, const tagmap_t *map, const asn1schema *schema);
+
+
+/****************************************************************************
+|*
+|* Function: filter_compile
+|*
+|* Description;
+|*
+|*     Compiles the paths of expr. Tag names are looked up in map and
+|*     in schema (NULL: none).
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Wrong expression
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Names of the schema
+|*
+****************************************************************************/
+int filter_compile(asn1filter *flt, const char *expr, const tagmap_t *map, const asn1schema *schema)
+{
+    const char*     p = expr;
+    const char*     end = NULL;
+    int             first = 0;
+    int             len = 0;
+
+    memset(flt, 0x00, sizeof(*flt));
+
+    for (;;)
+    {
+        /* 1. Next step: up to "/", "," or the end */
+
+        while (isspace((unsigned char)*p))
+            p++;
+
+        for (end = p; *end != '\0' && *end != '/' && *end != ','; end++)
+            ;
+
+        for (len = (int)(end - p); len > 0 && isspace((unsigned char)p[len - 1]); len--)
+            ;
+
+        if (len == 0)
+        {
+            fprintf(stderr, "Empty step in the filter at: \"%s\"\n", p);
+            return -1;
+        }
+
+        if (flt->nsteps >= FILTER_MAX_STEPS - 1)
+        {
+            fprintf(stderr, "Too many steps in the filter (maximum %d)\n", FILTER_MAX_STEPS - 1);
+            return -1;
+        }
+
+        if (filter_step(&flt->steps[flt->nsteps++], p, len, map, schema) != 0)
+            return -1;
+
+
+        /* 2. End of the path: STEP_END */
+
+        if (*end != '/')
+        {
+            flt->steps[flt->nsteps].kind = STEP_END;
+            flt->accept |= 1ULL << flt->nsteps;
+            flt->start |= 1ULL << first;
+
+            first = ++flt->nsteps;
+        }
+
+        if (*end == '\0')
+            break;
+
+        p = end + 1;
+    }
+
+    flt->start = filter_closure(flt, flt->start);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: filter_step
+|*
+|* Description;
+|*
+|*     Compiles one step of a path: "*", "**", a number (of any class)
+|*     or a tag name
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Unknown tag name
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Names of the schema, and class of the tags
+|*
+****************************************************************************/
+static int filter_step(asn1step *step, const char *token, int len, const tagmap_t *map, const asn1schema *schema)
+{
+    int             tag = 0;
+    int             i = 0;
+
+    memset(step, 0x00, sizeof(*step));
+
+    /* 1. Wildcards */
+
+    if (len == 1 && token[0] == '*')
+    {
+        step->kind = STEP_ANY;
+        return 0;
+    }
+
+    if (len == 2 && token[0] == '*' && token[1] == '*')
+    {
+        step->kind = STEP_DEEP;
+        return 0;
+    }
+
+    step->kind = STEP_TAG;
+
+
+    /* 2. Tag number */
+
+    for (i = 0; i < len && isdigit((unsigned char)token[i]); i++)
+        tag = tag * 10 + (token[i] - '0');
+
+    if (i == len)
+    {
+        step->tags[0] = tag;
+        step->classes[0] = CLASSES_ANY;
+        step->ntags = 1;
+        return 0;
+    }
+
+
+    /* 3. Tag name: all the tags with it */
+
+    if ( ( step->ntags = filter_lookup(map, schema, token, len, step->tags, step->classes, FILTER_STEP_TAGS) ) == 0 )
+    {
+        fprintf(stderr, "Unknown tag name in the filter: %.*s%s\n", len, token,
+                (map == NULL && schema == NULL ? " (no tag names for this file, use numbers)" : ""));
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: filter_lookup
+|*
+|* Description;
+|*
+|*     Looks up the tags with the name of len characters, up to max of
+|*     them, with the classes they match: in map (any class, but the
+|*     universal one with a schema) and in the children of schema (NULL:
+|*     none), as decode_name() names them
+|*
+|* Return:
+|*      Number of tags found
+|*
+|* Modifications:
+|* 20261016    Initial version (taken from filter_step)
+|* 20261016    Names of the schema, and class of the tags
+|*
+****************************************************************************/
+int filter_lookup(const tagmap_t *map, const asn1schema *schema, const char *name, int len, int *tags, int *classes, int max)
+{
+    const tagmap_t* m = NULL;
+    const schemaent* e = NULL;
+    const char*     str = NULL;
+    unsigned int    i = 0;
+    int             ntags = 0;
+    int             n = 0;
+    int             tag = 0;
+
+    /* 1. Tag map */
+
+    for (m = map; m != NULL; m = m->next)
+    {
+        if (m->ntags > ntags)
+            ntags = m->ntags;
+    }
+
+    for (tag = 0; tag < ntags; tag++)
+    {
+        if ( ( str = tagmap_name(map, tag) ) != NULL &&
+                (int)strlen(str) == len && strncmp(str, name, (size_t)len) == 0 )
+        {
+            n = filter_add_tag(tags, classes, n, max, tag, (schema != NULL ? CLASSES_NAMED : CLASSES_ANY));
+        }
+    }
+
+
+    /* 2. Children of the schema: class and tag of their key (see schema_key()) */
+
+    for (i = 0; schema != NULL && i <= schema->mask; i++)
+    {
+        e = &schema->ents[i];
+
+        if (e->key != SCHEMA_EMPTY && e->name != 0 &&
+                (int)strlen(str = schema->names + e->name) == len && strncmp(str, name, (size_t)len) == 0 )
+        {
+            n = filter_add_tag(tags, classes, n, max, (int)(e->key & 0x3fffffffU), 1 << (e->key >> 30));
+        }
+    }
+
+    return n;
+}
+
+
+/****************************************************************************
+|*
+|* Function: filter_add_tag
+|*
+|* Description;
+|*
+|*     Adds the classes of tag to the n tags found so far, or tag itself
+|*     if it is not among them and there is room for it (max)
+|*
+|* Return:
+|*      Number of tags
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int filter_add_tag(int *tags, int *classes, int n, int max, int tag, int cls)
+{
+    int             i = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        if (tags[i] == tag)
+        {
+            classes[i] |= cls;
+            return n;
+        }
+    }
+
+    if (n < max)
+    {
+        tags[n] = tag;
+        classes[n++] = cls;
+    }
+
+    return n;
+}
+
+
+/****************************************************************************
+|*
+|* Function: filter_next
+|*
+|* Description;
+|*
+|*     Steps of the filter after an element of class and tag, from the
+|*     steps of its parent. Among them, those of flt->accept select the
+|*     element, and the rest can match its children. 0: none.
+|*
+|* Return:
+|*      Bit mask of the steps
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Class of the element
+|*
+****************************************************************************/
+unsigned long long filter_next(const asn1filter *flt, unsigned long long match, int class, int tag)
+{
+    const asn1step* step = NULL;
+    unsigned long long next = 0;
+    int             p = 0;
+    int             i = 0;
+
+    for (p = 0; match != 0; p++, match >>= 1)
+    {
+        if (!(match & 1))
+            continue;
+
+        step = &flt->steps[p];
+
+        switch (step->kind)
+        {
+            case STEP_DEEP:
+                next |= 1ULL << p;
+                break;
+            case STEP_ANY:
+                next |= 1ULL << (p + 1);
+                break;
+            case STEP_TAG:
+                for (i = 0; i < step->ntags; i++)
+                {
+                    if (step->tags[i] == tag && (step->classes[i] >> class & 1))
+                    {
+                        next |= 1ULL << (p + 1);
+                        break;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return filter_closure(flt, next);
+}
+
+
+/****************************************************************************
+|*
+|* Function: filter_closure
+|*
+|* Description;
+|*
+|*     Adds the steps after each "**" active, which can match no element
+|*
+|* Return:
+|*      Bit mask of the steps
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static unsigned long long filter_closure(const asn1filter *flt, unsigned long long match)
+{
+    int             p = 0;
+
+    for (p = 0; p < flt->nsteps; p++)
+    {
+        if ((match >> p & 1) && flt->steps[p].kind == STEP_DEEP)
+            match |= 1ULL << (p + 1);
+    }
+
+    return match;
+}
+
+/* EOF */
@@ -0,0 +1,415 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: hexa.c
+|*
+|* Description: Conversion of bytes into hexadecimal strings and check of
+|*              printable strings, alone or in the same pass. There is a
+|*              scalar version and, on x86, SSE2 and AVX2 versions. The
+|*              best one supported by the CPU is chosen at start up.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Check of printable strings
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#include "readasn.h"
+
+#ifdef HEXA_X86
+    #include <immintrin.h>
+#endif
+
+
+/* 2. Global Variables */
+
+static const char hexa_pairs[] =                /* Hexadecimal string of every byte */
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+static const uchar text_class[256] =           /* Class of every byte for is_printable() */
+{
+    /* isprint() in the C locale: 0x20-0x7e. Others: HEXA_NOPRINT, but 0x0a: HEXA_EOL */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+};
+
+void (*hexa_encode_wide)(char *dst, const uchar *src, long len) = hexa_encode_scalar;
+int  (*hexa_encode_check_wide)(char *dst, const uchar *src, long len) = hexa_encode_check_scalar;
+
+
+/****************************************************************************
+|*
+|* Function: hexa_init
+|*
+|* Description;
+|*
+|*     Chooses the version of hexa_encode() and hexa_encode_check() for
+|*     strings of 16 bytes or more according to the CPU. Runs before
+|*     main().
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+__attribute__((constructor)) void hexa_init(void)
+{
+#ifdef HEXA_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        hexa_encode_wide = hexa_encode_avx2;
+        hexa_encode_check_wide = hexa_encode_check_avx2;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        hexa_encode_wide = hexa_encode_sse2;
+        hexa_encode_check_wide = hexa_encode_check_sse2;
+    }
+#endif
+}
+
+
+/****************************************************************************
+|*
+|* Function: hexa_encode_scalar
+|*
+|* Description;
+|*
+|*     Writes 2 hexadecimal characters per byte of src into dst. dst is
+|*     not terminated.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void hexa_encode_scalar(char *dst, const uchar *src, long len)
+{
+    long        i = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        memcpy(dst + i * 2, hexa_pairs + src[i] * 2, 2);
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: hexa_encode_check_scalar
+|*
+|* Description;
+|*
+|*     As hexa_encode_scalar(), checking at the same time which kind of
+|*     characters the string has. dst can be NULL to only do the check.
+|*
+|* Return:
+|*      HEXA_NOPRINT and/or HEXA_EOL flags. See hexa_printable().
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int hexa_encode_check_scalar(char *dst, const uchar *src, long len)
+{
+    long        i = 0;
+    int         flags = 0;
+
+    for (i = 0; i < len; i++)
+        flags |= text_class[src[i]];
+
+    if (dst != NULL)
+        hexa_encode_scalar(dst, src, len);
+
+    return flags;
+}
+
+#ifdef HEXA_X86
+
+/****************************************************************************
+|*
+|* Function: hexa_encode_sse2
+|*
+|* Description;
+|*
+|*     As hexa_encode_scalar(), 16 bytes at a time. Every nibble n becomes
+|*     n + '0', plus 'a' - '0' - 10 when it is greater than 9.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+__attribute__((target("sse2"))) void hexa_encode_sse2(char *dst, const uchar *src, long len)
+{
+    const __m128i   mask = _mm_set1_epi8(0x0f);
+    const __m128i   nine = _mm_set1_epi8(9);
+    const __m128i   zero = _mm_set1_epi8('0');
+    const __m128i   alpha = _mm_set1_epi8('a' - '0' - 10);
+    __m128i         x, hi, lo;
+    long            i = 0;
+
+    for (i = 0; i + 16 <= len; i += 16)
+    {
+        x = _mm_loadu_si128((const __m128i *)(src + i));
+
+        hi = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+        lo = _mm_and_si128(x, mask);
+
+        hi = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), alpha));
+        lo = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), alpha));
+
+        _mm_storeu_si128((__m128i *)(dst + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    hexa_encode_scalar(dst + i * 2, src + i, len - i);
+}
+
+
+/****************************************************************************
+|*
+|* Function: hexa_encode_check_sse2
+|*
+|* Description;
+|*
+|*     As hexa_encode_check_scalar(), 16 bytes at a time, converting each
+|*     block while it is in a register. A byte is printable if, signed,
+|*     it is greater than 0x1f and lower than 0x7f.
+|*
+|* Return:
+|*      HEXA_NOPRINT and/or HEXA_EOL flags
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+__attribute__((target("sse2"))) int hexa_encode_check_sse2(char *dst, const uchar *src, long len)
+{
+    const __m128i   mask = _mm_set1_epi8(0x0f);
+    const __m128i   nine = _mm_set1_epi8(9);
+    const __m128i   zero = _mm_set1_epi8('0');
+    const __m128i   alpha = _mm_set1_epi8('a' - '0' - 10);
+    const __m128i   low = _mm_set1_epi8(0x1f);
+    const __m128i   high = _mm_set1_epi8(0x7f);
+    const __m128i   eol = _mm_set1_epi8(0x0a);
+    const __m128i   ones = _mm_set1_epi8(-1);
+    __m128i         x, hi, lo, is_eol;
+    __m128i         bad = _mm_setzero_si128(), eols = _mm_setzero_si128();
+    long            i = 0;
+    int             flags = 0;
+
+    for (i = 0; i + 16 <= len; i += 16)
+    {
+        x = _mm_loadu_si128((const __m128i *)(src + i));
+
+        /* 1. Check */
+
+        is_eol = _mm_cmpeq_epi8(x, eol);
+        eols = _mm_or_si128(eols, is_eol);
+        bad = _mm_or_si128(bad, _mm_andnot_si128(
+                    _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(x, low), _mm_cmplt_epi8(x, high)), is_eol),
+                    ones));
+
+        if (dst == NULL)
+            continue;
+
+        /* 2. Convert */
+
+        hi = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+        lo = _mm_and_si128(x, mask);
+
+        hi = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), alpha));
+        lo = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), alpha));
+
+        _mm_storeu_si128((__m128i *)(dst + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    if (_mm_movemask_epi8(bad))
+        flags |= HEXA_NOPRINT;
+    if (_mm_movemask_epi8(eols))
+        flags |= HEXA_EOL;
+
+    return flags | hexa_encode_check_scalar(dst == NULL ? NULL : dst + i * 2, src + i, len - i);
+}
+
+
+/****************************************************************************
+|*
+|* Function: hexa_encode_avx2
+|*
+|* Description;
+|*
+|*     As hexa_encode_sse2(), 32 bytes at a time. Unpacking works within
+|*     each 128 bits lane, so the lanes are put back in order at the end.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    vzeroupper before the SSE2 tail
+|*
+****************************************************************************/
+__attribute__((target("avx2"))) void hexa_encode_avx2(char *dst, const uchar *src, long len)
+{
+    const __m256i   mask = _mm256_set1_epi8(0x0f);
+    const __m256i   nine = _mm256_set1_epi8(9);
+    const __m256i   zero = _mm256_set1_epi8('0');
+    const __m256i   alpha = _mm256_set1_epi8('a' - '0' - 10);
+    __m256i         x, hi, lo, a, b;
+    long            i = 0;
+
+    for (i = 0; i + 32 <= len; i += 32)
+    {
+        x = _mm256_loadu_si256((const __m256i *)(src + i));
+
+        hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), mask);
+        lo = _mm256_and_si256(x, mask);
+
+        hi = _mm256_add_epi8(_mm256_add_epi8(hi, zero), _mm256_and_si256(_mm256_cmpgt_epi8(hi, nine), alpha));
+        lo = _mm256_add_epi8(_mm256_add_epi8(lo, zero), _mm256_and_si256(_mm256_cmpgt_epi8(lo, nine), alpha));
+
+        a = _mm256_unpacklo_epi8(hi, lo);
+        b = _mm256_unpackhi_epi8(hi, lo);
+
+        _mm256_storeu_si256((__m256i *)(dst + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    /* Upper halves cleared: no AVX to SSE transition in the tail and the caller */
+
+    _mm256_zeroupper();
+
+    hexa_encode_sse2(dst + i * 2, src + i, len - i);
+}
+
+
+/****************************************************************************
+|*
+|* Function: hexa_encode_check_avx2
+|*
+|* Description;
+|*
+|*     As hexa_encode_check_sse2(), 32 bytes at a time
+|*
+|* Return:
+|*      HEXA_NOPRINT and/or HEXA_EOL flags
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    vzeroupper before the SSE2 tail
+|*
+****************************************************************************/
+__attribute__((target("avx2"))) int hexa_encode_check_avx2(char *dst, const uchar *src, long len)
+{
+    const __m256i   mask = _mm256_set1_epi8(0x0f);
+    const __m256i   nine = _mm256_set1_epi8(9);
+    const __m256i   zero = _mm256_set1_epi8('0');
+    const __m256i   alpha = _mm256_set1_epi8('a' - '0' - 10);
+    const __m256i   low = _mm256_set1_epi8(0x1f);
+    const __m256i   high = _mm256_set1_epi8(0x7f);
+    const __m256i   eol = _mm256_set1_epi8(0x0a);
+    const __m256i   ones = _mm256_set1_epi8(-1);
+    __m256i         x, hi, lo, a, b, is_eol;
+    __m256i         bad = _mm256_setzero_si256(), eols = _mm256_setzero_si256();
+    long            i = 0;
+    int             flags = 0;
+
+    for (i = 0; i + 32 <= len; i += 32)
+    {
+        x = _mm256_loadu_si256((const __m256i *)(src + i));
+
+        /* 1. Check */
+
+        is_eol = _mm256_cmpeq_epi8(x, eol);
+        eols = _mm256_or_si256(eols, is_eol);
+        bad = _mm256_or_si256(bad, _mm256_andnot_si256(
+                    _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi8(x, low), _mm256_cmpgt_epi8(high, x)), is_eol),
+                    ones));
+
+        if (dst == NULL)
+            continue;
+
+        /* 2. Convert */
+
+        hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), mask);
+        lo = _mm256_and_si256(x, mask);
+
+        hi = _mm256_add_epi8(_mm256_add_epi8(hi, zero), _mm256_and_si256(_mm256_cmpgt_epi8(hi, nine), alpha));
+        lo = _mm256_add_epi8(_mm256_add_epi8(lo, zero), _mm256_and_si256(_mm256_cmpgt_epi8(lo, nine), alpha));
+
+        a = _mm256_unpacklo_epi8(hi, lo);
+        b = _mm256_unpackhi_epi8(hi, lo);
+
+        _mm256_storeu_si256((__m256i *)(dst + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    if (_mm256_movemask_epi8(bad))
+        flags |= HEXA_NOPRINT;
+    if (_mm256_movemask_epi8(eols))
+        flags |= HEXA_EOL;
+
+    _mm256_zeroupper();
+
+    return flags | hexa_encode_check_sse2(dst == NULL ? NULL : dst + i * 2, src + i, len - i);
+}
+
+#endif
+
+/* EOF */
@@ -0,0 +1,496 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: index.c
+|*
+|* Description: Index of the root records of a file (position, size,
+|*              record number, depth and tag of each), kept next to it in
+|*              <file>.idx. The index is built in one pass over the file
+|*              without printing anything, and is mapped back in
+|*              memory to decode only some records without reading the
+|*              rest of the file. An index whose file changed (size or
+|*              modification time) is not used.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static int      index_add       (asn1index *idx, const asn1event *ev, long size);
+static char*    index_name      (const char *filename, const char *suffix);
+
+
+/****************************************************************************
+|*
+|* Function: index_build
+|*
+|* Description;
+|*
+|*     Indexes the root records of the file opened in ctx. The records
+|*     are walked, not jumped over by their length, so that they end where
+|*     they end in the dump of the whole file, also when some length is
+|*     wrong. If the file is damaged, the records found before the damage
+|*     are kept in the index.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding the file or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int index_build(asn1index *idx, asn1ctx *ctx)
+{
+    asn1event       ev;
+    asn1event       rec;
+    asn1frame*      f = NULL;
+    int             top = -1;           /* Frame of the record being walked. -1: none */
+    int             rc = 0;
+
+    memset(idx, 0x00, sizeof(*idx));
+
+    if (ctx->in.mode == IN_STREAM)
+    {
+        fprintf(stderr, "Streams cannot be indexed\n");
+        return -1;
+    }
+
+    if (asn1_range(ctx, 0, ctx->in.len, 0, ctx->file_type == FT_UNK ? 1 : 0) != 0)
+        return -1;
+
+    ctx->frames[0].is_root = (ctx->file_type == FT_UNK ? TRUE : FALSE);
+
+    for (;;)
+    {
+        if ( ( rc = asn1_next(ctx, &ev) ) == ASN1_END )
+            return 0;
+
+        if (rc == -1)
+            return -1;
+
+        f = &ctx->frames[ctx->top];
+
+        /* 1. End of the record being walked: keep where it was */
+
+        if (rc == ASN1_LEAVE && ctx->top == top)
+        {
+            top = -1;
+
+            if (index_add(idx, &rec, ctx->pos - rec.pos) != 0)
+                return -1;
+        }
+
+        if (rc == ASN1_LEAVE || ev.is_eoe)
+            continue;
+
+        /* 2. Primitive record */
+
+        if (top == -1 && f->is_root && ev.item->pc == 0)
+        {
+            if (index_add(idx, &ev, ctx->pos - ev.pos) != 0)
+                return -1;
+            continue;
+        }
+
+        /* 3. Constructed record: walked up to its end */
+
+        if (top == -1 && f->is_root)
+        {
+            rec = ev;
+            top = ctx->top;
+        }
+
+        if (ev.item->pc == 1 && asn1_enter(ctx) != 0)
+            return -1;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: index_add
+|*
+|* Description;
+|*
+|*     Adds the record of ev, of size bytes, to the index
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory or record too big
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int index_add(asn1index *idx, const asn1event *ev, long size)
+{
+    asn1idxentry*   entries = NULL;
+    asn1idxentry*   e = NULL;
+
+    if (size < 0 || (unsigned long)size > UINT_MAX)
+    {
+        fprintf(stderr, "Record too big to be indexed at position: %ld\n", ev->pos);
+        return -1;
+    }
+
+    if (idx->n == idx->alloc)
+    {
+        if ( ( entries = (asn1idxentry *)realloc(idx->entries, (size_t)(idx->alloc * 2 + 1024) * sizeof(asn1idxentry)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the index\n");
+            return -1;
+        }
+        idx->entries = entries;
+        idx->alloc = idx->alloc * 2 + 1024;
+    }
+
+    e = &idx->entries[idx->n++];
+    e->pos = ev->pos;
+    e->size = (unsigned int)size;
+    e->recno = ev->recno;
+    e->tag = (unsigned int)ev->item->tag;
+    e->depth = (unsigned short)ev->depth;
+    e->reserved = 0;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: index_save
+|*
+|* Description;
+|*
+|*     Writes the index of filename to filename.idx. It is written aside
+|*     and renamed, so that a reader never finds half an index.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error writing the index
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int index_save(const asn1index *idx, const char *filename)
+{
+    asn1idxhead     head;
+    struct stat     st;
+    char*           name = NULL;
+    char*           tmp = NULL;
+    FILE*           fp = NULL;
+    int             rc = 0;
+
+    /* 1. Header: identifies the file indexed */
+
+    if (stat(filename, &st) != 0)
+    {
+        fprintf(stderr, "Cannot open file: %s\n", strerror(errno));
+        return -1;
+    }
+
+    memset(&head, 0x00, sizeof(head));
+    memcpy(head.magic, INDEX_MAGIC, sizeof(head.magic));
+    head.version = INDEX_VERSION;
+    head.file_size = (long long)st.st_size;
+    head.file_mtime = (long long)st.st_mtime;
+    head.count = idx->n;
+
+
+    /* 2. Header and entries to <file>.idx.tmp, then renamed */
+
+    if ( ( name = index_name(filename, INDEX_SUFFIX) ) == NULL ||
+            ( tmp = index_name(name, ".tmp") ) == NULL )
+    {
+        free(name);
+        return -1;
+    }
+
+    if ( ( fp = fopen(tmp, "wb") ) == NULL )
+    {
+        fprintf(stderr, "Cannot write the index %s: %s\n", tmp, strerror(errno));
+        rc = -1;
+    }
+    else
+    {
+        if (fwrite(&head, sizeof(head), 1, fp) != 1 ||
+                (idx->n > 0 && fwrite(idx->entries, sizeof(asn1idxentry), (size_t)idx->n, fp) != (size_t)idx->n))
+            rc = -1;
+
+        if (fclose(fp) != 0)
+            rc = -1;
+
+        if (rc == 0 && rename(tmp, name) != 0)
+            rc = -1;
+
+        if (rc != 0)
+        {
+            fprintf(stderr, "Cannot write the index %s: %s\n", name, strerror(errno));
+            (void)unlink(tmp);
+        }
+    }
+
+    free(name);
+    free(tmp);
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: index_load
+|*
+|* Description;
+|*
+|*     Maps the index of filename, if there is one and it still matches
+|*     the file
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No index, or not valid for the file
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int index_load(asn1index *idx, const char *filename)
+{
+    const asn1idxhead* head = NULL;
+    struct stat     st;
+    struct stat     ist;
+    char*           name = NULL;
+    void*           map = NULL;
+    int             fd = -1;
+
+    memset(idx, 0x00, sizeof(*idx));
+
+    if (stat(filename, &st) != 0 || ( name = index_name(filename, INDEX_SUFFIX) ) == NULL)
+        return -1;
+
+    fd = open(name, O_RDONLY);
+    free(name);
+
+    if (fd == -1)
+        return -1;
+
+    /* 1. Map it */
+
+    if (fstat(fd, &ist) != 0 || ist.st_size < (off_t)sizeof(asn1idxhead) ||
+            ( map = mmap(NULL, (size_t)ist.st_size, PROT_READ, MAP_PRIVATE, fd, 0) ) == MAP_FAILED)
+    {
+        (void)close(fd);
+        return -1;
+    }
+
+    (void)close(fd);
+
+
+    /* 2. Same layout and same file */
+
+    head = (const asn1idxhead *)map;
+
+    if (memcmp(head->magic, INDEX_MAGIC, sizeof(head->magic)) != 0 ||
+            head->version != INDEX_VERSION ||
+            head->file_size != (long long)st.st_size ||
+            head->file_mtime != (long long)st.st_mtime ||
+            head->count < 0 ||
+            (long long)ist.st_size != (long long)sizeof(asn1idxhead) + head->count * (long long)sizeof(asn1idxentry))
+    {
+        (void)munmap(map, (size_t)ist.st_size);
+        return -1;
+    }
+
+    idx->map = map;
+    idx->map_len = (long)ist.st_size;
+    idx->entries = (asn1idxentry *)((char *)map + sizeof(asn1idxhead));
+    idx->n = (long)head->count;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: index_close
+|*
+|* Description;
+|*
+|*     Releases the entries of the index or its mapping
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void index_close(asn1index *idx)
+{
+    if (idx->map != NULL)
+        (void)munmap(idx->map, (size_t)idx->map_len);
+    else
+        free(idx->entries);
+
+    memset(idx, 0x00, sizeof(*idx));
+}
+
+
+/****************************************************************************
+|*
+|* Function: index_find
+|*
+|* Description;
+|*
+|*     Looks up the first record numbered recno or after it. The records
+|*     of TAP, RAP and NRT files are numbered in the order of the file,
+|*     so the index is searched by halves.
+|*
+|* Return:
+|*      Entry of the record. idx->n if there is none.
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+long index_find(const asn1index *idx, int recno)
+{
+    long        lo = 0;
+    long        hi = idx->n;
+    long        mid = 0;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (idx->entries[mid].recno < recno)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+
+/****************************************************************************
+|*
+|* Function: index_decode
+|*
+|* Description;
+|*
+|*     Decodes the records numbered from first to last, moving straight to
+|*     each of them. They are returned to the handler as in the dump of
+|*     the whole file.
+|*
+|* Return:
+|*      Number of records decoded
+|*     -1: Error decoding
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int index_decode(asn1index *idx, asn1ctx *ctx, int first, int last, const asn1handler *handler, void *user)
+{
+    const asn1idxentry* e = NULL;
+    long            i = 0;
+    int             n = 0;
+    int             rc = 0;
+
+    for (i = index_find(idx, first); i < idx->n && idx->entries[i].recno <= last; i++)
+    {
+        e = &idx->entries[i];
+
+        if (e->pos + e->size > ctx->in.len)
+        {
+            fprintf(stderr, "Record %d out of the file. Index not valid\n", e->recno);
+            return -1;
+        }
+
+        if (asn1_range(ctx, (long)e->pos, (long)e->size, e->depth, e->recno) != 0)
+            return -1;
+
+        ctx->frames[0].is_root = TRUE; /* In the list of records */
+
+        if ( ( rc = asn1_decode(ctx, handler, user) ) != 0 )
+            return (rc == ASN1_STOP ? n : -1);
+
+        n++;
+    }
+
+    return n;
+}
+
+
+/****************************************************************************
+|*
+|* Function: index_name
+|*
+|* Description;
+|*
+|*     Name of the file with suffix appended
+|*
+|* Return:
+|*      Allocated name
+|*      NULL: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static char *index_name(const char *filename, const char *suffix)
+{
+    char*       name = NULL;
+
+    if ( ( name = (char *)malloc(strlen(filename) + strlen(suffix) + 1) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the name of the index\n");
+        return NULL;
+    }
+
+    strcpy(name, filename);
+    strcat(name, suffix);
+
+    return name;
+}
+
+/* EOF */
@@ -0,0 +1,627 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: input.c
+|*
+|* Description: Input layer of the decoder. Regular files are mapped in
+|*              memory and walked with a position cursor, so the values
+|*              can be referenced in place. Pipes and stdin are read into
+|*              a ring buffer which keeps a few bytes behind the cursor
+|*              to allow the recovery of trash bytes. Whatever else is
+|*              read through stdio.
+|*              Compressed files and pipes are streamed: the ring is
+|*              filled by the decompressor (decompress.c) instead of
+|*              read().
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Streaming input (pipes and stdin)
+|* 20261016                     Views of mapped inputs
+|* 20261016                     Compressed inputs
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static long     input_fill      (asn1input *in);
+static int      input_stream    (asn1input *in, int fd);
+
+
+/****************************************************************************
+|*
+|* Function: input_open
+|*
+|* Description;
+|*
+|*     Opens the input. Regular files are mapped in memory, pipes are
+|*     streamed, otherwise we fall back to stdio. "-" stands for stdin.
+|*     Compressed files and pipes are streamed through the decompressor.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error opening the input
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int input_open(asn1input *in, const char *filename)
+{
+    struct stat     st;
+    int             fd = -1;
+    void*           map = NULL;
+    int             kind = COMP_NONE;
+
+    memset(in, 0x00, sizeof(*in));
+
+    /* 1. Try to map the file */
+
+    if (strcmp(filename, "-") == 0)
+    {
+        fd = STDIN_FILENO;
+    }
+    else if ( ( fd = open(filename, O_RDONLY) ) == -1 )
+    {
+        fprintf(stderr, "Cannot open file: %s\n", strerror(errno));
+        return -1;
+    }
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            (void)madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            (void)close(fd);
+
+            /* 1.1. Compressed: streamed from the mapping */
+
+            if ( ( kind = decompress_detect((const uchar *)map, (long)st.st_size) ) != COMP_NONE )
+            {
+                if (input_stream(in, -1) != 0 ||
+                        decompress_open(in, kind, (const uchar *)map, -1, NULL, (long)st.st_size) != 0)
+                {
+                    (void)munmap(map, (size_t)st.st_size);
+                    free(in->ring);
+                    memset(in, 0x00, sizeof(*in));
+                    return -1;
+                }
+                return 0;
+            }
+
+            in->mode = IN_MMAP;
+            in->map = (const uchar *)map;
+            in->len = (long)st.st_size;
+            return 0;
+        }
+    }
+
+
+    /* 2. Stream whatever cannot be seeked */
+
+    if (lseek(fd, 0, SEEK_CUR) == -1 && errno == ESPIPE)
+    {
+        if (input_stream(in, fd) != 0)
+        {
+            (void)close(fd);
+            return -1;
+        }
+
+        /* 2.1. Compressed: the bytes read so far go to the decompressor */
+
+        while (in->head < 4 && input_fill(in) > 0)
+            ;
+
+        if ( ( kind = decompress_detect(in->ring, in->head) ) != COMP_NONE )
+        {
+            if (decompress_open(in, kind, NULL, fd, in->ring, in->head) != 0)
+            {
+                input_close(in);
+                return -1;
+            }
+            in->head = 0;
+            in->eof = FALSE;
+        }
+
+        return 0;
+    }
+
+
+    /* 3. Fall back to stdio */
+
+    if ( ( in->file = fdopen(fd, "rb") ) == NULL )
+    {
+        fprintf(stderr, "Cannot open file: %s\n", strerror(errno));
+        (void)close(fd);
+        return -1;
+    }
+    in->mode = IN_STDIO;
+
+    if (fseek(in->file, 0, SEEK_END) != 0) // seek to end of file
+    {
+        fprintf(stderr, "Error moving to the end of the file: %s\n", strerror(errno));
+        return -1;
+    }
+    in->len = ftell(in->file); // get current file pointer
+    if (fseek(in->file, 0, SEEK_SET) != 0) // seek back to beginning of file
+    {
+        fprintf(stderr, "Error moving to the beginning of the file: %s\n", strerror(errno));
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_close
+|*
+|* Description;
+|*
+|*     Releases the mapping, the file handler and the read buffer
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void input_close(asn1input *in)
+{
+    if (in->is_view)
+    {
+        memset(in, 0x00, sizeof(*in));
+        return;
+    }
+
+    if (in->map)
+        (void)munmap((void *)in->map, (size_t)in->len);
+
+    if (in->file)
+        (void)fclose(in->file);
+
+    if (in->decomp)
+        decompress_close(in);
+
+    if (in->mode == IN_STREAM)
+    {
+        if (in->fd != -1)
+            (void)close(in->fd);
+        free(in->ring);
+    }
+
+    if (in->buff)
+        free(in->buff);
+
+    memset(in, 0x00, sizeof(*in));
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_view
+|*
+|* Description;
+|*
+|*     Opens a second cursor over a mapped input, for another thread.
+|*     Nothing is released when the view is closed: it must be closed
+|*     before the input it comes from.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: The input is not mapped
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int input_view(asn1input *view, const asn1input *in)
+{
+    if (in->mode != IN_MMAP)
+    {
+        fprintf(stderr, "Only mapped files can be shared\n");
+        return -1;
+    }
+
+    *view = *in;
+    view->pos = 0;
+    view->is_view = TRUE;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_peek
+|*
+|* Description;
+|*
+|*     Copies the next bytes of the input without moving the cursor
+|*
+|* Return:
+|*      Number of bytes copied. 0 if nothing could be read.
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+long input_peek(asn1input *in, uchar *str, long len)
+{
+    long        got = 0;
+
+    if (in->mode == IN_MMAP)
+    {
+        got = len < in->len - in->pos ? len : in->len - in->pos;
+        memcpy(str, in->map + in->pos, (size_t)got);
+        return got;
+    }
+
+    if (in->mode == IN_STREAM)
+    {
+        while (in->head - in->pos < len && input_fill(in) > 0)
+            ;
+
+        for (got = 0; got < len && in->pos + got < in->head; got++)
+            str[got] = in->ring[(in->pos + got) & (INPUT_RING_SIZE - 1)];
+
+        return got;
+    }
+
+    got = (long)fread(str, sizeof(uchar), (size_t)len, in->file);
+    if (fseek(in->file, in->pos, SEEK_SET) != 0)
+        return 0;
+
+    return got;
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_read
+|*
+|* Description;
+|*
+|*     Gets the next len bytes of the input. Mapped files return a pointer
+|*     to the bytes in place, otherwise they are read into the internal
+|*     buffer, which is reused from one call to the next.
+|*     Streams are copied from the ring, refilling it as many times as
+|*     needed: values can be larger than the ring.
+|*
+|* Return:
+|*      Pointer to the bytes
+|*      NULL: End of file found too soon or no memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+const uchar *input_read(asn1input *in, long len)
+{
+    const uchar*    str = NULL;
+    uchar*          buff_tmp = NULL;
+    long            got = 0, n = 0, off = 0;
+
+    if (in->mode == IN_MMAP)
+    {
+        if (len > in->len - in->pos)
+            return NULL;
+
+        str = in->map + in->pos;
+        in->pos += len;
+        return str;
+    }
+
+    if (len > in->buff_len || in->buff == NULL)
+    {
+        if ( ( buff_tmp = (uchar *)realloc(in->buff, (size_t)len + 1 * sizeof(uchar)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory. Size too long at pos: %ld\n", in->pos);
+            return NULL;
+        }
+        in->buff = buff_tmp;
+        in->buff_len = len;
+    }
+
+    if (in->mode == IN_STREAM)
+    {
+        for (got = 0; got < len; got += n)
+        {
+            if (in->pos >= in->head && input_fill(in) <= 0)
+                return NULL;
+
+            off = in->pos & (INPUT_RING_SIZE - 1);
+            n = in->head - in->pos;
+            if (n > INPUT_RING_SIZE - off)
+                n = INPUT_RING_SIZE - off;
+            if (n > len - got)
+                n = len - got;
+
+            memcpy(in->buff + got, in->ring + off, (size_t)n);
+            in->pos += n;
+        }
+
+        return in->buff;
+    }
+
+    if ((long)fread(in->buff, sizeof(uchar), (size_t)len, in->file) != len)
+        return NULL;
+
+    in->pos += len;
+
+    return in->buff;
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_seek
+|*
+|* Description;
+|*
+|*     Moves the cursor to an absolute position of the input. Streams
+|*     can only go back as far as the bytes kept in the ring, and go
+|*     forward by reading.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error moving
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int input_seek(asn1input *in, long pos)
+{
+    if (in->mode == IN_MMAP)
+    {
+        if (pos < 0 || pos > in->len)
+        {
+            errno = EINVAL;
+            return -1;
+        }
+        in->pos = pos;
+        return 0;
+    }
+
+    if (in->mode == IN_STREAM)
+    {
+        if (pos < 0 || pos < in->head - INPUT_RING_SIZE)
+        {
+            errno = ESPIPE;
+            return -1;
+        }
+
+        while (pos > in->head)
+        {
+            in->pos = in->head;
+            if (input_fill(in) <= 0)
+            {
+                errno = EIO;
+                return -1;
+            }
+        }
+
+        in->pos = pos;
+        return 0;
+    }
+
+    if (fseek(in->file, pos, SEEK_SET) != 0)
+        return -1;
+
+    in->pos = pos;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_eof
+|*
+|* Description;
+|*
+|*     Checks if the cursor is at the end of the input. Used for inputs of
+|*     unknown size.
+|*
+|* Return:
+|*      0: There are still bytes to read
+|*      1: End of input
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int input_eof(asn1input *in)
+{
+    int         c;
+
+    if (in->mode == IN_MMAP)
+        return in->pos >= in->len;
+
+    if (in->mode == IN_STREAM)
+        return in->pos >= in->head && input_fill(in) <= 0;
+
+    if ( ( c = getc(in->file) ) == EOF )
+        return TRUE;
+
+    (void)ungetc(c, in->file);
+
+    return FALSE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_fill_getc
+|*
+|* Description;
+|*
+|*     Slow path of input_getc() for streams: refills the ring and returns
+|*     the next byte
+|*
+|* Return:
+|*      Next byte or EOF
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int input_fill_getc(asn1input *in)
+{
+    while (in->pos >= in->head)
+    {
+        if (input_fill(in) <= 0)
+            return EOF;
+    }
+
+    return (int)in->ring[in->pos++ & (INPUT_RING_SIZE - 1)];
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_fill
+|*
+|* Description;
+|*
+|*     Reads from the stream into the free part of the ring. The last
+|*     INPUT_LOOKBACK bytes before the cursor are never overwritten. We
+|*     take whatever read() gives us, so decoding starts as soon as bytes
+|*     arrive. Compressed streams are read through the decompressor.
+|*
+|* Return:
+|*     >0: Number of bytes read
+|*      0: End of stream
+|*     -1: Error reading
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long input_fill(asn1input *in)
+{
+    long        low = 0, room = 0, off = 0;
+    ssize_t     got = 0;
+
+    if (in->eof)
+        return 0;
+
+    /* 1. Room left without overwriting the lookback */
+
+    low = in->pos - INPUT_LOOKBACK;
+    if (low < 0)
+        low = 0;
+
+    room = INPUT_RING_SIZE - (in->head - low);
+    off = in->head & (INPUT_RING_SIZE - 1);
+    if (room > INPUT_RING_SIZE - off)
+        room = INPUT_RING_SIZE - off;
+
+    if (room <= 0)
+        return 0;
+
+
+    /* 2. Read */
+
+    if (in->decomp)
+    {
+        got = (ssize_t)decompress_read(in, in->ring + off, room);
+    }
+    else
+    {
+        do
+        {
+            got = read(in->fd, in->ring + off, (size_t)room);
+        }
+        while (got == -1 && errno == EINTR);
+
+        if (got == -1)
+            fprintf(stderr, "Error reading input: %s\n", strerror(errno));
+    }
+
+    if (got == -1)
+    {
+        in->eof = TRUE;
+        return -1;
+    }
+
+    if (got == 0)
+    {
+        in->eof = TRUE;
+        return 0;
+    }
+
+    in->head += got;
+
+    return (long)got;
+}
+
+
+/****************************************************************************
+|*
+|* Function: input_stream
+|*
+|* Description;
+|*
+|*     Sets the input up to be streamed from fd through the ring
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int input_stream(asn1input *in, int fd)
+{
+    if ( ( in->ring = (uchar *)malloc(INPUT_RING_SIZE * sizeof(uchar)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the input buffer\n");
+        return -1;
+    }
+
+    in->mode = IN_STREAM;
+    in->fd = fd;
+    in->len = -1;
+
+    return 0;
+}
+
+/* EOF */
@@ -0,0 +1,608 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: json.c
+|*
+|* Description: NDJSON output: one JSON object per line for each root
+|*              record, and for each element outside the records which is
+|*              not the list of records nor the element around the file:
+|*
+|*              {"recno":1,"pos":145,"MobileOriginatedCall":{...}}
+|*
+|*              Constructed elements are objects keyed by the tag names
+|*              (or numbers). Children with the same class and tag are
+|*              gathered in an array. The children of a list (SEQUENCE OF
+|*              or SET OF of the schema, or element named "...List" as in
+|*              TAP, NRT and RAP, see asn1event.is_seqof) are always in an
+|*              array, even alone, so that a list has the same shape in
+|*              all the records. Primitives are
+|*              {"int":n,"text":"t","hex":"h"}, as in the dump: int up to
+|*              8 bytes, text if printable.
+|*              With --typed, "typed":"v" comes before "hex".
+|*
+|*              Each record is kept in memory as a tree until its end,
+|*              then written in one go.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Typed values (--typed)
+|* 20261016                     Siblings gathered by class and tag
+|* 20261016                     Children of the lists always in arrays
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static int      json_start_cons (void *user, const asn1event *ev);
+static int      json_primitive  (void *user, const asn1event *ev);
+static int      json_end_cons   (void *user, const asn1event *ev);
+static int      json_add        (asn1printer *pr, const asn1event *ev);
+static void     json_value      (asn1output *out, const uchar *value, long len, const char *typed, long typed_len);
+static void     json_string     (asn1output *out, const char *str, long len);
+static void     json_key        (asn1printer *pr, const jsonnode *node);
+static int      json_is_array   (const jsonunit *u, const jsonnode *head);
+static void     json_write      (asn1printer *pr);
+
+
+/* 3. Global Variables */
+
+const asn1handler json_handler =                /* Callbacks writing NDJSON */
+{
+    json_start_cons,
+    json_primitive,
+    json_end_cons,
+    print_error,
+    NULL
+};
+
+
+/****************************************************************************
+|*
+|* Function: json_start_cons
+|*
+|* Description;
+|*
+|*     Starts a record or adds a constructed element to the current one.
+|*     The element around the file and the lists of records are left out.
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int json_start_cons(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+
+    if ((pr->json == NULL || pr->json->cur == -1) &&
+            (ev->is_list || (ev->depth == 0 && !ev->is_record)))
+        return ASN1_CONTINUE;
+
+    if (json_add(pr, ev) != 0)
+        return ASN1_STOP;
+
+    pr->json->cur = pr->json->n - 1;
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_primitive
+|*
+|* Description;
+|*
+|*     Adds a primitive element to the current record. Alone, it is a
+|*     record of its own.
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int json_primitive(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+    jsonunit*       u = NULL;
+    char            typed[TYPED_MAX_LEN];
+    long            n = 0;
+
+    if (ev->is_eoe)
+        return ASN1_CONTINUE;
+
+    if (json_add(pr, ev) != 0)
+        return ASN1_STOP;
+
+    if (pr->typed != NULL)
+        n = typed_value(pr->typed, ev, typed);
+
+    u = pr->json;
+    u->nodes[u->n - 1].val = u->vals.len;
+    json_value(&u->vals, ev->value, ev->item->size, typed, n);
+    u->nodes[u->n - 1].vlen = u->vals.len - u->nodes[u->n - 1].val;
+
+    if (u->cur == -1)
+        json_write(pr);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_end_cons
+|*
+|* Description;
+|*
+|*     Closes a constructed element. The record is written at its end.
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int json_end_cons(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+    jsonunit*       u = pr->json;
+
+    (void)ev;
+
+    if (u == NULL || u->cur == -1)
+        return ASN1_CONTINUE;
+
+    if ( ( u->cur = u->nodes[u->cur].parent ) == -1 )
+        json_write(pr);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_add
+|*
+|* Description;
+|*
+|*     Adds the element of ev to the record, as the last child of the
+|*     constructed element open. Its first sibling with the same class
+|*     and tag, if any, gets it in its list.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Siblings gathered by class and tag
+|*
+****************************************************************************/
+static int json_add(asn1printer *pr, const asn1event *ev)
+{
+    jsonunit*       u = pr->json;
+    jsonnode*       nodes = NULL;
+    jsonnode*       node = NULL;
+    jsonnode*       parent = NULL;
+    int             i = 0;
+
+    /* 1. First record of the printer */
+
+    if (u == NULL)
+    {
+        if ( ( u = (jsonunit *)calloc(1, sizeof(jsonunit)) ) == NULL ||
+                output_init(&u->vals, -1, OUTPUT_MIN_SIZE * 16) != 0 )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the JSON records\n");
+            free(u);
+            return -1;
+        }
+        u->cur = -1;
+        pr->json = u;
+    }
+
+    if (u->n == u->alloc)
+    {
+        if ( ( nodes = (jsonnode *)realloc(u->nodes, (size_t)(u->alloc * 2 + 64) * sizeof(jsonnode)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the JSON records\n");
+            return -1;
+        }
+        u->nodes = nodes;
+        u->alloc = u->alloc * 2 + 64;
+    }
+
+
+    /* 2. New record */
+
+    if (u->cur == -1)
+    {
+        u->n = 0;
+        u->vals.len = 0;
+        u->pos = ev->pos;
+        u->recno = ev->recno;
+    }
+
+    node = &u->nodes[u->n];
+    memset(node, 0x00, sizeof(*node));
+    node->tag = ev->item->tag;
+    node->class = ev->item->class;
+    node->name = ev->name;
+    node->is_cons = (ev->item->pc == 1);
+    node->is_seqof = ev->is_seqof;
+    node->parent = u->cur;
+    node->first = node->next = node->next_same = -1;
+    node->head = node->last_same = u->n;
+
+
+    /* 3. Child: after the last one with its class and tag, or after the last one */
+
+    if (u->cur != -1)
+    {
+        parent = &u->nodes[u->cur];
+
+        for (i = parent->first; i != -1 && (u->nodes[i].tag != node->tag || u->nodes[i].class != node->class); i = u->nodes[i].next)
+            ;
+
+        if (i != -1)
+        {
+            node->head = i;
+            u->nodes[u->nodes[i].last_same].next_same = u->n;
+            u->nodes[i].last_same = u->n;
+        }
+        else if (parent->first == -1)
+        {
+            parent->first = parent->last = u->n;
+        }
+        else
+        {
+            u->nodes[parent->last].next = u->n;
+            parent->last = u->n;
+        }
+    }
+
+    u->n++;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_write
+|*
+|* Description;
+|*
+|*     Writes the record as one line. The tree is walked without
+|*     recursion: each node is written when entered, and the node after
+|*     it is its next one with the same tag, else the next tag of its
+|*     parent, else the end of its parent.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Children of the lists always in arrays
+|*
+****************************************************************************/
+static void json_write(asn1printer *pr)
+{
+    jsonunit*       u = pr->json;
+    asn1output*     out = pr->out;
+    const jsonnode* nodes = u->nodes;
+    const jsonnode* node = NULL;
+    int             i = 0;
+    int             is_entering = TRUE;
+
+    /* 1. Record number, position and file */
+
+    output_puts(out, "{\"recno\":");
+    output_dec(out, u->recno);
+    output_puts(out, ",\"pos\":");
+    output_dec(out, u->pos);
+
+    if (pr->shared != NULL && pr->name != NULL)
+    {
+        output_puts(out, ",\"file\":");
+        json_string(out, pr->name, (long)strlen(pr->name));
+    }
+
+    output_putc(out, ',');
+    json_key(pr, &nodes[0]);
+
+
+    /* 2. The elements */
+
+    for (;;)
+    {
+        node = &nodes[i];
+
+        /* 2.1. Entering: its value */
+
+        if (is_entering)
+        {
+            if (!node->is_cons)
+            {
+                output_write(out, u->vals.buff + node->val, node->vlen);
+            }
+            else if (node->first == -1)
+            {
+                output_puts(out, "{}");
+            }
+            else
+            {
+                output_putc(out, '{');
+                i = node->first;
+                json_key(pr, &nodes[i]);
+                continue;
+            }
+
+            is_entering = FALSE;
+        }
+
+        /* 2.2. Done: what comes after it */
+
+        if (i == 0)
+            break;
+
+        if (node->next_same != -1)
+        {
+            output_putc(out, ',');
+            i = node->next_same;
+            is_entering = TRUE;
+            continue;
+        }
+
+        if (json_is_array(u, &nodes[node->head]))
+            output_putc(out, ']');
+
+        if (nodes[node->head].next != -1)
+        {
+            output_putc(out, ',');
+            i = nodes[node->head].next;
+            json_key(pr, &nodes[i]);
+            is_entering = TRUE;
+            continue;
+        }
+
+        output_putc(out, '}');
+        i = node->parent;
+    }
+
+    output_putc(out, '}');
+    print_eol(pr);
+
+    u->cur = -1;
+    u->n = 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_key
+|*
+|* Description;
+|*
+|*     Writes "name": of the first node with a tag, and the [ of the
+|*     array if there are more with it or its parent is a list
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Children of the lists always in arrays
+|*
+****************************************************************************/
+static void json_key(asn1printer *pr, const jsonnode *node)
+{
+    asn1output*     out = pr->out;
+
+    output_putc(out, '"');
+
+    if (pr->use_tagnames && node->name != NULL)
+        output_puts(out, node->name);
+    else
+        output_dec(out, node->tag);
+
+    output_puts(out, (json_is_array(pr->json, node) ? "\":[" : "\":"));
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_is_array
+|*
+|* Description;
+|*
+|*     Tells if the siblings with the class and tag of head (the first
+|*     of them) are written as an array: there are several, or they are
+|*     in a list
+|*
+|* Return:
+|*      TRUE or FALSE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int json_is_array(const jsonunit *u, const jsonnode *head)
+{
+    return (head->next_same != -1 || (head->parent != -1 && u->nodes[head->parent].is_seqof));
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_value
+|*
+|* Description;
+|*
+|*     Writes a primitive value as {"int":n,"text":"t","hex":"h"}: int
+|*     for up to 8 bytes and text if printable, as in the dump. The typed
+|*     value, if any (typed_len > 0), goes before hex.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Typed value
+|* 20261016    Number added up unsigned: no signed overflow
+|*
+****************************************************************************/
+static void json_value(asn1output *out, const uchar *value, long len, const char *typed, long typed_len)
+{
+    unsigned long long sum_up = 0;
+    long            i = 0;
+    int             flags = 0;
+
+    output_putc(out, '{');
+
+    if ((size_t)len <= sizeof(sum_up))
+    {
+        for (i = 0; i < len; i++)
+            sum_up = sum_up << 8 | value[i];
+
+        output_puts(out, "\"int\":");
+        output_dec(out, (long long)sum_up);
+        output_putc(out, ',');
+    }
+
+    flags = hexa_encode_check(NULL, value, len);
+
+    if (len > 0 && hexa_printable(flags, len))
+    {
+        output_puts(out, "\"text\":");
+        json_string(out, (const char *)value, len);
+        output_putc(out, ',');
+    }
+
+    if (typed_len > 0)
+    {
+        output_puts(out, "\"typed\":");
+        json_string(out, typed, typed_len);
+        output_putc(out, ',');
+    }
+
+    output_puts(out, "\"hex\":\"");
+    output_hexa(out, value, len);
+    output_puts(out, "\"}");
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_string
+|*
+|* Description;
+|*
+|*     Writes a string between quotes, escaping what JSON needs. Printable
+|*     values only have quotes, backslashes and End of Lines to escape.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void json_string(asn1output *out, const char *str, long len)
+{
+    long            i = 0;
+    long            from = 0;
+    char            esc[8];
+
+    output_putc(out, '"');
+
+    for (i = 0; i < len; i++)
+    {
+        if (str[i] != '"' && str[i] != '\\' && (unsigned char)str[i] >= 0x20)
+            continue;
+
+        output_write(out, str + from, i - from);
+        from = i + 1;
+
+        if (str[i] == '\n')
+            output_puts(out, "\\n");
+        else if (str[i] == '"' || str[i] == '\\')
+        {
+            output_putc(out, '\\');
+            output_putc(out, str[i]);
+        }
+        else
+        {
+            snprintf(esc, sizeof(esc), "\\u%04x", (unsigned char)str[i]);
+            output_puts(out, esc);
+        }
+    }
+
+    output_write(out, str + from, len - from);
+    output_putc(out, '"');
+}
+
+
+/****************************************************************************
+|*
+|* Function: json_close
+|*
+|* Description;
+|*
+|*     Releases the record kept by the printer
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void json_close(asn1printer *pr)
+{
+    if (pr->json == NULL)
+        return;
+
+    (void)output_close(&pr->json->vals);
+    free(pr->json->nodes);
+    free(pr->json);
+    pr->json = NULL;
+}
+
+/* EOF */
@@ -0,0 +1,535 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: output.c
+|*
+|* Description: Output layer of the dump. Everything is formatted by hand
+|*              into a large buffer which is written with write() when it
+|*              gets full. Values which do not fit in the buffer are
+|*              written together with it with writev(). Outputs to
+|*              memory (fd -1) grow instead of being written.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Output to memory
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Global Variables */
+
+static const char indent_str[] =                /* 32 levels of indentation */
+    "                                                                "
+    "                                                                ";
+
+
+/* 3. Prototypes */
+
+static int      write_all       (int fd, struct iovec *iov, int iovcnt);
+static int      output_grow     (asn1output *out, long len);
+
+
+/****************************************************************************
+|*
+|* Function: output_init
+|*
+|* Description;
+|*
+|*     Allocates the buffer of the output. Terminals are flushed at every
+|*     end of line, so that errors appear after the lines they refer to.
+|*     With fd -1 the output is kept in memory, in buff.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int output_init(asn1output *out, int fd, long size)
+{
+    memset(out, 0x00, sizeof(*out));
+
+    if (size < OUTPUT_MIN_SIZE)
+        size = OUTPUT_MIN_SIZE;
+
+    if ( ( out->buff = (char *)malloc((size_t)size) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the output buffer\n");
+        return -1;
+    }
+
+    out->fd = fd;
+    out->size = size;
+    out->is_tty = (fd >= 0 && isatty(fd));
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_close
+|*
+|* Description;
+|*
+|*     Flushes and releases the buffer
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error writing
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int output_close(asn1output *out)
+{
+    int         rc = 0;
+
+    if (out->buff == NULL)
+        return 0;
+
+    if (out->fd >= 0)
+        rc = output_flush(out);
+
+    free(out->buff);
+    out->buff = NULL;
+
+    return rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_flush
+|*
+|* Description;
+|*
+|*     Writes the content of the buffer. Outputs to memory get more room
+|*     instead.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error writing
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int output_flush(asn1output *out)
+{
+    struct iovec    iov;
+
+    if (out->fd < 0)
+    {
+        if (output_grow(out, out->size) == 0)
+            return 0;
+
+        out->len = 0; /* As if it had been written: we can't keep it */
+        return -1;
+    }
+
+    if (out->len == 0)
+        return 0;
+
+    iov.iov_base = out->buff;
+    iov.iov_len = (size_t)out->len;
+    out->len = 0;
+
+    return write_all(out->fd, &iov, 1);
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_write
+|*
+|* Description;
+|*
+|*     Appends a string to the buffer. If it does not fit, the buffer and
+|*     the string are written at once.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void output_write(asn1output *out, const char *str, long len)
+{
+    struct iovec    iov[2];
+
+    if (len <= out->size - out->len)
+    {
+        memcpy(out->buff + out->len, str, (size_t)len);
+        out->len += len;
+        return;
+    }
+
+    if (out->fd < 0)
+    {
+        if (output_grow(out, len) == 0)
+            output_write(out, str, len);
+        return;
+    }
+
+    iov[0].iov_base = out->buff;
+    iov[0].iov_len = (size_t)out->len;
+    iov[1].iov_base = (void *)str;
+    iov[1].iov_len = (size_t)len;
+    out->len = 0;
+
+    (void)write_all(out->fd, iov, 2);
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_printf
+|*
+|* Description;
+|*
+|*     Formats with printf format. Only for lines out of the decoding loop.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void output_printf(asn1output *out, const char *format, ...)
+{
+    va_list     args;
+    char        line[1024];
+    int         len = 0;
+
+    va_start(args, format);
+    len = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (len < 0)
+        return;
+
+    output_write(out, line, len < (int)sizeof(line) ? len : (int)sizeof(line) - 1);
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_indent
+|*
+|* Description;
+|*
+|*     Writes 4 spaces per level of depth
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void output_indent(asn1output *out, int depth)
+{
+    long        len = (long)depth * 4, n = 0;
+
+    for (; len > 0; len -= n)
+    {
+        n = len < (long)sizeof(indent_str) - 1 ? len : (long)sizeof(indent_str) - 1;
+        output_write(out, indent_str, n);
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_zdec
+|*
+|* Description;
+|*
+|*     Writes a positive number in decimal filled with zeros up to width
+|*     (as "%0*ld")
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void output_zdec(asn1output *out, unsigned long val, int width)
+{
+    char        str[24];
+    int         i = sizeof(str);
+
+    do
+    {
+        str[--i] = (char)('0' + val % 10);
+        val /= 10;
+    }
+    while (val != 0);
+
+    while (i > (int)sizeof(str) - width && i > 0)
+        str[--i] = '0';
+
+    output_write(out, str + i, (long)sizeof(str) - i);
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_dec
+|*
+|* Description;
+|*
+|*     Writes a signed number in decimal (as "%lld")
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void output_dec(asn1output *out, long long val)
+{
+    char                str[24];
+    int                 i = sizeof(str);
+    unsigned long long  uval = val < 0 ? 0ULL - (unsigned long long)val : (unsigned long long)val;
+
+    do
+    {
+        str[--i] = (char)('0' + uval % 10);
+        uval /= 10;
+    }
+    while (uval != 0);
+
+    if (val < 0)
+        str[--i] = '-';
+
+    output_write(out, str + i, (long)sizeof(str) - i);
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_hexa
+|*
+|* Description;
+|*
+|*     Writes the bytes of a string as hexadecimal (as "%02x" per byte)
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void output_hexa(asn1output *out, const uchar *str, long len)
+{
+    long        n = 0;
+
+    while (len > 0)
+    {
+        if (out->size - out->len < 2)
+            (void)output_flush(out);
+
+        n = (out->size - out->len) / 2;
+        if (n > len)
+            n = len;
+
+        hexa_encode(out->buff + out->len, str, n);
+
+        out->len += n * 2;
+        str += n;
+        len -= n;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_text_hexa
+|*
+|* Description;
+|*
+|*     Writes a value as it is shown in the dump: "text" "hexa" if it is
+|*     printable, "" "hexa" otherwise. The value is scanned once: the
+|*     hexadecimal string is written in place supposing the value is
+|*     printable, and moved back if it is not.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void output_text_hexa(asn1output *out, const uchar *str, long len)
+{
+    char*       dst = NULL;
+    int         printable = FALSE;
+
+    /* 1. Too long for the buffer: check and convert separately */
+
+    if (len * 3 + 5 > out->size - out->len)
+    {
+        (void)output_flush(out);
+
+        if (len * 3 + 5 > out->size)
+        {
+            printable = hexa_printable(hexa_encode_check(NULL, str, len), len);
+
+            output_putc(out, '"');
+            if (printable)
+                output_write(out, (const char *)str, len);
+            output_write(out, "\" \"", 3);
+            output_hexa(out, str, len);
+            output_putc(out, '"');
+            return;
+        }
+    }
+
+
+    /* 2. Check and convert in one pass */
+
+    dst = out->buff + out->len;
+
+    printable = hexa_printable(hexa_encode_check(dst + len + 4, str, len), len);
+
+    dst[0] = '"';
+    if (printable)
+    {
+        memcpy(dst + 1, str, (size_t)len);
+        memcpy(dst + len + 1, "\" \"", 3);
+        out->len += len * 3 + 4;
+    }
+    else
+    {
+        memcpy(dst + 1, "\" \"", 3);
+        memmove(dst + 4, dst + len + 4, (size_t)len * 2);
+        out->len += len * 2 + 4;
+    }
+
+    out->buff[out->len++] = '"';
+}
+
+
+/****************************************************************************
+|*
+|* Function: output_grow
+|*
+|* Description;
+|*
+|*     Makes room for at least len more bytes in an output to memory
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int output_grow(asn1output *out, long len)
+{
+    long        size = out->size;
+    char*       buff = NULL;
+
+    while (size - out->len < len)
+        size *= 2;
+
+    if ( ( buff = (char *)realloc(out->buff, (size_t)size) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the output buffer\n");
+        return -1;
+    }
+
+    out->buff = buff;
+    out->size = size;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: write_all
+|*
+|* Description;
+|*
+|*     Writes all the buffers, retrying on partial writes
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error writing
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int write_all(int fd, struct iovec *iov, int iovcnt)
+{
+    ssize_t     got = 0;
+
+    while (iovcnt > 0)
+    {
+        if ( ( got = writev(fd, iov, iovcnt) ) == -1 )
+        {
+            if (errno == EINTR)
+                continue;
+
+            fprintf(stderr, "Error writing output: %s\n", strerror(errno));
+            return -1;
+        }
+
+        for (; iovcnt > 0 && (size_t)got >= iov->iov_len; iov++, iovcnt--)
+            got -= (ssize_t)iov->iov_len;
+
+        if (iovcnt > 0)
+        {
+            iov->iov_base = (char *)iov->iov_base + got;
+            iov->iov_len -= (size_t)got;
+        }
+    }
+
+    return 0;
+}
+
+/* EOF */
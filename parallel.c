@@ -0,0 +1,773 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: parallel.c
+|*
+|* Description: Decoding of the records of a file (the children of the
+|*              root element: CallEventDetailList in TAP files) by a pool
+|*              of threads. The main thread walks the file jumping over
+|*              the records by their length and gives them in batches to
+|*              the threads, which format them into memory. The batches
+|*              are written in the order of the records, so the output is
+|*              the same as when decoding with one thread.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     One thread with a filter of tag paths
+|* 20261016                     Type in the schema of the list of the records
+|* 20261016                     Typed values: state of the main printer per batch
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static int      pool_init       (ppool *pool, asn1ctx *ctx, const asn1handler *handler, const asn1printer *pr, int nthreads);
+static void     pool_close      (ppool *pool);
+static int      pool_add        (ppool *pool, const asn1event *ev, asn1printer *pr);
+static void     pool_queue      (ppool *pool);
+static int      pool_write      (ppool *pool, asn1printer *pr, int all);
+static void     pool_discard    (ppool *pool);
+static void*    pool_worker     (void *arg);
+static void     keep_error      (void *user, long pos, const char *msg);
+static void     keep_main_error (void *user, long pos, const char *msg);
+static void     add_error       (perrors *errs, long pos, const char *msg);
+static void     put_errors      (perrors *errs, const asn1handler *handler, void *user);
+
+
+/****************************************************************************
+|*
+|* Function: decode_parallel
+|*
+|* Description;
+|*
+|*     Decodes the rest of the file as asn1_decode() with nthreads threads.
+|*     The user of the callbacks is the printer pr, and the threads give
+|*     them printers to memory instead. Records of definite
+|*     length are decoded by the threads, anything else by this one.
+|*     Streams, and files decoded with a filter, are decoded with one
+|*     thread.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding
+|*      ASN1_STOP: Stopped by a callback
+|*
+|* Modifications:
+|* 20261016    Initial version
+|* 20261016    Header of a primitive cut short by the end of the file
+|*
+****************************************************************************/
+int decode_parallel(asn1ctx *ctx, const asn1handler *handler, asn1printer *pr, int nthreads)
+{
+    ppool           pool;
+    asn1event       ev;
+    asn1frame*      f = NULL;
+    const asn1item* item = NULL;
+    int             rc = 0;
+    int             wrc = 0;
+
+    memset(&ev, 0x00, sizeof(ev));
+
+    /* 1. Only mapped files can be shared by the threads. The filter
+          skips most of the formatting anyway */
+
+    if (nthreads <= 1 || ctx->in.mode != IN_MMAP || ctx->filter != NULL)
+        return asn1_decode(ctx, handler, pr);
+
+    if (pool_init(&pool, ctx, handler, pr, nthreads) != 0)
+        return -1;
+
+    /* Errors are kept until the records before them are written */
+    ctx->handler = &pool.main_handler;
+    ctx->user = &pool;
+
+
+    /* 2. Walk the file */
+
+    for (;;)
+    {
+        rc = asn1_next(ctx, &ev);
+        f = &ctx->frames[ctx->top];
+        item = ev.item;
+
+        /* 2.1. Record of definite length inside the file: to the threads */
+
+        if (rc == ASN1_ELEM && f->is_root && item->pc == 1 && !ev.is_eoe &&
+                !(item->size_x[0] && item->size == 0) &&
+                ev.vpos + item->size <= ctx->in.len)
+        {
+            if ( ( wrc = pool_add(&pool, &ev, pr) ) == 0 )
+            {
+                if (asn1_skip(ctx) != 0)
+                {
+                    rc = -1;
+                    break;
+                }
+                continue;
+            }
+        }
+        else
+        {
+            /* 2.2. Anything else: after the records before it */
+
+            wrc = pool_write(&pool, pr, TRUE);
+        }
+
+        /* 2.3. A record did not end where its length said: go on from its real end */
+
+        if (wrc == POOL_REWIND)
+        {
+            pool.errs.n = 0;
+
+            if (asn1_rewind(ctx, pool.top, pool.next_pos, pool.next_recno) != 0)
+            {
+                rc = -1;
+                break;
+            }
+            continue;
+        }
+
+        put_errors(&pool.errs, handler, pr);
+
+        if (wrc != 0)
+        {
+            rc = wrc;
+            break;
+        }
+
+        if (rc == ASN1_END || rc == -1)
+        {
+            if (rc == -1 && ev.is_cut && handler->cut != NULL)
+                handler->cut(pr, &ev);
+            break;
+        }
+
+
+        /* 2.4. Same as decode_asn() */
+
+        if (rc == ASN1_ELEM && (item->pc == 0 || ev.is_eoe))
+        {
+            if (handler->primitive != NULL && handler->primitive(pr, &ev) != 0)
+            {
+                rc = ASN1_STOP;
+                break;
+            }
+        }
+        else if (rc == ASN1_ELEM)
+        {
+            if (handler->start_cons != NULL && handler->start_cons(pr, &ev) != 0)
+            {
+                rc = ASN1_STOP;
+                break;
+            }
+
+            if (asn1_enter(ctx) != 0)
+            {
+                rc = -1;
+                break;
+            }
+        }
+        else
+        {
+            if (handler->end_cons != NULL && handler->end_cons(pr, &ev) != 0)
+            {
+                rc = ASN1_STOP;
+                break;
+            }
+        }
+    }
+
+    put_errors(&pool.errs, handler, pr);
+
+    pool_close(&pool);
+
+    ctx->handler = handler;
+    ctx->user = pr;
+
+    return rc == ASN1_END ? 0 : rc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: pool_init
+|*
+|* Description;
+|*
+|*     Opens a view of the file for each thread, allocates the batches and
+|*     starts the threads
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int pool_init(ppool *pool, asn1ctx *ctx, const asn1handler *handler, const asn1printer *pr, int nthreads)
+{
+    int         i = 0;
+
+    memset(pool, 0x00, sizeof(*pool));
+
+    pool->ctx = ctx;
+    pool->out_handler = handler;
+    pool->handler = *handler;
+    pool->handler.error = keep_error;
+    pool->main_handler.error = keep_main_error;
+    pool->nbatches = nthreads * PARALLEL_WINDOW;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+
+    /* 1. Memory for the threads and the batches */
+
+    if (
+            ( pool->threads = (pthread_t *)calloc((size_t)nthreads, sizeof(pthread_t)) ) == NULL ||
+            ( pool->workers = (pworker *)calloc((size_t)nthreads, sizeof(pworker)) ) == NULL ||
+            ( pool->batches = (pbatch *)calloc((size_t)pool->nbatches, sizeof(pbatch)) ) == NULL
+       )
+    {
+        fprintf(stderr, "Couldn't allocate memory for %d threads\n", nthreads);
+        pool_close(pool);
+        return -1;
+    }
+
+    for (i = 0; i < pool->nbatches; i++)
+    {
+        if (output_init(&pool->batches[i].out, -1, PARALLEL_BATCH_SIZE) != 0)
+        {
+            pool_close(pool);
+            return -1;
+        }
+
+        pool->batches[i].pr = *pr;
+        pool->batches[i].pr.out = &pool->batches[i].out;
+        pool->batches[i].pr.json = NULL;
+        pool->batches[i].pr.row = NULL;
+        pool->batches[i].pr.arrow = NULL;
+        pool->batches[i].pr.typed = (pr->typed != NULL ? &pool->batches[i].typed : NULL);
+    }
+
+
+    /* 2. Views of the file: opened here, while nobody else uses ctx */
+
+    for (pool->nworkers = 0; pool->nworkers < nthreads; pool->nworkers++)
+    {
+        pool->workers[pool->nworkers].pool = pool;
+
+        if (asn1_open_view(&pool->workers[pool->nworkers].view, ctx) != 0)
+        {
+            pool_close(pool);
+            return -1;
+        }
+    }
+
+
+    /* 3. Threads */
+
+    for (pool->nthreads = 0; pool->nthreads < nthreads; pool->nthreads++)
+    {
+        if (pthread_create(&pool->threads[pool->nthreads], NULL, pool_worker, &pool->workers[pool->nthreads]) != 0)
+        {
+            fprintf(stderr, "Couldn't start thread %d\n", pool->nthreads + 1);
+            pool_close(pool);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: pool_close
+|*
+|* Description;
+|*
+|*     Stops the threads and releases the pool. Batches not written are
+|*     lost.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void pool_close(ppool *pool)
+{
+    int         i = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = TRUE;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->nthreads; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    for (i = 0; i < pool->nworkers; i++)
+        asn1_close(&pool->workers[i].view);
+
+    if (pool->batches != NULL)
+    {
+        for (i = 0; i < pool->nbatches; i++)
+        {
+            (void)output_close(&pool->batches[i].out);
+            print_close(&pool->batches[i].pr);
+            free(pool->batches[i].recs);
+        }
+    }
+
+    free(pool->threads);
+    free(pool->workers);
+    free(pool->batches);
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->work);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+
+/****************************************************************************
+|*
+|* Function: pool_add
+|*
+|* Description;
+|*
+|*     Adds a record to the batch being filled, which is given to the
+|*     threads when it is big enough. If all the batches are in use, the
+|*     oldest one is written first.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error
+|*      POOL_REWIND: see pool_write()
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int pool_add(ppool *pool, const asn1event *ev, asn1printer *pr)
+{
+    pbatch*     b = NULL;
+    precord*    recs = NULL;
+    int         rc = 0;
+
+    /* 1. Batch to fill: free it first if still in use */
+
+    if (pool->queued - pool->written == pool->nbatches)
+    {
+        if ( ( rc = pool_write(pool, pr, FALSE) ) != 0)
+            return rc;
+    }
+
+    b = &pool->batches[pool->queued % pool->nbatches];
+
+    if (pool->queued == pool->written && b->nrecs == 0)
+        pool->top = pool->ctx->top;
+
+    /* 1.1. Typed values: what the main thread found before (TapDecimalPlaces, offsets) */
+
+    if (b->nrecs == 0 && pr->typed != NULL)
+        b->typed = *pr->typed;
+
+
+    /* 2. Add the record */
+
+    if (b->nrecs == b->arecs)
+    {
+        if ( ( recs = (precord *)realloc(b->recs, (size_t)(b->arecs + 256) * sizeof(precord)) ) == NULL )
+        {
+            fprintf(stderr, "Couldn't allocate memory for the records\n");
+            return -1;
+        }
+        b->recs = recs;
+        b->arecs += 256;
+    }
+
+    recs = &b->recs[b->nrecs++];
+    recs->pos = ev->pos;
+    recs->size = ev->vpos + ev->item->size - ev->pos;
+    recs->depth = ev->depth;
+    recs->recno = ev->recno;
+    recs->type = pool->ctx->frames[pool->ctx->top].type;
+
+    b->bytes += recs->size;
+
+
+    /* 3. Big enough: to the threads */
+
+    if (b->bytes >= PARALLEL_BATCH_SIZE)
+        pool_queue(pool);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: pool_queue
+|*
+|* Description;
+|*
+|*     Gives the batch being filled to the threads
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void pool_queue(ppool *pool)
+{
+    pbatch*     b = &pool->batches[pool->queued % pool->nbatches];
+
+    if (b->nrecs == 0 || pool->queued - pool->written == pool->nbatches)
+        return;
+
+    pthread_mutex_lock(&pool->lock);
+    b->is_done = FALSE;
+    pool->queued++;
+    pthread_cond_signal(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+
+/****************************************************************************
+|*
+|* Function: pool_write
+|*
+|* Description;
+|*
+|*     Writes the oldest batch or, with all, all of them (also the one
+|*     being filled), waiting for the threads to decode them
+|*
+|* Return:
+|*      0: Successful
+|*     -1: Error decoding a record
+|*      ASN1_STOP: Stopped by a callback
+|*      POOL_REWIND: A record did not end where its length said. The
+|*                   rest of the records are dropped and the file has
+|*                   to be decoded again from next_pos.
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int pool_write(ppool *pool, asn1printer *pr, int all)
+{
+    pbatch*     b = NULL;
+    int         rc = 0;
+
+    if (all)
+        pool_queue(pool);
+
+    while (pool->written < pool->queued)
+    {
+        b = &pool->batches[pool->written % pool->nbatches];
+
+        /* 1. Wait for the threads */
+
+        pthread_mutex_lock(&pool->lock);
+        while (!b->is_done)
+            pthread_cond_wait(&pool->done, &pool->lock);
+        pthread_mutex_unlock(&pool->lock);
+
+
+        /* 2. Write the batch and its errors */
+
+        output_write(pr->out, b->out.buff, b->out.len);
+        put_errors(&b->errs, pool->out_handler, pr);
+
+        rc = b->rc;
+        if (rc == 0 && b->next_pos >= 0)
+        {
+            pool->next_pos = b->next_pos;
+            pool->next_recno = b->next_recno;
+            rc = POOL_REWIND;
+        }
+
+        b->out.len = 0;
+        b->nrecs = 0;
+        b->bytes = 0;
+        pool->written++;
+
+        if (rc != 0)
+        {
+            pool_discard(pool);
+            return rc;
+        }
+
+        if (!all)
+            break;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: pool_discard
+|*
+|* Description;
+|*
+|*     Drops the batches not written, once the threads are done with them
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void pool_discard(ppool *pool)
+{
+    pbatch*     b = NULL;
+
+    for (; pool->written <= pool->queued; pool->written++)
+    {
+        b = &pool->batches[pool->written % pool->nbatches];
+
+        if (pool->written < pool->queued)
+        {
+            pthread_mutex_lock(&pool->lock);
+            while (!b->is_done)
+                pthread_cond_wait(&pool->done, &pool->lock);
+            pthread_mutex_unlock(&pool->lock);
+        }
+
+        b->out.len = 0;
+        b->nrecs = 0;
+        b->bytes = 0;
+        b->errs.n = 0;
+    }
+
+    pool->written = pool->queued;
+}
+
+
+/****************************************************************************
+|*
+|* Function: pool_worker
+|*
+|* Description;
+|*
+|*     Thread of the pool: decodes the batches with its view of the file
+|*
+|* Return:
+|*      NULL
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void *pool_worker(void *arg)
+{
+    pworker*    w = (pworker *)arg;
+    ppool*      pool = w->pool;
+    pbatch*     b = NULL;
+    precord*    r = NULL;
+    int         i = 0;
+
+    for (;;)
+    {
+        /* 1. Wait for a batch */
+
+        pthread_mutex_lock(&pool->lock);
+        while (pool->taken == pool->queued && !pool->quit)
+            pthread_cond_wait(&pool->work, &pool->lock);
+
+        if (pool->quit)
+        {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+
+        b = &pool->batches[pool->taken++ % pool->nbatches];
+        pthread_mutex_unlock(&pool->lock);
+
+
+        /* 2. Decode its records, each one as the only element of a range */
+
+        b->rc = 0;
+        b->next_pos = -1;
+        w->view.handler = &pool->handler;
+        w->view.user = b;
+
+        for (i = 0; i < b->nrecs && b->rc == 0; i++)
+        {
+            r = &b->recs[i];
+
+            if (asn1_range(&w->view, r->pos, r->size, r->depth, r->recno) != 0)
+            {
+                b->rc = -1;
+                break;
+            }
+
+            w->view.frames[0].is_root = TRUE; /* In the list of records */
+            w->view.frames[0].type = r->type;
+
+            b->rc = asn1_decode(&w->view, &pool->handler, b);
+
+            /* 2.1. Its children went beyond its length: the next record is not where we thought */
+
+            if (b->rc == 0 && w->view.pos != r->pos + r->size)
+            {
+                b->next_pos = w->view.pos;
+                b->next_recno = r->recno + 1;
+                break;
+            }
+        }
+
+
+        /* 3. Ready to be written */
+
+        pthread_mutex_lock(&pool->lock);
+        b->is_done = TRUE;
+        pthread_cond_broadcast(&pool->done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return NULL;
+}
+
+
+/****************************************************************************
+|*
+|* Function: keep_error
+|*
+|* Description;
+|*
+|*     Error callback of the threads: the errors are written with their
+|*     batch
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void keep_error(void *user, long pos, const char *msg)
+{
+    add_error(&((pbatch *)user)->errs, pos, msg);
+}
+
+
+/****************************************************************************
+|*
+|* Function: keep_main_error
+|*
+|* Description;
+|*
+|*     Error callback of the main thread: the errors are written after the
+|*     batches queued
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void keep_main_error(void *user, long pos, const char *msg)
+{
+    add_error(&((ppool *)user)->errs, pos, msg);
+}
+
+
+/****************************************************************************
+|*
+|* Function: add_error
+|*
+|* Description;
+|*
+|*     Keeps an error. Only the first ones: decoding stops at the first
+|*     error
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void add_error(perrors *errs, long pos, const char *msg)
+{
+    if (errs->n == PARALLEL_ERRORS)
+        return;
+
+    errs->pos[errs->n] = pos;
+    snprintf(errs->msg[errs->n], sizeof(errs->msg[0]), "%s", msg);
+    errs->n++;
+}
+
+
+/****************************************************************************
+|*
+|* Function: put_errors
+|*
+|* Description;
+|*
+|*     Passes the errors kept to the error callback of the handler
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void put_errors(perrors *errs, const asn1handler *handler, void *user)
+{
+    int         i = 0;
+
+    for (i = 0; i < errs->n; i++)
+    {
+        if (handler->error != NULL)
+            handler->error(user, errs->pos[i], errs->msg[i]);
+        else
+            fprintf(stderr, "%s\n", errs->msg[i]);
+    }
+
+    errs->n = 0;
+}
+
+/* EOF */
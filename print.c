@@ -0,0 +1,438 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: print.c
+|*
+|* Description: Dump of the elements of a file, one per line, as shown by
+|*              readasn. The callbacks of print_handler are called by the
+|*              decoder with an asn1printer as user.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version (moved from readasn.c)
+|* 20261016                     Lines and errors shared with json.c
+|* 20261016                     Typed values (--typed)
+|* 20261016                     Header of a primitive cut short by the end of the file
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static void     printout        (asn1printer *pr, int depth, long pos, int recno);
+static void     print_item      (asn1printer *pr, const asn1item *a_item, const char *name);
+static int      print_start_cons(void *user, const asn1event *ev);
+static int      print_primitive (void *user, const asn1event *ev);
+static int      print_end_cons  (void *user, const asn1event *ev);
+static void     print_cut       (void *user, const asn1event *ev);
+
+
+/* 3. Global Variables */
+
+const asn1handler print_handler =               /* Callbacks printing the dump */
+{
+    print_start_cons,
+    print_primitive,
+    print_end_cons,
+    print_error,
+    print_cut
+};
+
+
+/****************************************************************************
+|*
+|* Function: print_header
+|*
+|* Description;
+|*
+|*     Prints the type of the file
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version (moved from main)
+|*
+****************************************************************************/
+void print_header(asn1printer *pr, const asn1ctx *ctx)
+{
+    int         file_type = ctx->file_type;
+
+    if (pr->tag != NULL)
+        output_puts(pr->out, pr->tag);
+
+    output_printf(pr->out, "File type: %s ver: %d, rel: %d, rap_ver: %d, rap_rel: %d\n",
+            (file_type == FT_TAP ? "TAP" : (file_type == FT_NOT ? "NOT" : (file_type == FT_RAP ? "RAP" : (file_type == FT_NRT ? "NRT" : "UNK")))),
+            ctx->gsmainfo.ver, ctx->gsmainfo.rel, ctx->gsmainfo.rap_ver, ctx->gsmainfo.rap_rel);
+}
+
+
+/****************************************************************************
+|*
+|* Function: print_flush
+|*
+|* Description;
+|*
+|*     Passes the lines kept in memory to the shared output, holding its
+|*     lock, so that the lines of several printers are not mixed
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void print_flush(asn1printer *pr)
+{
+    if (pr->shared == NULL || pr->out->len == 0)
+        return;
+
+    pthread_mutex_lock(pr->lock);
+    output_write(pr->shared, pr->out->buff, pr->out->len);
+    if (pr->shared->is_tty)
+        (void)output_flush(pr->shared);
+    pthread_mutex_unlock(pr->lock);
+
+    pr->out->len = 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: print_close
+|*
+|* Description;
+|*
+|*     Releases what the handlers keep in the printer
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void print_close(asn1printer *pr)
+{
+    json_close(pr);
+    arrow_close(pr);
+    csv_close(pr);
+}
+
+
+/****************************************************************************
+|*
+|* Function: print_eol
+|*
+|* Description;
+|*
+|*     Ends a line. Printers with a shared output pass their lines to it
+|*     in chunks.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void print_eol(asn1printer *pr)
+{
+    output_eol(pr->out);
+
+    if (pr->shared != NULL && pr->out->len >= PRINT_CHUNK_SIZE)
+        print_flush(pr);
+}
+
+
+/****************************************************************************
+|* 
+|* Function: printout
+|* 
+|* Description; 
+|* 
+|*     Print out the position, record number and indentation of a line
+|* 
+|* Return:
+|*      void
+|* 
+|* 
+|* Author: Javier Gutierrez (JG)
+|* 
+|* Modifications:
+|* 20050719    JG    Initial version
+|* 20261016          Written into the output buffer
+|* 
+****************************************************************************/
+static void printout(asn1printer *pr, int depth, long pos, int recno)
+{
+    asn1output*     out = pr->out;
+
+    if (pr->tag != NULL)
+        output_puts(out, pr->tag);
+
+    output_zdec(out, (unsigned long)pos, 8);
+    output_putc(out, ':');
+    output_zdec(out, (unsigned long)recno, 4);
+    output_putc(out, ' ');
+    output_indent(out, depth);
+}
+
+
+/****************************************************************************
+|* 
+|* Function: print_item
+|* 
+|* Description; 
+|* 
+|*     Print out the name, tag and size of an item:
+|*     "name => Tag: ddd "xx"h Size: d "xx"h"
+|* 
+|* Return:
+|*      void
+|* 
+|* Modifications:
+|* 20261016    Initial version
+|* 
+****************************************************************************/
+static void print_item(asn1printer *pr, const asn1item *a_item, const char *name)
+{
+    asn1output*     out = pr->out;
+
+    if (pr->use_tagnames)
+    {
+        if (name == NULL)
+            output_puts(out, "Unknow Tag");
+        else
+            output_puts(out, name);
+
+        output_puts(out, " => ");
+    }
+
+    output_puts(out, "Tag: ");
+    output_zdec(out, (unsigned long)a_item->tag, 3);
+    output_puts(out, " \"");
+    output_puts(out, a_item->tag_h);
+    output_puts(out, "\"h Size: ");
+    output_dec(out, a_item->size);
+    output_puts(out, " \"");
+    output_puts(out, a_item->size_h);
+    output_puts(out, "\"h");
+}
+
+
+/****************************************************************************
+|* 
+|* Function: print_start_cons
+|* 
+|* Description; 
+|* 
+|*     Prints the header of a constructed element and opens its block
+|* 
+|* Return:
+|*      ASN1_CONTINUE
+|* 
+|* Modifications:
+|* 20261016    Initial version
+|* 
+****************************************************************************/
+static int print_start_cons(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+    asn1output*     out = pr->out;
+
+    printout(pr, ev->depth, ev->pos, ev->recno);
+    print_item(pr, ev->item, ev->name);
+    print_eol(pr);
+
+    printout(pr, ev->depth, ev->vpos, ev->recno);
+    output_putc(out, '{');
+    print_eol(pr);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|* 
+|* Function: print_primitive
+|* 
+|* Description; 
+|* 
+|*     Prints a primitive element: its value as a number (up to 8 bytes),
+|*     as text (if printable) and as hexadecimal, then its typed value
+|* 
+|* Return:
+|*      ASN1_CONTINUE
+|* 
+|* Modifications:
+|* 20261016    Initial version (moved from decode_asn)
+|* 20261016    Typed value
+|* 20261016    Number added up unsigned: no signed overflow
+|* 
+****************************************************************************/
+static int print_primitive(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+    asn1output*     out = pr->out;
+    char            typed[TYPED_MAX_LEN];
+    unsigned long long sum_up = 0;
+    long            i = 0;
+    long            n = 0;
+
+    printout(pr, ev->depth, ev->pos, ev->recno);
+
+    /* 1. End of indefinite length */
+
+    if (ev->is_eoe)
+    {
+        if (pr->use_tagnames)
+            output_puts(out, "EoE => ");
+        output_puts(out, "Tag: 000 \"00\"h Size: 0 \"00\"h {\"\" \"\"h}");
+        print_eol(pr);
+        return ASN1_CONTINUE;
+    }
+
+
+    /* 2. Any other element */
+
+    print_item(pr, ev->item, ev->name);
+    output_puts(out, " {");
+
+    if ((size_t)ev->item->size <= sizeof(sum_up))
+    {
+        for(i = 0; i < ev->item->size ; i++)
+            sum_up = sum_up << 8 | ev->value[i];
+
+        output_dec(out, (long long)sum_up);
+        output_putc(out, ' ');
+    }
+
+    output_text_hexa(out, ev->value, ev->item->size);
+    output_puts(out, "h}");
+
+    if (pr->typed != NULL && ( n = typed_value(pr->typed, ev, typed) ) > 0)
+    {
+        output_puts(out, " = ");
+        output_write(out, typed, n);
+    }
+
+    print_eol(pr);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|* 
+|* Function: print_end_cons
+|* 
+|* Description; 
+|* 
+|*     Closes the block of a constructed element
+|* 
+|* Return:
+|*      ASN1_CONTINUE
+|* 
+|* Modifications:
+|* 20261016    Initial version
+|* 
+****************************************************************************/
+static int print_end_cons(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+    asn1output*     out = pr->out;
+
+    printout(pr, ev->depth, ev->pos, ev->recno);
+    output_putc(out, '}');
+    print_eol(pr);
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: print_cut
+|*
+|* Description;
+|*
+|*     Prints the header of a primitive cut short by the end of the file,
+|*     as it was printed before reading its value. The decoding stops.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void print_cut(void *user, const asn1event *ev)
+{
+    asn1printer*    pr = (asn1printer *)user;
+
+    printout(pr, ev->depth, ev->pos, ev->recno);
+    print_item(pr, ev->item, ev->name);
+    output_puts(pr->out, " {");
+    print_eol(pr);
+}
+
+
+/****************************************************************************
+|* 
+|* Function: print_error
+|* 
+|* Description; 
+|* 
+|*     Prints the errors of the decoder, after the name of the file in
+|*     batch mode
+|* 
+|* Return:
+|*      void
+|* 
+|* Modifications:
+|* 20261016    Initial version
+|* 
+****************************************************************************/
+void print_error(void *user, long pos, const char *msg)
+{
+    asn1printer*    pr = (asn1printer *)user;
+
+    (void)pos;
+
+    if (pr->name != NULL)
+        fprintf(stderr, "%s: %s\n", pr->name, msg);
+    else
+        fprintf(stderr, "%s\n", msg);
+}
+
+
+/* EOF */
@@ -25,7 +25,8 @@
 |*
 |* Return:
 |*      0: successful
-|*      1: error
+|*      1: error, or --totals: the totals differ from the ones declared
+|*      2-9: --validate: the file is not valid (ASN1_ERR_*)
 |*
 |*
 |*
@@ -35,6 +36,26 @@
 |*
 |* When         Who     Pos     What
 |* 20120226     JG              Initial version (redesign of readtap). 
+|* 20261016                     Memory mapped input
+|* 20261016                     Streaming input from stdin and pipes
+|* 20261016                     Iterative decoder with bounded depth
+|* 20261016                     Buffered output
+|* 20261016                     Tag name tables built at compile time
+|* 20261016                     Decoder moved to libreadasn (decode.c)
+|* 20261016                     Parallel decoding of the records (-j)
+|* 20261016                     Batch mode: many files, lists and directories
+|* 20261016                     Index of the records (--index, --record, --range)
+|* 20261016                     Filter of tag paths (-f)
+|* 20261016                     NDJSON output (-F json)
+|* 20261016                     CSV and TSV output (-F csv, -F tsv, -c)
+|* 20261016                     Apache Arrow output (-F arrow)
+|* 20261016                     Statistics of the elements (--stats)
+|* 20261016                     Validation of the structure (--validate)
+|* 20261016                     Compressed files and pipes (gzip, bzip2, zstd)
+|* 20261016                     Dictionaries of tag names (--dict)
+|* 20261016                     Names by the type of the parent (schema of --dict)
+|* 20261016                     Typed values of TAP and NRT (--typed)
+|* 20261016                     Totals by service and charge type (--totals)
 |*
 ****************************************************************************/
 
@@ -42,10 +63,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include <string.h>
-#include <errno.h>
-#include <stdarg.h>
+#include <unistd.h>
+#include <limits.h>
+#include <getopt.h>
+#include <sys/stat.h>
 
 
 #include "readasn.h"
@@ -53,911 +75,545 @@
 
 /* 2. Global Variables */
 
-static long    pos = 0;                         /* Current position in file */
-static char   (*tagname)[MAXLEN];               /* Array with the tag definition */
 static int     use_tagnames = TRUE;             /* Flag to use tagnames. Default->TRUE */
+static int     max_depth = MAXDEPTH;            /* Maximum nesting of constructed elements */
+static asn1output out;                          /* Buffered standard output */
+static long    out_size = OUTPUT_BUFF_SIZE;     /* Size of the output buffer */
+static int     nthreads = 1;                    /* Threads decoding the records */
+static int     rec_first = 0;                   /* First record to decode. 0: whole file */
+static int     rec_last = 0;                    /* Last record to decode */
+static int     do_index = FALSE;                /* Only write the index of the records */
+static int     do_stats = FALSE;                /* Only print the statistics of the elements */
+static int     do_validate = FALSE;             /* Only check the structure of the file */
+static char    invalid_msg[256] = "";           /* First error found by --validate */
+static char*   filter = NULL;                   /* Tag paths to print. NULL: all */
+static int     format = FMT_TEXT;               /* Format of the output */
+static const asn1handler* handler = &print_handler; /* Callbacks writing the format */
+static csvcols cols;                            /* Columns of -F csv and -F tsv */
+static char*   columns = NULL;                  /* Columns as given with -c */
+static asn1dict dicts[DICT_MAX];                /* Dictionaries of --dict, chained in order */
+static int     ndicts = 0;
+static const asn1schema* schema = NULL;         /* First schema of the dictionaries. NULL: none */
+static int     do_typed = FALSE;                /* Typed values of the primitives */
+static int     do_totals = FALSE;               /* Only print the totals of the records */
 
-char    nrt0201_tagname_map[MAXTAGS][MAXLEN];
-char    rap01XX_tagname_map[MAXTAGS][MAXLEN];
-char    tap03le09_tagname_map[MAXTAGS][MAXLEN];
-char    tap03ge10_tagname_map[MAXTAGS][MAXLEN];
-
-uchar   *buffin_str = NULL, *buffin_str_tmp = NULL;
-long    buffin_str_len = 0;
 
 /* 3. Prototypes */
 
-static int      decode_asn      (FILE *file, long size, int is_indef, int is_root, int recno, int is_tap, int depth);
-static int      decode_size     (FILE *file, asn1item *a_item);
-static int      decode_tag      (FILE *file, asn1item *a_item);
-static void     bcd_2_hexa      (char *str2, const uchar *str1, const int len);
-
 //static int      read_def_file   (void);
-static int      is_printable    (uchar *str, long len);
 static void     help            (char* program_name);
-static int      get_file_type   (FILE* file, int *file_type, gsmainfo_t *gsminfo);
+static void     flush_output    (void);
+static int      decode_records  (asn1ctx *ctx, const char *filename, asn1printer *pr);
+static void     validate_error  (void *user, long pos, const char *msg);
+
+
+/* 4. Callbacks of --validate: only the first error is kept */
+
+static const asn1handler validate_handler = { NULL, NULL, NULL, validate_error, NULL };
 
 
 /****************************************************************************
 |* 
-|* Function: printout
+|* Function: flush_output
 |* 
 |* Description; 
 |* 
-|*     Print out according to format and parameters
+|*     Flushes the output at exit, also when exiting on errors
 |* 
 |* Return:
 |*      void
 |* 
-|* 
-|* Author: Javier Gutierrez (JG)
-|* 
 |* Modifications:
-|* 20050719    JG    Initial version
+|* 20261016    Initial version
 |* 
 ****************************************************************************/
-static void printout(int depth, long pos, int recno, const char *format, ...)
+static void flush_output(void)
 {
-    
-   va_list args;
-
-   va_start(args, format);
-
-    printf("%08ld:%04d ", pos, recno);
-    for (; depth != 0; depth--)
-        printf("    ");
-    vfprintf(stdout, format, args);
-
-   va_end(args);
+    (void)output_close(&out);
 }
 
 
 int main(int argc, char **argv)
 {
-    FILE*           file = NULL;
+    asn1ctx         ctx;
+    asn1printer     pr;
+    asn1filter      flt;
+    asn1stats       stats;
+    asn1typed       typed;
+    asn1totals      totals;
+    batchopts       opts;
+    struct stat     st;
     char*           filename = "";
-    long            size = 0;
-    int             file_type = FT_UNK;
+    char*           list = NULL;
+    char*           outdir = NULL;
     char*           program_name = argv[0];
-    gsmainfo_t      gsmainfo;
-
-    memset(&gsmainfo, 0x00, sizeof(gsmainfo));
-
-
-    /* 1. Checking parameters */
-
-    filename = argv[1];
-
-    if (argc != 2 && argc != 3)
-        help(program_name);
-
-    if ( argc == 3 )
-    {
-        /* 1.1. -n : Use tags */
-
-        if ( argv[1][0] == '-' && argv[1][1] == 'n' )
-            use_tagnames = FALSE;
-        else
-            help(program_name);
-
-        filename = argv[2];
-    }
-
-
-    /* 2. Open Input File */
-    
-    if ( ( file = fopen(filename, "rb") ) == NULL )
+    int             opt = 0;
+    int             rc = 0;
+    char*           endptr = NULL;
+    char*           more = NULL;
+    static const struct option long_opts[] =
     {
-        fprintf(stderr, "Cannot open file: %s\n", strerror(errno));
-        exit(EXIT_FAILURE);
-    }
+        { "record", required_argument, NULL, OPT_RECORD },
+        { "range",  required_argument, NULL, OPT_RANGE },
+        { "index",  no_argument,       NULL, OPT_INDEX },
+        { "stats",  no_argument,       NULL, OPT_STATS },
+        { "validate", no_argument,     NULL, OPT_VALIDATE },
+        { "filter", required_argument, NULL, 'f' },
+        { "format", required_argument, NULL, 'F' },
+        { "columns", required_argument, NULL, 'c' },
+        { "dict",   required_argument, NULL, OPT_DICT },
+        { "typed",  no_argument,       NULL, OPT_TYPED },
+        { "totals", no_argument,       NULL, OPT_TOTALS },
+        { NULL,     0,                 NULL, 0 }
+    };
 
-    /* 3. Get File Type */
-    if ( get_file_type(file, &file_type, &gsmainfo) != 0)
-    {
-        fprintf(stderr, "Error getting the type of file %s\n", filename);
-        exit(EXIT_FAILURE);
-    }
 
-    printf("File type: %s ver: %d, rel: %d, rap_ver: %d, rap_rel: %d\n", 
-            (file_type == FT_TAP ? "TAP" : (file_type == FT_NOT ? "NOT" : (file_type == FT_RAP ? "RAP" : (file_type == FT_NRT ? "NRT" : "UNK")))),
-            gsmainfo.ver, gsmainfo.rel, gsmainfo.rap_ver, gsmainfo.rap_rel);
+    /* 1. Checking parameters */
 
-    if (use_tagnames && file_type != FT_UNK)
+    while ( ( opt = getopt_long(argc, argv, "nd:b:j:l:o:f:F:c:", long_opts, NULL) ) != -1 )
     {
-        tagid_init();
-        if (
-                ((file_type == FT_TAP || file_type == FT_NOT || file_type == FT_RAP) && gsmainfo.ver == 3) ||
-                (file_type == FT_ACK && gsmainfo.ver == 0)
-           )
+        switch (opt)
         {
-            if (gsmainfo.rel <= 9)
-            {
-                tagname = tap03le09_tagname_map;
-            }
-            else
-            {
-                tagname = tap03ge10_tagname_map;
-            }
-
-            if (((file_type == FT_RAP || file_type == FT_ACK) && gsmainfo.rap_ver == 1))
-            {
-                if (merge_tap_rapids(tagname, rap01XX_tagname_map) != 0)
+            case 'n': /* 1.1. -n : Use tags */
+                use_tagnames = FALSE;
+                break;
+            case 'd': /* 1.2. -d : Maximum depth */
+                if ( ( max_depth = atoi(optarg) ) <= 0 )
+                    help(program_name);
+                break;
+            case 'b': /* 1.3. -b : Size of the output buffer */
+                out_size = strtol(optarg, &endptr, 10);
+                if (*endptr == 'k' || *endptr == 'K') { out_size <<= 10; endptr++; }
+                else if (*endptr == 'm' || *endptr == 'M') { out_size <<= 20; endptr++; }
+                if (*endptr != '\0' || out_size <= 0)
+                    help(program_name);
+                break;
+            case 'j': /* 1.4. -j : Threads */
+                if ( ( nthreads = atoi(optarg) ) <= 0 )
+                    help(program_name);
+                break;
+            case 'l': /* 1.5. -l : List of files */
+                list = optarg;
+                break;
+            case 'o': /* 1.6. -o : Output directory */
+                outdir = optarg;
+                break;
+            case OPT_RECORD: /* 1.7. --record N : One record */
+                rec_first = rec_last = (int)strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || rec_first <= 0)
+                    help(program_name);
+                break;
+            case OPT_RANGE: /* 1.8. --range A-B : Records from A to B (to the end without B) */
+                rec_first = (int)strtol(optarg, &endptr, 10);
+                rec_last = INT_MAX;
+                if (*endptr == '-' && endptr[1] != '\0')
+                    rec_last = (int)strtol(endptr + 1, &endptr, 10);
+                else if (*endptr == '-')
+                    endptr++;
+                if (*endptr != '\0' || rec_first <= 0 || rec_last < rec_first)
+                    help(program_name);
+                break;
+            case OPT_INDEX: /* 1.9. --index : Write the index only */
+                do_index = TRUE;
+                break;
+            case 'f': /* 1.10. -f : Filter. Paths of several -f are added */
+                if (filter == NULL)
+                    more = strdup(optarg);
+                else if ( ( more = (char *)realloc(filter, strlen(filter) + strlen(optarg) + 2) ) != NULL )
+                    strcat(strcat(more, ","), optarg);
+                if ( ( filter = more ) == NULL )
                 {
+                    fprintf(stderr, "Couldn't allocate memory for the filter\n");
                     exit(EXIT_FAILURE);
                 }
-            }
-
-        }
-        else if (file_type == FT_NRT)
-        {
-            tagname = nrt0201_tagname_map;
-        } 
-        else
-        {
-            use_tagnames = FALSE;
+                break;
+            case 'F': /* 1.11. -F : Format of the output */
+                if (strcmp(optarg, "text") == 0)
+                    { format = FMT_TEXT; handler = &print_handler; }
+                else if (strcmp(optarg, "json") == 0)
+                    { format = FMT_JSON; handler = &json_handler; }
+                else if (strcmp(optarg, "csv") == 0)
+                    { format = FMT_CSV; handler = &csv_handler; }
+                else if (strcmp(optarg, "tsv") == 0)
+                    { format = FMT_TSV; handler = &csv_handler; }
+                else if (strcmp(optarg, "arrow") == 0)
+                    { format = FMT_ARROW; handler = &csv_handler; }
+                else
+                    help(program_name);
+                break;
+            case 'c': /* 1.12. -c : Columns of csv, tsv and arrow */
+                columns = optarg;
+                break;
+            case OPT_STATS: /* 1.13. --stats : Statistics only */
+                do_stats = TRUE;
+                break;
+            case OPT_VALIDATE: /* 1.14. --validate : Structural checks only */
+                do_validate = TRUE;
+                break;
+            case OPT_DICT: /* 1.15. --dict : Tag names of a dictionary. Several are looked up in order */
+                if (ndicts == DICT_MAX)
+                {
+                    fprintf(stderr, "No more than %d dictionaries\n", DICT_MAX);
+                    exit(EXIT_FAILURE);
+                }
+                if (dict_load(&dicts[ndicts], optarg, NULL) != 0)
+                    exit(EXIT_FAILURE);
+                if (ndicts > 0)
+                    dicts[ndicts - 1].tagmap.next = &dicts[ndicts].tagmap;
+                if (schema == NULL && dicts[ndicts].schema.ents != NULL)
+                    schema = &dicts[ndicts].schema;
+                ndicts++;
+                break;
+            case OPT_TYPED: /* 1.16. --typed : Typed values of TAP and NRT */
+                do_typed = TRUE;
+                break;
+            case OPT_TOTALS: /* 1.17. --totals : Totals of the records only */
+                do_totals = TRUE;
+                break;
+            default:
+                help(program_name);
         }
     }
-    else
-    {
-        use_tagnames = FALSE;
-    }
 
-    /* 4. Get file size */
+    if (optind > argc - 1 && list == NULL)
+        help(program_name);
 
-    if (fseek(file, 0, SEEK_END) != 0) // seek to end of file
-    {
-        fprintf(stderr, "Error moving to the end of the file: %s\n", strerror(errno));
-        exit(EXIT_FAILURE);
-    }
-    size = ftell(file); // get current file pointer
-    if (fseek(file, 0, SEEK_SET) != 0) // seek back to beginning of file
+    if ((format == FMT_CSV || format == FMT_TSV || format == FMT_ARROW) != (columns != NULL))
     {
-        fprintf(stderr, "Error moving to the beginning of the file: %s\n", strerror(errno));
+        fprintf(stderr, "-c is needed by -F csv, tsv and arrow, and only by them\n");
         exit(EXIT_FAILURE);
     }
 
-
-    /* 5. Decode and prints file */
-
-    if ( (decode_asn(
-                    file,                                   /* file */
-                    size,                                   /* size */
-                    FALSE,                                  /* is_indef */
-                    (file_type == FT_UNK ? TRUE : FALSE),   /* is_root */
-                    (file_type == FT_UNK ? 1 : 0),          /* recno */
-                    file_type,                              /* file_type */
-                    0                                       /* depth */
-                    )
-         ) == -1 )
+    if (columns != NULL && filter != NULL)
     {
-        //fprintf(stderr, "Error decoding file\n");
+        fprintf(stderr, "-f cannot be used with -F csv, tsv and arrow: -c chooses the elements\n");
         exit(EXIT_FAILURE);
     }
 
+    if (columns != NULL && csv_compile(&cols, columns, (format == FMT_TSV ? '\t' : ',')) != 0)
+        exit(EXIT_FAILURE);
 
-    /* 6. Closing and End. */
-
-    (void)fclose(file);
-
-    if (buffin_str) 
+    if (output_init(&out, STDOUT_FILENO, out_size) != 0)
     {
-        free(buffin_str);
+        exit(EXIT_FAILURE);
     }
+    atexit(flush_output);
 
-    return(EXIT_SUCCESS);
-}
-
-/****************************************************************************
-|* 
-|* Function: decode_asn
-|* 
-|* Description; 
-|* 
-|*     recursive function to decode a tag item.
-|* 
-|* Return:
-|*      0: Successful
-|*     -1: Error decoding
-|* 
-|* 
-|* Author: Javier Gutierrez (JG)
-|* 
-|* Modifications:
-|* 20050707    JG    Initial version
-|* 
-****************************************************************************/
-static int decode_asn(
-    FILE*               file,           /* File handler to decode */
-    long                size,           /* Size within to decode */
-    int                 is_indef,       /* Flag indicating if encoding is indefinite (FALSE/TRUE) */
-    int                 is_root,        /* Flag indicating if it's the root of the encoding */
-    int                 recno,          /* Root Record number */
-    int                 file_type,      /* Flag indicating if the file is TAP */
-    int                 depth           /* Depth in which we are (to print) */
-)
-{
-    asn1item            a_item;
-    int                 is_root_loc = is_root, recno_loc = recno;
-    long long           sum_up = 0;
-    long                loc_pos = pos, i = 0;
-
-    memset(&a_item, 0x00, sizeof(a_item));
 
-    /* 1. Process all size received from our parent */
+    /* 2. Batch mode: several files, a list or a directory */
 
-    while (size >0 || is_indef)
+    if (list != NULL || outdir != NULL || optind < argc - 1 ||
+            (stat(argv[optind], &st) == 0 && S_ISDIR(st.st_mode)))
     {
-        /* 1.1. TAG:   decode */
-
-        if (decode_tag(file, &a_item) == -1)
+        memset(&opts, 0x00, sizeof(opts));
+        opts.nthreads = nthreads;
+        opts.max_depth = max_depth;
+        opts.use_tagnames = use_tagnames;
+        opts.out_size = out_size;
+        opts.outdir = outdir;
+        opts.filter = filter;
+        opts.format = format;
+        opts.cols = (columns != NULL ? &cols : NULL);
+        opts.tagmap = (ndicts > 0 ? &dicts[0].tagmap : NULL);
+        opts.schema = schema;
+        opts.typed = do_typed;
+        opts.out = &out;
+
+        if (rec_first > 0 || do_index || do_stats || do_validate || do_totals)
         {
-            fprintf(stderr, "Error decoding tag at position: %ld\n", pos);
-            return -1;
+            fprintf(stderr, "--index, --record, --range, --stats, --validate and --totals take a single file\n");
+            exit(EXIT_FAILURE);
         }
 
-        //size -= a_item.tag_l;
-
-
-        /* 1.2. SIZE:  decode */
-
-        if (decode_size(file, &a_item) == -1)
+        if (format == FMT_ARROW && outdir == NULL)
         {
-            fprintf(stderr, "Error decoding size at position: %ld\n", pos);
-            return -1;
+            fprintf(stderr, "-F arrow writes one file per input: use -o with several files\n");
+            exit(EXIT_FAILURE);
         }
 
-        //size -= a_item.size_l;
+        /* 2.1. One header for the rows of all the files */
 
-
-        /* 1.3. Did we find 2 null bytes or trash byte? */
-
-        if ( a_item.tag == 0 && a_item.size == 0 && is_indef)
+        if (columns != NULL && outdir == NULL && format != FMT_ARROW)
         {
-
-            /* 1.3.1. End of indefinite length found */
-
-            {
-                /* Display */
-                printout(depth, loc_pos, recno, "%sTag: 000 \"00\"h Size: 0 \"00\"h {\"\" \"\"h}\n",
-                    use_tagnames
-                        ? "EoE => "
-                        : ""
-                );
-            }
-
-            break;
+            memset(&pr, 0x00, sizeof(pr));
+            pr.out = &out;
+            pr.cols = &cols;
+            csv_header(&pr);
         }
-        else if ( a_item.tag_x[0] == 0x00 && a_item.size != 0 && ! is_indef)
-        {
-
-            /* 1.3.2. Trash byte: Rewind one byte in order to try to recover and keep decoding */
-
-            loc_pos++;
-            pos = loc_pos;
-            size--;
-            if (fseek(file, pos, SEEK_SET) != 0) // rewind 1 byte
-            {
-                fprintf(stderr, "Error moving 1 byte back in file: %s\n", strerror(errno));
-                exit(EXIT_FAILURE);
-            }
-            continue;
-        }
-
 
+        rc = batch_run(argv + optind, argc - optind, list, &opts);
 
-        /* 1.4. VALUE: Primitive or Constructed */
-
-        {
-
-            /* 1.4.2. Proceed according to Primitive and Constructed Tag */
-
-            if (a_item.pc == 0)
-            {
-                /* 1.4.2.1. Primitive */
-
-                {
-                    /* 1.4.2.1.1 Display */
-
-                    printout(depth, loc_pos, recno, "%s%sTag: %03d \"%s\"h Size: %d \"%s\"h {", 
-                        use_tagnames
-                            ? tagname[a_item.tag][0] == '\0'
-                                ? "Unknow Tag"
-                                : tagname[a_item.tag]
-                            : "", 
-                        use_tagnames
-                            ? " => "
-                            : "",
-                        a_item.tag, a_item.tag_h, a_item.size, a_item.size_h);
-                }
-
-                /* 1.4.2.1.2 Alloc and read element */
+        exit(rc == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
 
-                if (!buffin_str_len)
-                {
-                    if ( ( buffin_str = (uchar *)malloc((size_t)a_item.size + 1 * sizeof(uchar)) ) == NULL )
-                    {
-                        fprintf(stderr, "Couldn't allocate memory. Size too long at pos: %ld\n", pos);
-                        return -1;
-                    }
-                    buffin_str_len = a_item.size;
-                }
-                else
-                {
-                    if (a_item.size > buffin_str_len )
-                    {
-                        if ( ( buffin_str_tmp = (uchar *)realloc(buffin_str, (size_t)a_item.size + 1 * sizeof(uchar)) ) == NULL )
-                        {
-                            fprintf(stderr, "Couldn't allocate memory. Size too long at pos: %ld\n", pos);
-                            return -1;
-                        }
-                        buffin_str = buffin_str_tmp;
-                        buffin_str_len = a_item.size;
-                    }
-                }
+    filename = argv[optind];
 
 
+    /* 3. Open Input File and get its type */
+    
+    if ( asn1_open(&ctx, filename, max_depth) != 0 )
+    {
+        exit(EXIT_FAILURE);
+    }
 
-                (void)fread(buffin_str, sizeof(uchar), (size_t)a_item.size, file);
-                if(feof(file) != 0)
-                {
-                    fprintf(stderr, "Found end of file too soon at position: %ld\n", pos);
-                    if (buffin_str) free(buffin_str);
-                    return -1;
-                }
+    if (ndicts > 0)
+    {
+        asn1_tagmap(&ctx, &dicts[0].tagmap);
+        asn1_schema(&ctx, schema);
+    }
 
+    /* 3.1. Filter: tag names of the type of the file (or of --dict), also with -n */
 
-                {
-                    /* 1.4.2.1.3 Display */
-
-                    if ((size_t)a_item.size <= sizeof(sum_up))
-                    {
-                        sum_up = 0;
-                        for(i = 0; i < a_item.size ; i++)
-                        {
-                            sum_up <<= 8;
-                            sum_up += (long)buffin_str[i];
-                        }
-
-                        printf("%lld ", sum_up);
-                    }
-
-                    if(is_printable(buffin_str, a_item.size))
-                    {
-                        printf("\"");
-                        for(i = 0; i < a_item.size; i++)
-                            printf("%c", buffin_str[i]);
-                        printf("\"");
-                    }
-                    else
-                    {
-                        printf("\"\"");
-                    }
-
-                    printf(" \"");
-                    for (i = 0; i < a_item.size; i++)
-                        printf("%02x", (unsigned int)buffin_str[i]);
-
-                    printf("\"h}\n");
+    if (filter != NULL)
+    {
+        if (do_index || rec_first > 0)
+        {
+            fprintf(stderr, "-f cannot be used with --index, --record and --range\n");
+            exit(EXIT_FAILURE);
+        }
 
-                }
+        if (filter_compile(&flt, filter, ctx.tagmap, ctx.schema) != 0)
+            exit(EXIT_FAILURE);
 
-                pos += a_item.size;
+        asn1_filter(&ctx, &flt);
+    }
 
-            }
-            else
-            {
-                /* 1.4.2.2. Constructed */
+    /* 3.2. Columns: tag names of the type of the file (or of --dict), also with -n */
 
-                {
-                    /* 1.4.2.2.1 Display */
+    if (columns != NULL && csv_bind(&cols, ctx.tagmap, ctx.schema) != 0)
+        exit(EXIT_FAILURE);
 
-                    printout(depth, loc_pos, recno, "%s%sTag: %03d \"%s\"h Size: %d \"%s\"h\n", 
-                            use_tagnames
-                                ? tagname[a_item.tag][0] == '\0'
-                                    ? "Unknow Tag"
-                                    : tagname[a_item.tag]
-                                : "", 
-                            use_tagnames
-                                ? " => "
-                                : "",
-                            a_item.tag, a_item.tag_h, a_item.size, a_item.size_h);
+    /* 3.3. Typed values and totals: by the tag names of the type of the file (or of --dict), also with -n */
 
-                    printout(depth, pos, recno, "{\n");
+    if (do_typed && typed_init(&typed, &ctx) != 0)
+        exit(EXIT_FAILURE);
 
-                }
+    if (do_totals && totals_init(&totals, &ctx) != 0)
+        exit(EXIT_FAILURE);
 
-                /* 1.4.2.2.2 Decode the constructed element */
+    /* 3.4. Tag names: only if known for the type of file or given with --dict. The
+            schema is kept without them: it also tells the lists (see asn1event.is_seqof) */
 
-                //if (!(!a_item.size && !a_item.size_x[0]) )
-                if (a_item.size_x[0]) // If size == 0x80 then it's an indifinite constructed, if 0x00 might be an empty constructed.
-                {
+    if (!use_tagnames)
+        ctx.tagmap = NULL;
 
+    memset(&pr, 0x00, sizeof(pr));
+    pr.out = &out;
+    pr.use_tagnames = (ctx.tagmap != NULL);
+    pr.cols = (columns != NULL ? &cols : NULL);
+    pr.typed = (do_typed ? &typed : NULL);
+    pr.file = filename;
 
-                    if (file_type == FT_UNK) {is_root_loc = FALSE; recno_loc = recno;}
-                    if (file_type == FT_TAP) {is_root_loc = (a_item.tag == 3 ? TRUE : FALSE); recno_loc = (a_item.tag == 3 ? 1 : recno);}
-                    if (file_type == FT_NOT) {is_root_loc = FALSE; recno_loc = recno;}
-                    if (file_type == FT_NRT) {is_root_loc = (a_item.tag == 2 ? TRUE : FALSE); recno_loc = (a_item.tag == 2 ? 1 : recno);}
-                    if (file_type == FT_RAP) {is_root_loc = (a_item.tag == 536 ? TRUE : FALSE); recno_loc = (a_item.tag == 536 ? 1 : recno);}
-                    if (file_type == FT_ACK) {is_root_loc = FALSE; recno_loc = recno;}
-
-                    if ( (decode_asn(
-                                    file,                               /* file */
-                                    a_item.size,                        /* size */
-                                    (a_item.size == 0 ? TRUE : FALSE),  /* is_indef */
-                                    is_root_loc,                        /* is_root */
-                                    recno_loc,                          /* recno */
-                                    file_type,                          /* file_type */
-                                    depth +1)                           /* depth */
-                         ) == -1 )
-                    {
-                        return -1;
-                    }
-                }
+    /* 3.5. Statistics: only the tags and sizes are decoded */
 
-                {
-                    /* 1.4.2.2.2 Display */
+    if (do_stats)
+    {
+        if (do_validate || do_index || rec_first > 0 || format != FMT_TEXT || filter != NULL || do_totals || do_typed)
+        {
+            fprintf(stderr, "--stats cannot be used with --validate, --index, --record, --range, --totals, --typed, -f and -F\n");
+            exit(EXIT_FAILURE);
+        }
 
-                    printout(depth, pos, recno, "}\n");
+        if (stats_init(&stats, &ctx) != 0)
+            exit(EXIT_FAILURE);
 
-                }
+        print_header(&pr, &ctx);
+        asn1_no_values(&ctx, TRUE);
 
-            }
+        rc = asn1_decode(&ctx, &stats_handler, &stats);
 
-            size -= pos - loc_pos ; //a_item.size;
+        stats_print(&stats, &out, &ctx);
+        stats_close(&stats);
+        asn1_close(&ctx);
 
-        }
+        exit(rc == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
 
-        loc_pos = pos;
+    /* 3.6. Totals: nothing else printed, exit code 1 if they differ from the audit */
 
-        if (is_root)
+    if (do_totals)
+    {
+        if (do_validate || do_index || rec_first > 0 || format != FMT_TEXT || filter != NULL || do_typed)
         {
-            recno++;
+            fprintf(stderr, "--totals cannot be used with --stats, --validate, --index, --record, --range, --typed, -f and -F\n");
+            exit(EXIT_FAILURE);
         }
 
-    }
-
-    return 0;
-}
-
-
-/****************************************************************************
-|* 
-|* Function: decode_tag
-|* 
-|* Description; 
-|* 
-|*     decodes tag into a asn1item
-|* 
-|* Return:
-|*      0: Successful
-|*     -1: Error decoding
-|* 
-|* 
-|* Author: Javier Gutierrez (JG)
-|* 
-|* Modifications:
-|* 20050715    JG    Initial version
-|* 
-****************************************************************************/
-static int decode_tag(
-    FILE*       file,       /* File handler */
-    asn1item*   a_item      /* pointer asn1item where to store the information */
-)
-{
-    uchar       buffin;
-    int         i;
+        print_header(&pr, &ctx);
 
+        rc = asn1_decode(&ctx, &totals_handler, &totals);
 
-    a_item->tag = 0;
+        if (totals_print(&totals, &out, &ctx) != 0)
+            rc = -1;
 
-    /* 1. Read from file */
+        totals_close(&totals);
+        asn1_close(&ctx);
 
-    buffin = (uchar)fgetc(file);
-    if(feof(file) != 0)
-    {
-        fprintf(stderr, "Found end of file too soon at position: %ld\n", pos);
-        return -1;
+        exit(rc == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
     }
-    pos++;
-
 
-    /* 2. Store class, primitive/constructed info and hexa tag */
+    /* 3.7. Validation: nothing printed if valid, exit code of the first error if not */
 
-    a_item->class = (unsigned) buffin>>6;
-    a_item->pc = (unsigned) (buffin>>5)&0x1;
-    a_item->tag_x[0] = buffin;
-    a_item->tag_l = 1;
-
-
-    /* 3. Work according to number of tag octets */
-
-    if ( ( buffin & 0x1F ) == 0x1F )
+    if (do_validate)
     {
-        /* 3.1 Tag has more than one octect */
-
-        for(i = 1; i<=4; i++) 
+        if (do_stats || do_index || rec_first > 0 || format != FMT_TEXT || filter != NULL || do_typed)
         {
-            buffin = (uchar)fgetc(file);
-            if(feof(file) != 0)
-            {
-                fprintf(stderr, "Found end of file too soon at position: %ld\n", pos);
-                return -1;
-            }
-            pos++;
-
-            a_item->tag <<= 7;
-            a_item->tag += (int)(buffin&0x7F);
-            a_item->tag_x[i] = buffin;
-            a_item->tag_l += 1;
-
-            if ( (buffin>>7) == 0 ) 
-                break;
-
-        }
-
-        if ( i>3 )
-        {
-            fprintf(stderr, "Found tag bigger than 4 bytes at position: %ld\n", pos);
-            return -1;
+            fprintf(stderr, "--validate cannot be used with --stats, --index, --record, --range, --typed, -f and -F\n");
+            exit(EXIT_FAILURE);
         }
 
-    }
-    else
-    {
-        /* 3.2 Tag has just one octect */
-
-        a_item->tag = (int)buffin&0x1F;
-    }
-
-    bcd_2_hexa(a_item->tag_h, a_item->tag_x, a_item->tag_l);
+        asn1_no_values(&ctx, TRUE);
+        asn1_strict(&ctx, TRUE);
 
-    return 0;
+        rc = asn1_decode(&ctx, &validate_handler, NULL);
 
-}
+        asn1_close(&ctx);
 
+        if (rc == 0)
+            exit(EXIT_SUCCESS);
 
-/****************************************************************************
-|* 
-|* Function: decode_size
-|* 
-|* Description; 
-|* 
-|*     decodes size into a asn1item
-|* 
-|* Return:
-|*      0: Successful
-|*     -1: Error decoding
-|* 
-|* 
-|* Author: Javier Gutierrez (JG)
-|* 
-|* Modifications:
-|* 20050715    JG    Initial version
-|* 
-****************************************************************************/
-static int decode_size(
-    FILE*       file,         /* File handler */
-    asn1item*   a_item        /* pointer asn1item where to store the information */
-)
-{
-    uchar       buffin;
-    int         i;
-
-    
-    a_item->size = 0;
-
+        fprintf(stderr, "%s: invalid at offset %ld: %s\n", filename, ctx.error_pos, invalid_msg);
+        exit(ctx.error != 0 ? ctx.error : EXIT_FAILURE);
+    }
 
-    /* 1. Read from file */
+    /* 4. Decode and prints file, or only the records asked for */
 
-    buffin = (uchar)fgetc(file);
-    if(feof(file) != 0)
+    if (do_index || rec_first > 0)
     {
-        if (a_item->tag_x[0] == 0x00) /* To avoid giving error on trash bytes */
+        if (decode_records(&ctx, filename, &pr) != 0)
         {
-            a_item->size = 1;
-            return 0;
+            print_close(&pr);
+            exit(EXIT_FAILURE);
         }
-        fprintf(stderr, "Found end of file too soon at position: %ld\n", pos);
-        return -1;
     }
-    pos++;
-
-
-    /* 2. Storing size_x */
-
-    a_item->size_x[0] = buffin;
-    a_item->size_l = 1;
-
-
-    /* 3. Work according the number of octets */
-
-    if (buffin>>7)
+    else
     {
-        /* 3.1. Size with more than one octet */
+        if (format == FMT_TEXT)
+            print_header(&pr, &ctx);
+        else if (format == FMT_ARROW && arrow_header(&pr) != 0)
+            exit(EXIT_FAILURE);
+        else if (format != FMT_ARROW && columns != NULL)
+            csv_header(&pr);
 
-        for(i = 1; (i <= (int)(a_item->size_x[0] & 0x7F)) && (i <= 4); i++)
-        {
-            buffin = (uchar)fgetc(file);
-            if(feof(file) != 0)
-            {
-                fprintf(stderr, "Found end of file too soon at position: %ld\n", pos);
-                return -1;
-            }
-            pos++;
-
-            a_item->size <<= 8;
-            a_item->size += (int)buffin;
-            a_item->size_x[i] = buffin;
-            a_item->size_l += 1;
-        }
+        /* 4.1. The Arrow file is written in order: one thread */
 
-        if ( i>7 )
+        if ( decode_parallel(&ctx, handler, &pr, (format == FMT_ARROW ? 1 : nthreads)) != 0 )
         {
-            fprintf(stderr, "Found size bigger than 8 bytes at position: %ld\n", pos);
-            return -1;
+            //fprintf(stderr, "Error decoding file\n");
+            print_close(&pr);   /* The records decoded, as in the dump */
+            exit(EXIT_FAILURE);
         }
-
-
     }
-    else
-    {
-        /* 3.2. Size with just one octet */
 
-        a_item->size = (int)(buffin);
-    }
 
-    bcd_2_hexa(a_item->size_h, a_item->size_x, a_item->size_l);
+    /* 5. Closing and End. */
 
-    return 0;
+    print_close(&pr);
+    if (do_typed)
+        typed_close(&typed);
+    asn1_close(&ctx);
 
+    return(EXIT_SUCCESS);
 }
 
-
 /****************************************************************************
 |* 
-|* Function: bcd_2_hexa
+|* Function: validate_error
 |* 
 |* Description; 
 |* 
-|*     Converts a bcd chain into an hexadecimal string
+|*     Keeps the message of the first error found by --validate
 |* 
 |* Return:
 |*      void
 |* 
-|* 
-|* Author: Javier Gutierrez (JG)
-|* 
 |* Modifications:
-|* 20050719    JG    Initial version
+|* 20261016    Initial version
 |* 
 ****************************************************************************/
-static void bcd_2_hexa(
-    char*           str2,   /* String to store the converted value */
-    const uchar*    str1,   /* String to convert */ 
-    const int       len     /* Because the string can contain \0 we cannot use strlen() */
-)
+static void validate_error(void *user, long pos, const char *msg)
 {
-    int     i = 0;
-    
-    for (i = 0; i < len; i++)
-        sprintf(&str2[i*2], "%02x", (unsigned) str1[i]);
-
-    str2[i*2] = '\0';
+    (void)user;
+    (void)pos;
 
+    if (invalid_msg[0] == '\0')
+        snprintf(invalid_msg, sizeof(invalid_msg), "%s", msg);
 }
 
 
 /****************************************************************************
 |* 
-|* Function: isprintable
-|* 
-|* Description; 
-|* 
-|*     Check if a complete string is printable
-|* 
-|* Return:
-|*      0: No printable
-|*      1: Printable
-|* 
-|* Author: Javier Gutierrez (JG)
-|* 
-|* Modifications:
-|* 20050719    JG    Initial version
-|* 
-****************************************************************************/
-static int is_printable(
-    uchar *str, 
-    long len
-)
-{
-    long i = 0, eol = 0;
-
-    for (i = 0; i < len; i++)
-    {
-        /* Note: sometimes they send an End of Line (0A) in the RAP comments */
-        if (!isprint(str[i]) && str[i] != 0x0a) 
-            return 0;
-        if (str[i] == 0x0a)
-            eol++;
-    }
-
-    /* Note: we only accept End of Lines if the message is long enough. Let's say: 7 */
-    if (eol > 0 && len < 7)
-        return 0;
-
-    return 1;
-}
-
-/****************************************************************************
-|* 
-|* Function: get_file_type
+|* Function: decode_records
 |* 
 |* Description; 
 |* 
-|*     Show usage
+|*     Writes the index of the records of the file (--index) or prints the
+|*     records from rec_first to rec_last, found with the index. The index
+|*     is built and saved first if there is none or the file changed.
 |* 
 |* Return:
-|*      int
-|* 
-|* Author: Javier Gutierrez (JG)
+|*      0: Successful
+|*     -1: Error indexing or decoding, or no such records
 |* 
 |* Modifications:
-|* 20120306    JG    Initial version
+|* 20261016    Initial version
 |* 
 ****************************************************************************/
-static int get_file_type(FILE* file, int *file_type, gsmainfo_t *gsmainfo)
+static int decode_records(asn1ctx *ctx, const char *filename, asn1printer *pr)
 {
-    uchar       buffin_str[200]; /* First bytes of the file */
-    int         buffin_len = 200, i = 0;
+    asn1index       idx;
+    int             rc = 0;
+    int             n = 0;
 
-    memset(buffin_str, 0x00, sizeof(buffin_str));
+    /* 1. Index of the file: the one saved or a new one */
 
-    if (file == NULL || file_type == NULL || gsmainfo == NULL)
+    if (ctx->in.mode == IN_STREAM || strcmp(filename, "-") == 0)
     {
-        fprintf(stderr, "Passed NULL Arguments");
+        fprintf(stderr, "The records of stdin or of compressed files cannot be indexed\n");
         return -1;
     }
 
-    if (fread(buffin_str, sizeof(uchar), (size_t)buffin_len, file) == 0)
+    if (do_index || index_load(&idx, filename) != 0)
     {
-        fprintf(stderr, "Error reading file at position: %d\n", 1);
-        return -1;
-    }
+        /* An index of a damaged file is used but not saved */
 
-    /* 
-     * We try to recognize the type of the file with this algorithm:
-     * 
-     * Regular expression   File type   Description
-     * ^61.+5f814405        FT_TAP      TAP file
-     * ^62                  FT_NOT      Notification file
-     * ^7f8416              FT_RAP      RAP file
-     * ^7f8417              FT_ACK      Acknowledge file
-     * ^61.+5f2901          FT_NRT      NRTRDE file
-     * Otherwise            FT_UNK      Any other ASN.1 file
-     *
-     */
-    switch(buffin_str[0])
-    {
-        case 0x61: /* TAP or NRT */
-            for (i = 1; i < 150; i++)
-            {
-                if (buffin_str[i] == 0x5f &&
-                        buffin_str[i + 1] == 0x81 &&
-                        buffin_str[i + 2] == 0x49 &&
-                        buffin_str[i + 3] == 0x01)
-                {
-                    gsmainfo->ver = (int)buffin_str[i + 4];
-                }
+        if ( ( rc = index_build(&idx, ctx) ) == 0 )
+            rc = index_save(&idx, filename);
 
-                if (buffin_str[i] == 0x5f &&
-                        buffin_str[i + 1] == 0x81 &&
-                        buffin_str[i + 2] == 0x3d &&
-                        buffin_str[i + 3] == 0x01)
-                {
-                    gsmainfo->rel = (int)buffin_str[i + 4];
-                    *file_type =  FT_TAP;
-                    break;
-                }
+        if (do_index)
+        {
+            if (rc == 0)
+                output_printf(pr->out, "Indexed %ld records in %s%s\n", idx.n, filename, INDEX_SUFFIX);
 
-            }
-            for (i = 1; i < 28; i++)
-            {
-                if (buffin_str[i] == 0x5f &&
-                        buffin_str[i + 1] == 0x29 &&
-                        buffin_str[i + 2] == 0x01)
-                {
-                    gsmainfo->ver = (int)buffin_str[i + 3];
-                }
+            index_close(&idx);
+            return rc;
+        }
+    }
 
-                if (buffin_str[i] == 0x5f &&
-                        buffin_str[i + 1] == 0x25 &&
-                        buffin_str[i + 2] == 0x01)
-                {
-                    gsmainfo->rel = (int)buffin_str[i + 3];
-                    *file_type =  FT_NRT;
-                    break;
-                }
-            }
-            break;
-        case 0x62:
-            for (i = 1; i < 150; i++)
-            {
-                if (buffin_str[i] == 0x5f &&
-                        buffin_str[i + 1] == 0x81 &&
-                        buffin_str[i + 2] == 0x49 &&
-                        buffin_str[i + 3] == 0x01)
-                {
-                    gsmainfo->ver = (int)buffin_str[i + 4];
-                }
 
-                if (buffin_str[i] == 0x5f &&
-                        buffin_str[i + 1] == 0x81 &&
-                        buffin_str[i + 2] == 0x3d &&
-                        buffin_str[i + 3] == 0x01)
-                {
-                    gsmainfo->rel = (int)buffin_str[i + 4];
-                    *file_type =  FT_NOT;
-                    break;
-                }
+    /* 2. Records asked for */
 
-            }
-            break;
-        case 0x7f: /* RAP or ACK */
-            if (buffin_str[1] == 0x84 && buffin_str[2] == 0x16)
-            {
-                for (i = 1; i < 150; i++)
-                {
-                    if (buffin_str[i] == 0x5f &&
-                            buffin_str[i + 1] == 0x81 &&
-                            buffin_str[i + 2] == 0x49 &&
-                            buffin_str[i + 3] == 0x01)
-                    {
-                        gsmainfo->ver = (int)buffin_str[i + 4];
-                    }
-
-                    if (buffin_str[i] == 0x5f &&
-                            buffin_str[i + 1] == 0x81 &&
-                            buffin_str[i + 2] == 0x3d &&
-                            buffin_str[i + 3] == 0x01)
-                    {
-                        gsmainfo->rel = (int)buffin_str[i + 4];
-                    }
-
-                    if (buffin_str[i] == 0x5f &&
-                            buffin_str[i + 1] == 0x84 &&
-                            buffin_str[i + 2] == 0x20 &&
-                            buffin_str[i + 3] == 0x01)
-                    {
-                        gsmainfo->rap_ver = (int)buffin_str[i + 4];
-                    }
-
-                    if (buffin_str[i] == 0x5f &&
-                            buffin_str[i + 1] == 0x84 &&
-                            buffin_str[i + 2] == 0x1f &&
-                            buffin_str[i + 3] == 0x01)
-                    {
-                        gsmainfo->rap_rel = (int)buffin_str[i + 4];
-                        *file_type =  FT_RAP;
-                        break;
-                    }
+    if (format == FMT_TEXT)
+        print_header(pr, ctx);
+    else if (format == FMT_ARROW && arrow_header(pr) != 0)
+        return -1;
+    else if (format != FMT_ARROW && columns != NULL)
+        csv_header(pr);
 
-                }
-            }
-            if (buffin_str[1] == 0x84 && buffin_str[2] == 0x17)
-            {
-                gsmainfo->rap_ver = 1; /* Ack files have no version */
-                gsmainfo->rap_rel = 5;
-                *file_type =  FT_ACK;
-            }
-            break;
-        default:
-            *file_type = FT_UNK;
+    if ( ( n = index_decode(&idx, ctx, rec_first, rec_last, handler, pr) ) == 0 )
+    {
+        if (rec_first == rec_last)
+            fprintf(stderr, "Record %d not found\n", rec_first);
+        else
+            fprintf(stderr, "Records %d to %d not found\n", rec_first, rec_last);
     }
 
-    return 0;
+    index_close(&idx);
+
+    return (n > 0 ? 0 : -1);
 }
 
+
 /****************************************************************************
 |* 
 |* Function: help
@@ -978,7 +634,58 @@ static int get_file_type(FILE* file, int *file_type, gsmainfo_t *gsmainfo)
 static void help(char *program_name)
 {
     fprintf(stderr, "Copyright (c) 2005-2018 Javier Gutierrez. (https://github.com/tap3edit/readasn)\n");
-    fprintf(stderr, "Usage: %s [-n] filename\n", program_name);
+    fprintf(stderr, "Usage: %s [-n] [-d depth] [-b size] [-j threads] [-l list] [-o dir] [-f path] [-F fmt]\n", program_name);
+    fprintf(stderr, "       [-c cols] [--index] [--record N] [--range A-B] [--stats] [--validate] [--dict F]\n");
+    fprintf(stderr, "       [--typed] [--totals]\n");
+    fprintf(stderr, "       filename|dir|- ...\n");
     fprintf(stderr, "  -n : Do not print default GSMA tagnames (TAP, RAP, NRT)\n");
+    fprintf(stderr, "  -d : Maximum nesting of constructed elements. Default: %d\n", MAXDEPTH);
+    fprintf(stderr, "  -b : Size of the output buffer (k, m suffixes allowed). Default: %d\n", OUTPUT_BUFF_SIZE);
+    fprintf(stderr, "  -j : Threads decoding the records of mapped files, or files at once\n");
+    fprintf(stderr, "       with several files. Default: 1\n");
+    fprintf(stderr, "  -l : File with the names of the files to decode, one per line (- for stdin)\n");
+    fprintf(stderr, "  -o : Directory of the dumps, one <file>.txt per file. Default: the\n");
+    fprintf(stderr, "       standard output, with the name of the file before each line\n");
+    fprintf(stderr, "  -f : Print only the elements at these tag paths, e.g.\n");
+    fprintf(stderr, "       TransferBatch/CallEventDetailList/*/**/Imsi. Steps: tag name or\n");
+    fprintf(stderr, "       number, * any element, ** any number of elements. Several\n");
+    fprintf(stderr, "       paths separated by commas or in several -f\n");
+    fprintf(stderr, "  -F : Format of the output: text (the dump, default), json (one\n");
+    fprintf(stderr, "       JSON object per line for each record), csv or tsv (one row per\n");
+    fprintf(stderr, "       record with the columns of -c), arrow (same columns in an\n");
+    fprintf(stderr, "       Apache Arrow IPC file)\n");
+    fprintf(stderr, "  -c : Columns of csv, tsv and arrow, e.g.\n");
+    fprintf(stderr, "       recno,record,Imsi:hex,ChargeableUnits.\n");
+    fprintf(stderr, "       A tag name or number (first element of the record with it, :text,\n");
+    fprintf(stderr, "       :int or :hex to force its format), recno, pos, record or file\n");
+    fprintf(stderr, "  --index    : Write the index of the records to <file>%s\n", INDEX_SUFFIX);
+    fprintf(stderr, "  --record N : Print only record N, found with the index (built if missing)\n");
+    fprintf(stderr, "  --range A-B: Print only records A to B (A- : to the end)\n");
+    fprintf(stderr, "  --stats    : Print only the number of elements, records and tags, their\n");
+    fprintf(stderr, "               sizes and the maximum depth. The values are not read\n");
+    fprintf(stderr, "  --validate : Only check the structure: trash bytes, lengths, truncation,\n");
+    fprintf(stderr, "               End of indefinite length, nesting. Prints nothing if valid.\n");
+    fprintf(stderr, "               Exit code: 0 valid, 2 tag, 3 size, 4 truncated, 5 length,\n");
+    fprintf(stderr, "               6 End of indefinite length, 7 trash, 8 nesting, 9 input\n");
+    fprintf(stderr, "  --dict F   : Name the tags with the dictionary F (written by asn2dict from\n");
+    fprintf(stderr, "               ASN.1 specifications) instead of the built-in names. The\n");
+    fprintf(stderr, "               dictionaries of several --dict are looked up in order. With\n");
+    fprintf(stderr, "               the schema of the first one, tags are named by the type of\n");
+    fprintf(stderr, "               their parent (context-specific and universal tags too)\n");
+    fprintf(stderr, "  --typed    : Typed values of TAP and NRT: Imsi and Msisdn as TBCD digits,\n");
+    fprintf(stderr, "               numbers as BCD digits, amounts with TapDecimalPlaces,\n");
+    fprintf(stderr, "               LocalTimeStamp as date and time without offset, and the\n");
+    fprintf(stderr, "               UtcTimeOffset (or UtcTimeOffsetCode) after it as the full\n");
+    fprintf(stderr, "               time stamp with the offset. After the value in the dump,\n");
+    fprintf(stderr, "               \"typed\" in json, instead of the value in columns without\n");
+    fprintf(stderr, "               conversion\n");
+    fprintf(stderr, "  --totals   : Print only the totals of the records (TAP, NRT, RAP): count,\n");
+    fprintf(stderr, "               duration, data volume and charge by service (TeleServiceCode,\n");
+    fprintf(stderr, "               BearerServiceCode or type of record), and charge and\n");
+    fprintf(stderr, "               chargeable units by service and ChargeType. They are checked\n");
+    fprintf(stderr, "               with the AuditControlInfo or count of the file: exit code 1\n");
+    fprintf(stderr, "               if they differ\n");
+    fprintf(stderr, "  -  : Read the file from stdin\n");
+    fprintf(stderr, "Files and pipes compressed with gzip, bzip2 or zstd are decompressed on the fly\n");
     exit (EXIT_FAILURE);
 }
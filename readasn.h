@@ -25,12 +25,43 @@
 |*
 |* When         Who     Pos     What
 |* 20120226     JG              Initial Version
+|* 20261016                     Input layer (memory mapped files)
+|* 20261016                     Streaming input (pipes and stdin)
+|* 20261016                     Frames for the iterative decoder
+|* 20261016                     Output layer
+|* 20261016                     Hexadecimal kernels
+|* 20261016                     Check of printable strings
+|* 20261016                     Tag name tables built at compile time
+|* 20261016                     Decoding library: context and callbacks
+|* 20261016                     Iterator over the elements
+|* 20261016                     Parallel decoding of the records
+|* 20261016                     Printer of the dump and batch mode
+|* 20261016                     Index of the records
+|* 20261016                     Filter of tag paths
+|* 20261016                     NDJSON output
+|* 20261016                     CSV and TSV output
+|* 20261016                     Apache Arrow output
+|* 20261016                     Statistics of the elements
+|* 20261016                     Strict checks and codes of the errors
+|* 20261016                     Decompression of the input
+|* 20261016                     Dictionaries of tag names compiled from ASN.1
+|* 20261016                     Names of the children by the type of the parent (schema)
+|* 20261016                     Typed values of TAP and NRT (TBCD, time stamps, amounts)
+|* 20261016                     Totals by service and charge type, checked with the audit
+|* 20261016                     Callback for the header of a primitive cut short (cut)
 |*
 ****************************************************************************/
 
 #ifndef _READASN_H_
 #define _READASN_H_
 
+/* 1. Includes */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+
 /* 2. Defines */
 
 #ifndef TRUE
@@ -51,6 +82,45 @@
     #define MAXTAGS 560
 #endif
 
+#ifndef MAXDEPTH
+    #define MAXDEPTH 256            /* Default maximum nesting of constructed elements */
+#endif
+
+#ifndef INPUT_RING_SIZE
+    #define INPUT_RING_SIZE 65536   /* Ring buffer for streams. Power of 2 */
+#endif
+
+#ifndef INPUT_LOOKBACK
+    #define INPUT_LOOKBACK 16       /* Bytes kept behind the cursor of streams */
+#endif
+
+#ifndef OUTPUT_BUFF_SIZE
+    #define OUTPUT_BUFF_SIZE 262144 /* Default size of the output buffer */
+#endif
+
+#define OUTPUT_MIN_SIZE 64          /* Minimum size of the output buffer */
+
+#ifndef PARALLEL_BATCH_SIZE
+    #define PARALLEL_BATCH_SIZE 262144 /* Bytes of records decoded at once by a thread */
+#endif
+
+#ifndef PRINT_CHUNK_SIZE
+    #define PRINT_CHUNK_SIZE 65536  /* Lines passed at once to a shared output */
+#endif
+
+#define PARALLEL_WINDOW 4           /* Batches per thread not written yet */
+#define PARALLEL_ERRORS 4           /* Errors kept per batch */
+#define POOL_REWIND 2               /* A record did not end where its length said */
+
+/* SIMD versions of the kernels */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define HEXA_X86 1
+#endif
+
+/* Kind of characters found by hexa_encode_check() */
+#define HEXA_NOPRINT 0x01   /* Some byte is not printable nor an End of Line */
+#define HEXA_EOL     0x02   /* Some byte is an End of Line (0x0a) */
+
 /* File type */
 #define FT_UNK 0x01     /* Unknown type of file */
 #define FT_TAP 0x02     /* Tap file */
@@ -59,6 +129,141 @@
 #define FT_RAP 0x05     /* RAP file */
 #define FT_ACK 0x06     /* Acknowledge file */
 
+/* Return of the callbacks of an asn1handler */
+#define ASN1_CONTINUE 0 /* Keep decoding */
+#define ASN1_STOP 1     /* Stop decoding. Also returned by asn1_decode() */
+
+/* Return of asn1_next() */
+#define ASN1_END   0    /* End of the input */
+#define ASN1_ELEM  1    /* Element found */
+#define ASN1_LEAVE 2    /* End of a constructed element: back to its parent */
+
+/* Errors of the decoding (asn1ctx.error). Also the exit codes of --validate */
+#define ASN1_ERR_TAG    2   /* Tag too long */
+#define ASN1_ERR_SIZE   3   /* Size too long */
+#define ASN1_ERR_TRUNC  4   /* End of file too soon */
+#define ASN1_ERR_LENGTH 5   /* Element longer than the constructed element around */
+#define ASN1_ERR_EOE    6   /* End of indefinite length missing or out of place */
+#define ASN1_ERR_TRASH  7   /* Trash bytes */
+#define ASN1_ERR_DEPTH  8   /* Nesting too deep */
+#define ASN1_ERR_IO     9   /* Error moving in the input */
+
+/* Input mode */
+#define IN_STDIO 0x01   /* Read through stdio */
+#define IN_MMAP  0x02   /* File mapped in memory */
+#define IN_STREAM 0x03  /* Pipe or stdin read through a ring buffer */
+
+/* Compression of the input */
+#define COMP_NONE  0x00
+#define COMP_GZIP  0x01
+#define COMP_BZIP2 0x02
+#define COMP_ZSTD  0x03
+
+#define INDEX_MAGIC "RAIX"      /* First bytes of the index of the records */
+#define INDEX_VERSION 1         /* Layout of the index. Also tells its byte order */
+#define INDEX_SUFFIX ".idx"     /* Name of the index: name of the file + suffix */
+
+#define DICT_MAGIC "RADC"       /* First bytes of a dictionary of tag names */
+#define DICT_VERSION 1          /* Layout of the dictionary. Also tells its byte order */
+#define DICT_MAX 8              /* Dictionaries given with --dict */
+
+#define SCHEMA_EMPTY 0xffffffffU /* Key of the free entries of a schema */
+#define SCHEMA_LIST  0x40000000U /* Flag of the type of a child: SEQUENCE OF or SET OF */
+
+/* Step of a filter path */
+#define STEP_TAG  0x01  /* Element with one of the tags */
+#define STEP_ANY  0x02  /* "*": any element */
+#define STEP_DEEP 0x03  /* "**": any number of elements, also none */
+#define STEP_END  0x04  /* After the last step: element selected */
+
+#define FILTER_MAX_STEPS 64 /* Steps of all the paths, one STEP_END each. Bits of a mask */
+#define FILTER_STEP_TAGS 8  /* Tags sharing a name */
+
+/* Classes a tag of a filter step or of a column matches: bit 1 << class */
+#define CLASSES_ANY   0x0f  /* Tag numbers, and names without a schema */
+#define CLASSES_NAMED 0x0e  /* Names of the tag map with a schema: not universal (see decode_name()) */
+
+/* Format of the output */
+#define FMT_TEXT 0x00   /* Dump */
+#define FMT_JSON 0x01   /* One JSON object per root record (NDJSON) */
+#define FMT_CSV  0x02   /* One row of columns per root record, separated by commas */
+#define FMT_TSV  0x03   /* Same, separated by tabs */
+#define FMT_ARROW 0x04  /* Same columns, in an Apache Arrow IPC file */
+
+#define CSV_MAX_COLS 64     /* Columns of a row */
+#define CSV_NAME_LEN 64     /* Name of a column */
+
+/* Column of a CSV/TSV row */
+#define COL_TAG    0x01 /* First primitive of the record with one of the tags */
+#define COL_RECNO  0x02 /* Record number */
+#define COL_POS    0x03 /* Position of the record */
+#define COL_RECORD 0x04 /* Name (or tag) of the record */
+#define COL_FILE   0x05 /* Name of the file */
+
+/* Conversion of the value of a column: name:conv */
+#define CONV_AUTO 0x00  /* None given: chosen by csv_bind() from the name of the tag */
+#define CONV_TEXT 0x01
+#define CONV_INT  0x02
+#define CONV_HEX  0x03
+
+/* Apache Arrow IPC file */
+#define ARROW_MAGIC      "ARROW1"
+#define ARROW_BATCH_ROWS 65536  /* Rows of a record batch */
+#define ARROW_INT64      0x01   /* Type of a column */
+#define ARROW_UTF8       0x02
+
+#define OPT_RECORD 256  /* Long options without short form */
+#define OPT_RANGE  257
+#define OPT_INDEX  258
+#define OPT_STATS  259
+#define OPT_VALIDATE 260
+#define OPT_DICT   261
+#define OPT_TYPED  262
+#define OPT_TOTALS 263
+
+/* Typed value of a primitive (--typed), by the name of its tag */
+#define TYPED_NONE     0x00
+#define TYPED_TBCD     0x01 /* Digits, the first one in the low nibble (Imsi, Msisdn) */
+#define TYPED_BCD      0x02 /* Digits, the first one in the high nibble (AddressStringDigits) */
+#define TYPED_STAMP    0x03 /* LocalTimeStamp: CCYYMMDDhhmmss */
+#define TYPED_OFFSET   0x04 /* UtcTimeOffset: +hhmm */
+#define TYPED_CODE     0x05 /* UtcTimeOffsetCode: UtcTimeOffset of the UtcTimeOffsetInfo */
+#define TYPED_AMOUNT   0x06 /* Integer with TapDecimalPlaces decimals */
+#define TYPED_DECIMALS 0x07 /* TapDecimalPlaces */
+
+#define TYPED_MAX_LEN  64   /* Longest typed value */
+#define TYPED_CODES    256  /* UtcTimeOffsetCodes kept */
+
+#define STATS_MIN_TAGS 256  /* Initial entries of the table of tags (power of 2) */
+
+/* Kind of a tag for --totals, by its name */
+#define TOT_NONE        0x00
+#define TOT_SENDER      0x01 /* Sender and Recipient of the file */
+#define TOT_RECIPIENT   0x02
+#define TOT_DECIMALS    0x03 /* TapDecimalPlaces */
+#define TOT_TELE        0x04 /* Service of the record and of the ChargeDetails after it */
+#define TOT_BEARER      0x05
+#define TOT_DETAIL      0x06 /* ChargeDetail: added up at its end */
+#define TOT_CHARGE_TYPE 0x07 /* Values of the ChargeDetail */
+#define TOT_CHARGE      0x08
+#define TOT_UNITS       0x09
+#define TOT_AMOUNT      0x0a /* Values of the record: NRT ChargeAmount */
+#define TOT_DURATION    0x0b
+#define TOT_VOLUME      0x0c
+#define TOT_TAX         0x0d /* Values of the file, checked with the audit */
+#define TOT_DISCOUNT    0x0e
+#define TOT_AUDIT       0x10 /* + AUDIT_*: value declared by the file */
+
+/* Values of the file checked against the ones it declares */
+#define AUDIT_COUNT     0    /* Records */
+#define AUDIT_CHARGE    1    /* Charges of ChargeType 00 and NRT ChargeAmounts */
+#define AUDIT_TAX       2
+#define AUDIT_DISCOUNT  3
+#define AUDIT_MAX       4
+
+#define TOTALS_MIN_GROUPS 64 /* Initial entries of the table of groups (power of 2) */
+#define TOTALS_NAME_LEN 16   /* Sender and Recipient */
+
 
 /* 3. Typedefs and structures */
 
@@ -68,8 +273,8 @@ typedef struct _asn1item
     unsigned    class: 2;       /* Class */
     unsigned    pc: 1;          /* Primitive/Constructed */
     int         tag;            /* Tag: decimal format */
-    uchar       tag_x[4];       /* Tag: bcd format */
-    char        tag_h[9];       /* Tag: hexadecimal string format */
+    uchar       tag_x[5];       /* Tag: bcd format */
+    char        tag_h[11];      /* Tag: hexadecimal string format */
     int         tag_l;          /* Tag: number of bytes in file */
     long        size;           /* Size: decimal format */
     uchar       size_x[8];      /* Size: bcd format */
@@ -85,9 +290,681 @@ typedef struct _gsmainfo_t
     int         rap_rel;        /* RAP File release */
 } gsmainfo_t;
 
+typedef struct _tagmap_t
+{
+    const unsigned int* idx;    /* Offset of the name of each tag in names. 0: no name */
+    const char*         names;  /* Names one after the other, starting with "" */
+    int                 ntags;  /* Number of entries of idx */
+    const struct _tagmap_t* next; /* Map to look up tags without name in this one */
+} tagmap_t;
+
+typedef struct _schemaent
+{
+    unsigned int type;          /* Type of the parent in the schema. 0: top level */
+    unsigned int key;           /* Class and tag of the child (schema_key). SCHEMA_EMPTY: free */
+    unsigned int name;          /* Offset of the name of the child. 0: no name */
+    unsigned int child;         /* Type of the child, if constructed, and SCHEMA_LIST. 0: unknown */
+} schemaent;
+
+typedef struct _asn1schema
+{
+    const schemaent* ents;      /* Hash table of (type, key): mask + 1 entries */
+    unsigned int mask;
+    const char* names;          /* Names of the tagmap_t of the same dictionary */
+} asn1schema;
+
+typedef struct _asn1frame
+{
+    long        size;           /* Size left to decode */
+    long        loc_pos;        /* Position of the element being decoded */
+    int         recno;          /* Root Record number */
+    int         depth;          /* Depth in which we are (to print) */
+    int         is_indef;       /* Flag indicating if encoding is indefinite */
+    int         is_root;        /* Flag indicating if it's the root of the encoding */
+    int         is_eoe;         /* Flag indicating the End of indefinite length was found */
+    asn1item    item;           /* Constructed element being decoded */
+    unsigned long long match;   /* Steps of the filter which can match the children */
+    int         is_selected;    /* Selected by the filter: all the children are */
+    int         type;           /* Type in the schema of the constructed element. 0: unknown */
+} asn1frame;
+
+typedef struct _asn1decomp asn1decomp; /* Decompressor (decompress.c) */
+
+typedef struct _asn1input
+{
+    int         mode;           /* Input mode: IN_STDIO, IN_MMAP, IN_STREAM */
+    FILE*       file;           /* File handler (IN_STDIO) */
+    const uchar* map;           /* Mapped file (IN_MMAP) */
+    int         fd;             /* File descriptor (IN_STREAM) */
+    uchar*      ring;           /* Ring buffer (IN_STREAM) */
+    long        head;           /* Position after the last byte in ring (IN_STREAM) */
+    int         eof;            /* End of stream reached (IN_STREAM) */
+    long        len;            /* Size of the input. -1 if unknown */
+    long        pos;            /* Current position in the input */
+    uchar*      buff;           /* Buffer where values are read (IN_STDIO, IN_STREAM) */
+    long        buff_len;       /* Allocated size of buff */
+    int         is_view;        /* Shares the mapping of another input */
+    asn1decomp* decomp;         /* Decompressor filling the ring. NULL: not compressed */
+} asn1input;
+
+typedef struct _asn1output
+{
+    int         fd;             /* File descriptor where to write */
+    char*       buff;           /* Buffer */
+    long        size;           /* Size of the buffer */
+    long        len;            /* Bytes used in the buffer */
+    int         is_tty;         /* Flush at every end of line */
+} asn1output;
+
+typedef struct _asn1idxentry
+{
+    long long   pos;            /* Position of the record in the file */
+    unsigned int size;          /* Size of the record, header included */
+    int         recno;          /* Record number */
+    unsigned int tag;           /* Tag of the record */
+    unsigned short depth;       /* Depth of the record */
+    unsigned short reserved;
+} asn1idxentry;
+
+typedef struct _asn1idxhead
+{
+    char        magic[4];       /* INDEX_MAGIC */
+    unsigned int version;       /* INDEX_VERSION */
+    long long   file_size;      /* Size of the file indexed */
+    long long   file_mtime;     /* Modification time of the file indexed */
+    long long   count;          /* Number of records */
+} asn1idxhead;
+
+typedef struct _asn1index
+{
+    asn1idxentry* entries;      /* Root records in the order of the file */
+    long        n;              /* Number of entries */
+    long        alloc;          /* Allocated entries. 0: entries are mapped */
+    void*       map;            /* Mapped index file */
+    long        map_len;
+} asn1index;
+
+typedef struct _asn1dicthead
+{
+    char        magic[4];       /* DICT_MAGIC */
+    unsigned int version;       /* DICT_VERSION */
+    unsigned int ntags;         /* Entries of the index, after the header */
+    unsigned int names_len;     /* Bytes of the names, after the index. Multiple of 4 */
+    unsigned int nents;         /* Entries of the schema, after the names. 0: no schema */
+} asn1dicthead;
+
+typedef struct _asn1dict
+{
+    tagmap_t    tagmap;         /* Index and names in the mapping */
+    asn1schema  schema;         /* Schema in the mapping. ents NULL: none */
+    void*       map;            /* Mapped dictionary file */
+    long        map_len;
+} asn1dict;
+
+typedef struct _jsonnode
+{
+    int         tag;            /* Tag of the element */
+    int         class;          /* Class of the element */
+    const char* name;           /* Name of the tag. NULL if unknown */
+    int         is_cons;        /* Constructed element */
+    int         is_seqof;       /* List (SEQUENCE OF): its children are always in arrays */
+    int         parent;         /* Constructed element around. -1: none */
+    int         first;          /* First child with a tag of its own. -1: none */
+    int         last;           /* Last child with a tag of its own */
+    int         next;           /* Next sibling with a tag of its own */
+    int         next_same;      /* Next sibling with the same class and tag. -1: none */
+    int         last_same;      /* Last sibling with the same class and tag (first of them) */
+    int         head;           /* First sibling with the same class and tag */
+    long        val;            /* Value of primitives in jsonunit.vals */
+    long        vlen;
+} jsonnode;
+
+typedef struct _jsonunit
+{
+    jsonnode*   nodes;          /* Elements of the record being built */
+    int         n;
+    int         alloc;
+    int         cur;            /* Constructed element open. -1: no record */
+    long        pos;            /* Position of the record */
+    int         recno;          /* Record number */
+    asn1output  vals;           /* Values of the primitives, already in JSON */
+} jsonunit;
+
+typedef struct _csvcol
+{
+    int         kind;           /* COL_TAG, COL_RECNO, ... */
+    int         conv;           /* CONV_AUTO, CONV_TEXT, ... */
+    int         is_auto;        /* No conversion given: conv chosen by csv_bind() */
+    int         ntags;          /* Tags of COL_TAG, once bound to a tag map */
+    int         tags[FILTER_STEP_TAGS];
+    int         classes[FILTER_STEP_TAGS]; /* Classes of each tag, as in asn1step */
+    char        name[CSV_NAME_LEN]; /* Name in the header: tag name or number */
+} csvcol;
+
+typedef struct _csvcols
+{
+    csvcol      cols[CSV_MAX_COLS];
+    int         ncols;
+    char        sep;            /* ',' or '\t' */
+} csvcols;
+
+typedef struct _csvrow
+{
+    int         depth;          /* Depth of the record being read. -1: none */
+    long        pos;            /* Position of the record */
+    int         recno;          /* Record number */
+    int         tag;            /* Tag of the record */
+    const char* name;           /* Name of the tag of the record */
+    long        val[CSV_MAX_COLS]; /* Value of each column in vals. -1: not found */
+    long        vlen[CSV_MAX_COLS];
+    asn1output  vals;           /* Values of the columns, not escaped */
+} csvrow;
+
+typedef struct _arrowcol
+{
+    int         type;           /* ARROW_INT64 or ARROW_UTF8 */
+    long        nulls;          /* Rows of the batch without value */
+    asn1output  valid;          /* Validity bitmap */
+    asn1output  offsets;        /* Offsets of the strings (int32), rows + 1 */
+    asn1output  data;           /* Values: int64 or the bytes of the strings */
+} arrowcol;
+
+typedef struct _arrowblock
+{
+    long long   offset;         /* Position of the message in the file */
+    int         meta_len;       /* Size of its metadata, prefix included */
+    long long   body_len;       /* Size of its body */
+} arrowblock;
+
+typedef struct _arrowfile
+{
+    arrowcol*   cols;           /* One per column of the printer */
+    int         ncols;
+    long        rows;           /* Rows of the batch being built */
+    long long   pos;            /* Bytes written to the output */
+    arrowblock* blocks;         /* Record batches written, for the footer */
+    int         nblocks;
+    int         ablocks;
+    asn1output  fb;             /* Flatbuffer being built */
+} arrowfile;
+
+typedef struct _typedtag
+{
+    const char* name;           /* Name of the tag in the tag map */
+    int         kind;           /* TYPED_* (--typed) or TOT_* (--totals) */
+} typedtag;
+
+typedef struct _asn1typed
+{
+    typedtag*   tags;           /* Kind of each tag of the tag map. Shared by the copies */
+    int         ntags;
+    int         decimals;       /* TapDecimalPlaces. -1: not found yet */
+    long        stamp_end;      /* End of the last LocalTimeStamp. -1: none */
+    char        stamp[20];      /* Its value: CCYY-MM-DDThh:mm:ss */
+    long        code_end;       /* End of the last UtcTimeOffsetCode. -1: none */
+    int         code;
+    char        offsets[TYPED_CODES][8]; /* UtcTimeOffset of each code: +hh:mm. "": unknown */
+} asn1typed;
+
+typedef struct _tagstats
+{
+    unsigned long long key;     /* Tag, class and pc (see stats_key()) */
+    long        count;          /* Elements with the key. 0: free entry */
+    long        min;            /* Size of their values */
+    long        max;
+    long long   total;
+} tagstats;
+
+typedef struct _asn1stats
+{
+    tagstats*   tags;           /* Hash table of the tags found */
+    int         ntags;
+    int         atags;          /* Entries of tags: a power of 2 */
+    long        prims;          /* Primitive elements */
+    long        conss;          /* Constructed elements */
+    long        eoes;           /* End of indefinite length markers */
+    long        records;        /* Root records */
+    long        rec_min;        /* Size of the root records, header included */
+    long        rec_max;
+    long long   rec_total;
+    int         max_depth;      /* Depth of the deepest element. Top of the file: 1 */
+    long*       starts;         /* Position of the value of the constructed open, by depth */
+    int         nstarts;
+} asn1stats;
+
+typedef struct _totgroup
+{
+    unsigned long long key;     /* Service and ChargeType (0: the service). 0: free entry */
+    long        events;         /* Records of the service, or ChargeDetails */
+    long long   duration;       /* Of the records */
+    long long   volume;
+    long long   charge;         /* ChargeType 00 and ChargeAmount of the service, or Charge */
+    long long   units;          /* ChargeableUnits of the ChargeDetails */
+} totgroup;
+
+typedef struct _asn1totals
+{
+    typedtag*   tags;           /* Kind of each tag of the tag map */
+    int         ntags;
+    totgroup*   groups;         /* Hash table of the services and charge types */
+    int         ngroups;
+    int         agroups;        /* Entries of groups: a power of 2 */
+    int         decimals;       /* TapDecimalPlaces. -1: unknown */
+    char        sender[TOTALS_NAME_LEN];
+    char        recipient[TOTALS_NAME_LEN];
+    long        records;        /* Root records */
+    int         rec_depth;      /* Depth of the record being read. -1: none */
+    unsigned long long rec_service; /* Its first service. 0: none yet */
+    unsigned long long service; /* Last service found, or the type of record */
+    long long   duration;       /* Values of the record */
+    long long   volume;
+    long long   amount;
+    unsigned long long charge_type; /* Values of the ChargeDetail being read */
+    long long   charge;
+    long long   units;
+    long long   computed[AUDIT_MAX]; /* Values added up */
+    long long   declared[AUDIT_MAX]; /* Values declared by the file */
+    const char* audit_names[AUDIT_MAX]; /* Names of the ones declared. NULL: not found */
+} asn1totals;
+
+typedef struct _asn1printer
+{
+    asn1output* out;            /* Output of the dump */
+    int         use_tagnames;   /* Print the names of the tags */
+    const char* tag;            /* Printed at the beginning of each line. NULL: nothing */
+    const char* name;           /* Printed before the errors. NULL: nothing */
+    const char* file;           /* Name of the input, for the file column. "-": stdin */
+    asn1output* shared;         /* Output shared by several printers. NULL: only out */
+    pthread_mutex_t* lock;      /* Lock of shared */
+    jsonunit*   json;           /* Record being built by json_handler. NULL: none yet */
+    const csvcols* cols;        /* Columns of csv_handler */
+    csvrow*     row;            /* Row being filled by csv_handler. NULL: none yet */
+    arrowfile*  arrow;          /* Columns of the rows of FMT_ARROW. NULL: text rows */
+    asn1typed*  typed;          /* Typed values of the primitives. NULL: none */
+} asn1printer;
+
+typedef struct _batchopts
+{
+    int         nthreads;       /* Files decoded at once */
+    int         max_depth;      /* Maximum nesting of constructed elements */
+    int         use_tagnames;   /* Print the names of the tags */
+    long        out_size;       /* Size of the output buffers */
+    const char* outdir;         /* Directory of the dumps. NULL: tagged lines to out */
+    const char* filter;         /* Tag paths to print. NULL: all */
+    int         format;         /* FMT_TEXT, FMT_JSON, FMT_CSV, FMT_TSV, FMT_ARROW */
+    const csvcols* cols;        /* Columns of FMT_CSV, FMT_TSV and FMT_ARROW, not bound yet */
+    const tagmap_t* tagmap;     /* Names of the dictionaries. NULL: the ones of each file */
+    const asn1schema* schema;   /* Schema of the dictionaries. NULL: none */
+    int         typed;          /* Typed values of the primitives */
+    asn1output* out;            /* Output shared by the files */
+} batchopts;
+
+
+typedef struct _asn1event
+{
+    const asn1item* item;       /* Tag and size of the element */
+    const uchar* value;         /* Value of primitives. Valid only during the callback */
+    const char* name;           /* Name of the tag. NULL if unknown */
+    long        pos;            /* Position of the element (of its end for end_cons) */
+    long        vpos;           /* Position of the value */
+    int         depth;          /* Depth of the element */
+    int         recno;          /* Root Record number */
+    int         is_eoe;         /* The element is an End of indefinite length (primitive) */
+    int         is_record;      /* The element is a root record */
+    int         is_list;        /* The element is a list of root records */
+    int         is_seqof;       /* Constructed element which is a list: SEQUENCE OF or SET OF */
+    int         is_cut;         /* Primitive cut short by the end of the input: no value */
+} asn1event;
+
+typedef struct _asn1handler
+{
+    int       (*start_cons)(void *user, const asn1event *ev); /* Header of a constructed element */
+    int       (*primitive)(void *user, const asn1event *ev);  /* Primitive element with its value */
+    int       (*end_cons)(void *user, const asn1event *ev);   /* End of a constructed element */
+    void      (*error)(void *user, long pos, const char *msg); /* Error decoding. NULL: stderr */
+    void      (*cut)(void *user, const asn1event *ev);        /* Primitive cut short, after its error. NULL: none */
+} asn1handler;
+
+typedef struct _asn1step
+{
+    int         kind;           /* STEP_TAG, STEP_ANY, STEP_DEEP, STEP_END */
+    int         ntags;          /* Tags of STEP_TAG */
+    int         tags[FILTER_STEP_TAGS];
+    int         classes[FILTER_STEP_TAGS]; /* Classes of each tag: CLASSES_* or bits 1 << class */
+} asn1step;
+
+typedef struct _asn1filter
+{
+    asn1step    steps[FILTER_MAX_STEPS]; /* Steps of the paths one after the other */
+    int         nsteps;
+    unsigned long long start;   /* Steps which can match the elements of the top */
+    unsigned long long accept;  /* STEP_END of each path */
+} asn1filter;
+
+typedef struct _asn1ctx
+{
+    asn1input   in;             /* Input being decoded */
+    long        pos;            /* Current position in the input */
+    asn1frame*  frames;         /* Stack of frames of the decoder */
+    int         top;            /* Frame of the current constructed element */
+    asn1item    item;           /* Last element found */
+    int         is_pending;     /* Last element is a constructed neither entered nor skipped */
+    int         is_done;        /* Last element finished: to account in its frame */
+    int         is_empty;       /* Empty constructed entered: its end comes next */
+    int         max_depth;      /* Maximum nesting of constructed elements */
+    int         file_type;      /* FT_TAP, FT_NRT, ... */
+    gsmainfo_t  gsmainfo;       /* Version and release of the file */
+    const tagmap_t* tagmap;     /* Names of the tags. NULL if unknown */
+    tagmap_t    rap_tagmap;     /* RAP names, chained to the TAP ones */
+    const tagmap_t* listmap;    /* Names telling the lists ("...List"), also without tag names */
+    const asn1schema* schema;   /* Names of the children by the type of the parent. NULL: none */
+    int         item_type;      /* Type in the schema of the last element found, and SCHEMA_LIST */
+    const asn1handler* handler; /* Callbacks of the decoding */
+    void*       user;           /* First argument of the callbacks */
+    const asn1filter* filter;   /* Elements to return to the callbacks. NULL: all */
+    int         no_values;      /* Values of the primitives jumped over, not read */
+    int         strict;         /* Errors on trash bytes, lengths and EoE out of place */
+    int         error;          /* ASN1_ERR_* of the first error. 0: none */
+    long        error_pos;      /* Position of the first error */
+} asn1ctx;
+
+
+typedef struct _precord
+{
+    long        pos;            /* Position of the record */
+    long        size;           /* Size of the record: tag, size and value */
+    int         depth;          /* Depth of the record */
+    int         recno;          /* Root Record number */
+    int         type;           /* Type in the schema of the list of the record */
+} precord;
+
+typedef struct _perrors
+{
+    int         n;              /* Number of errors */
+    long        pos[PARALLEL_ERRORS];
+    char        msg[PARALLEL_ERRORS][256];
+} perrors;
+
+typedef struct _pbatch
+{
+    asn1printer pr;             /* Printer of the records. First: user of the callbacks */
+    asn1output  out;            /* Output of the records */
+    precord*    recs;           /* Records to decode */
+    int         nrecs;          /* Number of records */
+    int         arecs;          /* Allocated records */
+    long        bytes;          /* Size of the records */
+    int         is_done;        /* Decoded by a thread */
+    int         rc;             /* Return of the decoding */
+    long        next_pos;       /* Real end of the last record decoded if not its length. -1 otherwise */
+    int         next_recno;     /* Record number at next_pos */
+    perrors     errs;           /* Errors found */
+    asn1typed   typed;          /* Typed values: state of the main printer when the batch began */
+} pbatch;
+
+typedef struct _pworker
+{
+    struct _ppool* pool;        /* Pool of the thread */
+    asn1ctx     view;           /* View of the file of the thread */
+} pworker;
+
+typedef struct _ppool
+{
+    asn1ctx*    ctx;            /* Context of the main thread */
+    const asn1handler* out_handler; /* Handler received */
+    asn1handler handler;        /* Handler of the threads: errors kept in the batches */
+    asn1handler main_handler;   /* Handler of the main thread: errors kept in errs */
+    perrors     errs;           /* Errors of the main thread */
+    pthread_t*  threads;        /* Threads started */
+    int         nthreads;
+    pworker*    workers;        /* Arguments of the threads */
+    int         nworkers;
+    pbatch*     batches;        /* Ring of batches */
+    int         nbatches;
+    long        queued;         /* Batches given to the threads */
+    long        taken;          /* Batches taken by the threads */
+    long        written;        /* Batches written */
+    int         top;            /* Frame of the records queued */
+    long        next_pos;       /* Where to go on after POOL_REWIND */
+    int         next_recno;
+    int         quit;           /* Threads have to finish */
+    pthread_mutex_t lock;
+    pthread_cond_t work;        /* A batch was queued or quit */
+    pthread_cond_t done;        /* A batch was decoded */
+} ppool;
+
+
+extern const tagmap_t nrt0201_tagname_map;     /* NRT */
+extern const tagmap_t rap01XX_tagname_map;     /* All releases of RAP 01 */
+extern const tagmap_t tap03le09_tagname_map;   /* All releases of TAP less and equal to 09 */
+extern const tagmap_t tap03ge10_tagname_map;   /* All releases of TAP greater and equal to 10 */
+
+int             asn1_open       (asn1ctx *ctx, const char *filename, int max_depth);
+int             asn1_open_view  (asn1ctx *ctx, const asn1ctx *parent);
+int             asn1_range      (asn1ctx *ctx, long pos, long size, int depth, int recno);
+int             asn1_rewind     (asn1ctx *ctx, int top, long pos, int recno);
+void            asn1_close      (asn1ctx *ctx);
+void            asn1_filter     (asn1ctx *ctx, const asn1filter *flt);
+void            asn1_no_values  (asn1ctx *ctx, int no_values);
+void            asn1_strict     (asn1ctx *ctx, int strict);
+void            asn1_tagmap     (asn1ctx *ctx, const tagmap_t *map);
+void            asn1_schema     (asn1ctx *ctx, const asn1schema *schema);
+int             asn1_decode     (asn1ctx *ctx, const asn1handler *handler, void *user);
+const char*     asn1_tagname    (const asn1ctx *ctx, int tag);
+int             asn1_next       (asn1ctx *ctx, asn1event *ev);
+int             asn1_enter      (asn1ctx *ctx);
+int             asn1_skip       (asn1ctx *ctx);
+
+/* Decoders of the headers: internal to decode.c, also for bench/decode_bench.c */
+int             decode_tag      (asn1ctx *ctx, asn1item *a_item);
+int             decode_size     (asn1ctx *ctx, asn1item *a_item);
+void            bcd_2_hexa      (char *str2, const uchar *str1, const int len);
+
+int             index_build     (asn1index *idx, asn1ctx *ctx);
+int             index_load      (asn1index *idx, const char *filename);
+int             index_save      (const asn1index *idx, const char *filename);
+void            index_close     (asn1index *idx);
+
+int             dict_save       (const tagmap_t *map, long names_len, const schemaent *ents, unsigned int nents, const char *filename);
+int             dict_load       (asn1dict *dict, const char *filename, const tagmap_t *next);
+void            dict_close      (asn1dict *dict);
+long            index_find      (const asn1index *idx, int recno);
+int             index_decode    (asn1index *idx, asn1ctx *ctx, int first, int last, const asn1handler *handler, void *user);
+
+int             filter_compile  (asn1filter *flt, const char *expr, const tagmap_t *map, const asn1schema *schema);
+unsigned long long filter_next  (const asn1filter *flt, unsigned long long match, int class, int tag);
+int             filter_lookup   (const tagmap_t *map, const asn1schema *schema, const char *name, int len, int *tags, int *classes, int max);
+
+int             input_open      (asn1input *in, const char *filename);
+int             input_view      (asn1input *view, const asn1input *in);
+void            input_close     (asn1input *in);
+long            input_peek      (asn1input *in, uchar *str, long len);
+const uchar*    input_read      (asn1input *in, long len);
+int             input_seek      (asn1input *in, long pos);
+int             input_eof       (asn1input *in);
+int             input_fill_getc (asn1input *in);
+
+int             typed_init      (asn1typed *ty, const asn1ctx *ctx);
+void            typed_close     (asn1typed *ty);
+long            typed_value     (asn1typed *ty, const asn1event *ev, char *dst);
+long            typed_tbcd      (char *dst, const uchar *src, long len);
+long            typed_bcd       (char *dst, const uchar *src, long len);
+
+int             decompress_detect(const uchar *magic, long len);
+int             decompress_open (asn1input *in, int kind, const uchar *map, int fd, const uchar *pending, long len);
+long            decompress_read (asn1input *in, uchar *dst, long room);
+void            decompress_close(asn1input *in);
+
+extern void   (*hexa_encode_wide)(char *dst, const uchar *src, long len);
+extern int    (*hexa_encode_check_wide)(char *dst, const uchar *src, long len);
+void            hexa_init       (void);
+void            hexa_encode_scalar(char *dst, const uchar *src, long len);
+int             hexa_encode_check_scalar(char *dst, const uchar *src, long len);
+#ifdef HEXA_X86
+void            hexa_encode_sse2(char *dst, const uchar *src, long len);
+void            hexa_encode_avx2(char *dst, const uchar *src, long len);
+int             hexa_encode_check_sse2(char *dst, const uchar *src, long len);
+int             hexa_encode_check_avx2(char *dst, const uchar *src, long len);
+#endif
+
+int             output_init     (asn1output *out, int fd, long size);
+int             output_close    (asn1output *out);
+int             output_flush    (asn1output *out);
+void            output_write    (asn1output *out, const char *str, long len);
+void            output_printf   (asn1output *out, const char *format, ...);
+void            output_indent   (asn1output *out, int depth);
+void            output_zdec     (asn1output *out, unsigned long val, int width);
+void            output_dec      (asn1output *out, long long val);
+void            output_hexa     (asn1output *out, const uchar *str, long len);
+void            output_text_hexa(asn1output *out, const uchar *str, long len);
+
+extern const asn1handler print_handler;
+void            print_header    (asn1printer *pr, const asn1ctx *ctx);
+void            print_flush     (asn1printer *pr);
+void            print_eol       (asn1printer *pr);
+void            print_close     (asn1printer *pr);
+void            print_error     (void *user, long pos, const char *msg);
+
+extern const asn1handler json_handler;
+void            json_close      (asn1printer *pr);
+
+extern const asn1handler csv_handler;
+int             csv_compile     (csvcols *cols, const char *spec, char sep);
+int             csv_bind        (csvcols *cols, const tagmap_t *map, const asn1schema *schema);
+void            csv_header      (asn1printer *pr);
+void            csv_close       (asn1printer *pr);
+
+extern const asn1handler stats_handler;
+int             stats_init      (asn1stats *st, const asn1ctx *ctx);
+void            stats_print     (const asn1stats *st, asn1output *out, const asn1ctx *ctx);
+void            stats_close     (asn1stats *st);
+
+extern const asn1handler totals_handler;
+int             totals_init     (asn1totals *tt, const asn1ctx *ctx);
+int             totals_print    (asn1totals *tt, asn1output *out, const asn1ctx *ctx);
+void            totals_close    (asn1totals *tt);
+
+int             arrow_header    (asn1printer *pr);
+void            arrow_row       (asn1printer *pr);
+void            arrow_close     (asn1printer *pr);
+
+int             decode_parallel (asn1ctx *ctx, const asn1handler *handler, asn1printer *pr, int nthreads);
+
+int             batch_run       (char **names, int nnames, const char *list, const batchopts *opts);
+
+
+/* 4. Inline functions */
+
+/* Next byte of the input or EOF. Called once per header octet. */
+static inline int input_getc(asn1input *in)
+{
+    int         c;
+
+    if (in->mode == IN_MMAP)
+        return in->pos < in->len ? (int)in->map[in->pos++] : EOF;
+
+    if (in->mode == IN_STREAM)
+        return in->pos < in->head
+            ? (int)in->ring[in->pos++ & (INPUT_RING_SIZE - 1)]
+            : input_fill_getc(in);
+
+    if ( ( c = getc(in->file) ) != EOF)
+        in->pos++;
+
+    return c;
+}
+
+/* Name of a tag or NULL if unknown. Maps chained with next are looked up in order */
+static inline const char *tagmap_name(const tagmap_t *map, int tag)
+{
+    for (; map != NULL; map = map->next)
+    {
+        if (tag >= 0 && tag < map->ntags && map->idx[tag] != 0)
+            return map->names + map->idx[tag];
+    }
+
+    return NULL;
+}
+
+/* Key of the class and tag of an element in a schema */
+static inline unsigned int schema_key(int class, int tag)
+{
+    return ((unsigned int)class << 30) | ((unsigned int)tag & 0x3fffffffU);
+}
+
+/* Slot of (type, key) in a schema of mask + 1 entries */
+static inline unsigned int schema_hash(unsigned int type, unsigned int key, unsigned int mask)
+{
+    unsigned int    h = type * 0x9e3779b1U ^ key * 0x85ebca77U;
+
+    return (h ^ (h >> 15)) & mask;
+}
+
+/* Entry of the child of class and tag of an element of type, or NULL */
+static inline const schemaent *schema_find(const asn1schema *schema, int type, int class, int tag)
+{
+    unsigned int    key = schema_key(class, tag);
+    unsigned int    i = schema_hash((unsigned int)type, key, schema->mask);
+    const schemaent* e = NULL;
+
+    for (;; i = (i + 1) & schema->mask)
+    {
+        e = &schema->ents[i];
+        if (e->key == SCHEMA_EMPTY)
+            return NULL;
+        if (e->key == key && e->type == (unsigned int)type)
+            return e;
+    }
+}
+
+/* Bytes to hexadecimal. Short strings are not worth the SIMD set up */
+static inline void hexa_encode(char *dst, const uchar *src, long len)
+{
+    if (len < 16)
+        hexa_encode_scalar(dst, src, len);
+    else
+        hexa_encode_wide(dst, src, len);
+}
+
+/* Bytes to hexadecimal (dst can be NULL), checking the kind of characters */
+static inline int hexa_encode_check(char *dst, const uchar *src, long len)
+{
+    if (len < 16)
+        return hexa_encode_check_scalar(dst, src, len);
+    else
+        return hexa_encode_check_wide(dst, src, len);
+}
+
+/* Is a string printable according to the flags of hexa_encode_check()?
+ * Note: sometimes they send an End of Line (0A) in the RAP comments. We
+ * only accept them if the message is long enough. Let's say: 7 */
+static inline int hexa_printable(int flags, long len)
+{
+    return !(flags & HEXA_NOPRINT) && !((flags & HEXA_EOL) && len < 7);
+}
+
+/* Appends one character to the output buffer */
+static inline void output_putc(asn1output *out, char c)
+{
+    if (out->len == out->size)
+        (void)output_flush(out);
+
+    out->buff[out->len++] = c;
+}
+
+/* Appends a string to the output buffer */
+static inline void output_puts(asn1output *out, const char *str)
+{
+    output_write(out, str, (long)strlen(str));
+}
+
+/* Ends a line of the output */
+static inline void output_eol(asn1output *out)
+{
+    output_putc(out, '\n');
 
-void            tagid_init      (void);
-int             merge_tap_rapids(char tap_tagname_map[MAXTAGS][MAXLEN], char rap_tagname_map[MAXTAGS][MAXLEN]);
+    if (out->is_tty)
+        (void)output_flush(out);
+}
 
 #endif
 
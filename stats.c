@@ -0,0 +1,483 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: stats.c
+|*
+|* Description: Statistics of a file instead of its dump (--stats): number
+|*              of elements, of root records and their sizes, maximum
+|*              depth, and for each tag the number of elements and the
+|*              minimum, maximum and total size of their values. Only the
+|*              tags and sizes are needed, so the file is decoded with
+|*              asn1_no_values(): the values are jumped over.
+|*
+|*              The tags are counted in a hash table of open addressing,
+|*              keyed by tag, class and primitive/constructed, and sorted
+|*              by tag when printed.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Prototypes */
+
+static int      stats_start_cons(void *user, const asn1event *ev);
+static int      stats_primitive (void *user, const asn1event *ev);
+static int      stats_end_cons  (void *user, const asn1event *ev);
+static int      stats_tag       (asn1stats *st, const asn1item *item, long size);
+static int      stats_grow      (asn1stats *st);
+static unsigned long long stats_key(const asn1item *item);
+static int      cmp_tags        (const void *a, const void *b);
+
+
+/* 3. Global Variables */
+
+const asn1handler stats_handler =               /* Callbacks counting the elements */
+{
+    stats_start_cons,
+    stats_primitive,
+    stats_end_cons,
+    NULL,
+    NULL
+};
+
+static const char* class_names[] =              /* Classes of the tags */
+{
+    "univ", "appl", "ctx", "priv"
+};
+
+
+/****************************************************************************
+|*
+|* Function: stats_init
+|*
+|* Description;
+|*
+|*     Empty statistics for the decoding of ctx
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int stats_init(asn1stats *st, const asn1ctx *ctx)
+{
+    memset(st, 0x00, sizeof(*st));
+
+    st->atags = STATS_MIN_TAGS;
+    st->nstarts = ctx->max_depth + 1;
+
+    if ( ( st->tags = (tagstats *)calloc((size_t)st->atags, sizeof(tagstats)) ) == NULL ||
+            ( st->starts = (long *)calloc((size_t)st->nstarts, sizeof(long)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the statistics\n");
+        stats_close(st);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_start_cons
+|*
+|* Description;
+|*
+|*     Counts a constructed element. Its size is known at its end, also
+|*     if it has indefinite length.
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int stats_start_cons(void *user, const asn1event *ev)
+{
+    asn1stats*      st = (asn1stats *)user;
+
+    st->conss++;
+
+    if (ev->depth < st->nstarts)
+        st->starts[ev->depth] = ev->vpos;
+
+    if (ev->depth + 1 > st->max_depth)
+        st->max_depth = ev->depth + 1;
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_primitive
+|*
+|* Description;
+|*
+|*     Counts a primitive element with the size of its value
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int stats_primitive(void *user, const asn1event *ev)
+{
+    asn1stats*      st = (asn1stats *)user;
+    const asn1item* item = ev->item;
+    long            size = item->tag_l + item->size_l + item->size;
+
+    if (ev->is_eoe)
+    {
+        st->eoes++;
+        return ASN1_CONTINUE;
+    }
+
+    st->prims++;
+
+    if (ev->depth + 1 > st->max_depth)
+        st->max_depth = ev->depth + 1;
+
+    if (ev->is_record)
+    {
+        if (st->records == 0 || size < st->rec_min)
+            st->rec_min = size;
+        if (size > st->rec_max)
+            st->rec_max = size;
+
+        st->rec_total += size;
+        st->records++;
+    }
+
+    return (stats_tag(st, item, item->size) == 0 ? ASN1_CONTINUE : ASN1_STOP);
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_end_cons
+|*
+|* Description;
+|*
+|*     Accounts a constructed element at its end, when its size is known:
+|*     its length or, if indefinite, up to its End of indefinite length
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int stats_end_cons(void *user, const asn1event *ev)
+{
+    asn1stats*      st = (asn1stats *)user;
+    const asn1item* item = ev->item;
+    long            size = item->size;
+    long            len = 0;
+
+    if (item->size_x[0] && item->size == 0 && ev->depth < st->nstarts)
+        size = ev->pos - st->starts[ev->depth] - 2;
+
+    if (ev->is_record)
+    {
+        len = item->tag_l + item->size_l + size + (item->size_x[0] && item->size == 0 ? 2 : 0);
+
+        if (st->records == 0 || len < st->rec_min)
+            st->rec_min = len;
+        if (len > st->rec_max)
+            st->rec_max = len;
+
+        st->rec_total += len;
+        st->records++;
+    }
+
+    return (stats_tag(st, item, size) == 0 ? ASN1_CONTINUE : ASN1_STOP);
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_tag
+|*
+|* Description;
+|*
+|*     Accounts an element of the tag of item with a value of size bytes
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int stats_tag(asn1stats *st, const asn1item *item, long size)
+{
+    unsigned long long key = stats_key(item);
+    tagstats*       t = NULL;
+    int             i = 0;
+
+    /* 1. Entry of the key, or a free one for it */
+
+    if (st->ntags * 2 >= st->atags && stats_grow(st) != 0)
+        return -1;
+
+    for (i = (int)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (st->atags - 1);
+            st->tags[i].count != 0 && st->tags[i].key != key;
+            i = (i + 1) & (st->atags - 1))
+        ;
+
+    t = &st->tags[i];
+
+
+    /* 2. Counters */
+
+    if (t->count == 0)
+    {
+        t->key = key;
+        t->min = size;
+        st->ntags++;
+    }
+
+    if (size < t->min)
+        t->min = size;
+    if (size > t->max)
+        t->max = size;
+
+    t->total += size;
+    t->count++;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_grow
+|*
+|* Description;
+|*
+|*     Doubles the hash table of the tags
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int stats_grow(asn1stats *st)
+{
+    tagstats*       old = st->tags;
+    tagstats*       tags = NULL;
+    int             atags = st->atags * 2;
+    int             i = 0;
+    int             j = 0;
+
+    if ( ( tags = (tagstats *)calloc((size_t)atags, sizeof(tagstats)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the statistics\n");
+        return -1;
+    }
+
+    for (i = 0; i < st->atags; i++)
+    {
+        if (old[i].count == 0)
+            continue;
+
+        for (j = (int)((old[i].key * 0x9E3779B97F4A7C15ULL) >> 32) & (atags - 1);
+                tags[j].count != 0;
+                j = (j + 1) & (atags - 1))
+            ;
+
+        tags[j] = old[i];
+    }
+
+    st->tags = tags;
+    st->atags = atags;
+    free(old);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_key
+|*
+|* Description;
+|*
+|*     Key of the tag of item: tag, class and primitive/constructed, in
+|*     this order of significance
+|*
+|* Return:
+|*      Key
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static unsigned long long stats_key(const asn1item *item)
+{
+    return (unsigned long long)(unsigned int)item->tag << 3 | item->class << 1 | item->pc;
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_print
+|*
+|* Description;
+|*
+|*     Prints the statistics: totals and then one line per tag
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void stats_print(const asn1stats *st, asn1output *out, const asn1ctx *ctx)
+{
+    tagstats*       tags = NULL;
+    const tagstats* t = NULL;
+    const char*     name = NULL;
+    int             n = 0;
+    int             i = 0;
+
+    /* 1. Totals */
+
+    output_printf(out, "Bytes decoded: %ld\n", ctx->pos);
+    output_printf(out, "Elements: %ld (primitive: %ld, constructed: %ld)\n", st->prims + st->conss, st->prims, st->conss);
+    output_printf(out, "End of indefinite length markers: %ld\n", st->eoes);
+    output_printf(out, "Maximum depth: %d\n", st->max_depth);
+    output_printf(out, "Records: %ld", st->records);
+
+    if (st->records > 0)
+        output_printf(out, " (size min: %ld, max: %ld, total: %lld)", st->rec_min, st->rec_max, st->rec_total);
+
+    output_eol(out);
+
+
+    /* 2. Tags, sorted */
+
+    if ( ( tags = (tagstats *)malloc((size_t)(st->ntags > 0 ? st->ntags : 1) * sizeof(tagstats)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the statistics\n");
+        return;
+    }
+
+    for (i = 0; i < st->atags; i++)
+    {
+        if (st->tags[i].count != 0)
+            tags[n++] = st->tags[i];
+    }
+
+    qsort(tags, (size_t)n, sizeof(tagstats), cmp_tags);
+
+    output_printf(out, "\n%10s %-5s %-4s %10s %10s %10s %14s  %s\n", "Tag", "Class", "P/C", "Count", "Min", "Max", "Total", "Name");
+
+    for (i = 0; i < n; i++)
+    {
+        t = &tags[i];
+        name = asn1_tagname(ctx, (int)(t->key >> 3));
+
+        output_printf(out, "%10d %-5s %-4s %10ld %10ld %10ld %14lld  %s\n", (int)(t->key >> 3),
+                class_names[t->key >> 1 & 3], (t->key & 1 ? "C" : "P"),
+                t->count, t->min, t->max, t->total, (name != NULL ? name : ""));
+    }
+
+    free(tags);
+}
+
+
+/****************************************************************************
+|*
+|* Function: cmp_tags
+|*
+|* Description;
+|*
+|*     Order of the tags for qsort(): by key
+|*
+|* Return:
+|*      <0, 0, >0
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int cmp_tags(const void *a, const void *b)
+{
+    const tagstats* ta = (const tagstats *)a;
+    const tagstats* tb = (const tagstats *)b;
+
+    return (ta->key > tb->key) - (ta->key < tb->key);
+}
+
+
+/****************************************************************************
+|*
+|* Function: stats_close
+|*
+|* Description;
+|*
+|*     Releases the statistics
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void stats_close(asn1stats *st)
+{
+    free(st->tags);
+    free(st->starts);
+
+    st->tags = NULL;
+    st->starts = NULL;
+}
+
+/* EOF */
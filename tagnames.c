@@ -28,1020 +28,1018 @@
 |*
 |* When         Who     Pos     What
 |* 20120308     JG              Initial Version
+|* 20261016                     Tables built at compile time
 |*
 ****************************************************************************/
 
-#include <stdio.h>
-#include <string.h>
+/* 1. Includes */
+
+#include <stddef.h>
 
 
 #include "readasn.h"
 
 
-extern char    nrt0201_tagname_map[MAXTAGS][MAXLEN];      /* NRT */
-extern char    rap01XX_tagname_map[MAXTAGS][MAXLEN];      /* All releases of RAP 01 */
-extern char    tap03le09_tagname_map[MAXTAGS][MAXLEN];    /* All releases of TAP less and equal to 09 */
-extern char    tap03ge10_tagname_map[MAXTAGS][MAXLEN];    /* All releases of TAP greater and equal to 10 */
+/* 2. Tag lists: X(tag, name) */
 
-/****************************************************************************
-|* 
-|* Function: tagid_init
-|* 
-|* Description; 
-|* 
-|*     Initialize the tagname array
-|* 
-|* Return:
-|*      void
-|* 
-|* Author: Javier Gutierrez (JG)
-|* 
-|* Modifications:
-|* 20120308    JG    Pos    Initial version
-|* 
-****************************************************************************/
-void tagid_init(void)
-{
-    memset(nrt0201_tagname_map,   0x00, sizeof(nrt0201_tagname_map));
-    memset(rap01XX_tagname_map,   0x00, sizeof(rap01XX_tagname_map));
-    memset(tap03le09_tagname_map, 0x00, sizeof(tap03le09_tagname_map));
-    memset(tap03ge10_tagname_map, 0x00, sizeof(tap03ge10_tagname_map));
+/*
+ * NRT
+ */
+#define NRT0201_TAGS(X) \
+    X(  1, Nrtrde) \
+    X(  2, CallEventList) \
+    X(  3, Moc) \
+    X(  4, Mtc) \
+    X(  5, Gprs) \
+    X( 16, AccessPointNameNI) \
+    X( 17, AccessPointNameOI) \
+    X( 18, BearerServiceCode) \
+    X( 19, CallEventDuration) \
+    X( 20, CallEventsCount) \
+    X( 21, CallEventStartTimeStamp) \
+    X( 22, CallingNumber) \
+    X( 23, CallReference) \
+    X( 24, CauseForTermination) \
+    X( 47, CellId) \
+    X( 25, ChargeAmount) \
+    X( 26, ChargingId) \
+    X( 27, ConnectedNumber) \
+    X( 28, DataVolumeIncoming) \
+    X( 29, DataVolumeOutgoing) \
+    X( 30, DialledDigits) \
+    X( 31, FileAvailableTimeStamp) \
+    X( 32, GgsnAddress) \
+    X( 33, Imei) \
+    X( 34, Imsi) \
+    X( 48, LocationArea) \
+    X( 49, Msisdn) \
+    X( 35, RecEntityId) \
+    X( 36, Recipient) \
+    X( 37, ReleaseVersionNumber) \
+    X( 38, Sender) \
+    X( 39, SequenceNumber) \
+    X( 46, ServiceCode) \
+    X( 15, ServingNetwork) \
+    X( 40, SgsnAddress) \
+    X( 41, SpecificationVersionNumber) \
+    X( 42, SupplementaryServiceCode) \
+    X( 43, TeleServiceCode) \
+    X( 44, ThirdPartyNumber) \
+    X( 45, UtcTimeOffset)
+
+/*
+ * RAP01XX
+ */
+#define RAP01XX_TAGS(X) \
+    X(  7, VasInfoList) \
+    X(  8, MessageDescriptionInfoList) \
+    X(143, MessageDescriptionInformationDefinition) \
+    X(238, VasInformationDefinition) \
+    X(512, AccountingInfoError) \
+    X(513, AuditControlInfoError) \
+    X(515, AckFileAvailableTimeStamp) \
+    X(516, AckFileCreationTimeStamp) \
+    X(517, BatchControlError) \
+    X(518, EndMissingSeqNumber) \
+    X(519, ErrorCode) \
+    X(520, ErrorDetailList) \
+    X(521, ErrorDetail) \
+    X(522, MessageDescriptionError) \
+    X(523, NetworkInfoError) \
+    X(524, ItemOffset) \
+    X(525, RapFileAvailableTimeStamp) \
+    X(526, RapFileCreationTimeStamp) \
+    X(527, VASInformationError) \
+    X(528, ReturnDetailsCount) \
+    X(529, SevereReturnValue) \
+    X(530, ReturnSummary) \
+    X(531, ReturnSummaryList) \
+    X(532, StartMissingSeqNumber) \
+    X(533, TotalSevereReturnValue) \
+    X(534, ReturnBatch) \
+    X(535, Acknowledgement) \
+    X(536, ReturnDetailList) \
+    X(537, RapBatchControlInfo) \
+    X(538, MissingReturn) \
+    X(539, FatalReturn) \
+    X(540, SevereReturn) \
+    X(541, RapAuditControlInfo) \
+    X(542, TransferBatchError) \
+    X(543, RapReleaseVersionNumber) \
+    X(544, RapSpecificationVersionNumber) \
+    X(545, ErrorContext) \
+    X(546, PathItemId) \
+    X(547, ItemOccurrence) \
+    X(548, ItemLevel) \
+    X(549, ErrorContextList) \
+    X(550, RoamingPartner) \
+    X(551, OperatorSpecList) \
+    X(552, NotificationError) \
+    X(553, TotalSevereReturnTax)
+
+/*
+ * TAP03 release less and equal than 09
+ */
+#define TAP03LE09_TAGS(X) \
+    X(  1, TransferBatch) \
+    X(  2, Notification) \
+    X(  3, CallEventDetailList) \
+    X(  4, BatchControlInfo) \
+    X(  5, AccountingInfo) \
+    X(  6, NetworkInfo) \
+    X(  7, VasInfo) \
+    X(  8, MessageDescriptionInfo) \
+    X(  9, MobileOriginatedCall) \
+    X( 10, MobileTerminatedCall) \
+    X( 11, SupplServiceEvent) \
+    X( 12, ServiceCentreUsage) \
+    X( 13, ValueAddedService) \
+    X( 14, GprsCall) \
+    X( 15, AuditControlInfo) \
+    X( 16, LocalTimeStamp) \
+    X( 17, ContentTransaction) \
+    X( 32, AccessPointName) \
+    X( 33, AddressStringDigits) \
+    X( 34, AiurRequested) \
+    X( 35, BasicHSCSDParameters) \
+    X( 36, BasicService) \
+    X( 37, BasicServiceCodeList) \
+    X( 38, BasicServiceUsedList) \
+    X( 39, BasicServiceUsed) \
+    X( 40, BearerServiceCode) \
+    X( 41, CallOriginator) \
+    X( 42, CalledPlace) \
+    X( 43, CallEventDetailsCount) \
+    X( 44, CallEventStartTimeStamp) \
+    X( 45, CallReference) \
+    X( 46, CalledRegion) \
+    X( 47, CallType) \
+    X( 48, CallTypeSubtype) \
+    X( 49, CamelCallReference) \
+    X( 50, CamelCallReferenceNumber) \
+    X( 51, CamelDestination) \
+    X( 52, CamelInitiatedCFIndicator) \
+    X( 53, CamelModification) \
+    X( 54, CamelModificationList) \
+    X( 55, CamelServiceKey) \
+    X( 56, CamelServiceLevel) \
+    X( 57, CamelServiceUsed) \
+    X( 58, CauseForTerm) \
+    X( 59, CellId) \
+    X( 60, ChannelCoding) \
+    X( 61, ChannelCodingsAcceptable) \
+    X( 62, Charge) \
+    X( 63, ChargeDetail) \
+    X( 64, ChargeDetailList) \
+    X( 65, ChargeableUnits) \
+    X( 66, ChargedItem) \
+    X( 67, ChargedPartyStatus) \
+    X( 68, ChargedUnits) \
+    X( 69, ChargeInformation) \
+    X( 70, ChargeInformationList) \
+    X( 71, ChargeType) \
+    X( 72, ChargingId) \
+    X( 73, ChargingPoint) \
+    X( 74, ChargingTimeStamp) \
+    X( 75, ClirIndicator) \
+    X( 76, CompletionTimeStamp) \
+    X( 77, CountryCode) \
+    X( 78, CountryCodeTable) \
+    X( 79, CseInformation) \
+    X( 80, CurrencyConversion) \
+    X( 81, DataVolume) \
+    X( 82, DataVolumeReference) \
+    X( 83, DateTime) \
+    X( 84, DateTimeLong) \
+    X( 85, DayCategory) \
+    X( 86, DayCategorySubtype) \
+    X( 87, DefaultCallHandlingIndicator) \
+    X( 88, DepositTimeStamp) \
+    X( 89, Destination) \
+    X( 90, DestinationNetwork) \
+    X( 91, DiscountCode) \
+    X( 92, DiscountRate) \
+    X( 93, DiscountValue) \
+    X( 94, DiscountDefinition) \
+    X( 95, Discounting) \
+    X( 96, DiscountInformation) \
+    X( 97, DiscountInformationList) \
+    X( 98, DistanceChargeBandCode) \
+    X( 99, DualBearerServiceCode) \
+    X(100, DualTeleServiceCode) \
+    X(101, EarliestCallTimeStamp) \
+    X(102, EquipmentInformation) \
+    X(103, Esn) \
+    X(104, ExchangeRate) \
+    X(105, ExchangeRateCode) \
+    X(106, ExchangeRateDefinition) \
+    X(107, FileAvailableTimeStamp) \
+    X(108, FileCreationTimeStamp) \
+    X(109, FileSequenceNumber) \
+    X(110, FileTypeIndicator) \
+    X(111, Fnur) \
+    X(112, FraudMonitorIndicator) \
+    X(113, GeographicalLocation) \
+    X(114, GprsBasicCallInformation) \
+    X(115, GprsChargeableSubscriber) \
+    X(116, GprsDestination) \
+    X(117, GprsLocationInformation) \
+    X(118, GprsNetworkLocation) \
+    X(119, GprsServiceUsage) \
+    X(120, GprsServiceUsageList) \
+    X(121, GprsServiceUsed) \
+    X(122, HomeBid) \
+    X(123, HomeLocationInformation) \
+    X(124, HSCSDInformation) \
+    X(125, HSCSDParameterModification) \
+    X(126, Iac) \
+    X(127, IacTable) \
+    X(128, Imei) \
+    X(129, Imsi) \
+    X(130, InitiatingParty) \
+    X(131, IPTextV4Address) \
+    X(132, IPTextV6Address) \
+    X(133, LatestCallTimeStamp) \
+    X(134, Latitude) \
+    X(135, LocalCurrency) \
+    X(136, LocationArea) \
+    X(137, LocationDescription) \
+    X(138, LocationInformation) \
+    X(139, Longitude) \
+    X(140, HSCSDParameterModificationList) \
+    X(141, MessageDescriptionCode) \
+    X(142, MessageDescription) \
+    X(143, MessageDescriptionDefinition) \
+    X(144, MessageStatus) \
+    X(145, MessageType) \
+    X(146, Min) \
+    X(147, MoBasicCallInformation) \
+    X(148, MobileStationClassMark) \
+    X(149, ModificationIndicator) \
+    X(150, ModificationTimestamp) \
+    X(151, MscId) \
+    X(152, Msisdn) \
+    X(153, MtBasicCallInformation) \
+    X(154, MultiRateIndicator) \
+    X(155, NetworkId) \
+    X(156, NetworkLocation) \
+    X(157, NetworkType) \
+    X(158, NonChargedParty) \
+    X(159, NumberOfDecimalPlaces) \
+    X(160, NumberingPlan) \
+    X(161, NumberOfChannels) \
+    X(162, OperatorSpecInfoList) \
+    X(163, OperatorSpecInformation) \
+    X(164, OriginatingNetwork) \
+    X(165, PacketDataProtocolAddress) \
+    X(166, PartialTypeIndicator) \
+    X(167, PdpAddress) \
+    X(168, PdpType) \
+    X(169, PlmnId) \
+    X(170, PriorityCode) \
+    X(171, QoSDelay) \
+    X(172, QoSInformation) \
+    X(173, QoSMeanThroughput) \
+    X(174, QoSPeakThroughput) \
+    X(175, QoSPrecedence) \
+    X(176, QoSReliability) \
+    X(177, QoSRequested) \
+    X(178, QoSUsed) \
+    X(179, RadioChannelRequested) \
+    X(180, RadioChannelUsed) \
+    X(181, RapFileSequenceNumber) \
+    X(182, Recipient) \
+    X(183, RecEntityDefinition) \
+    X(184, RecEntityCode) \
+    X(185, RecEntityCodeList) \
+    X(186, RecEntityType) \
+    X(188, RecEntityTable) \
+    X(189, ReleaseVersionNumber) \
+    X(190, RemotePdpAddressList) \
+    X(191, ScuBasicInformation) \
+    X(192, ScuChargeType) \
+    X(193, ScuTimeStamps) \
+    X(195, ServingNetwork) \
+    X(196, Sender) \
+    X(197, ServiceCentreIdentity) \
+    X(198, ServingBid) \
+    X(199, SimChargeableSubscriber) \
+    X(200, SimToolkitIndicator) \
+    X(201, SpecificationVersionNumber) \
+    X(202, SpeechVersionRequested) \
+    X(203, SpeechVersionUsed) \
+    X(204, SsParameters) \
+    X(206, SupplServiceUsed) \
+    X(207, SupplServiceUsedList) \
+    X(208, SupplServiceActionCode) \
+    X(209, SupplServiceCode) \
+    X(210, TapCurrency) \
+    X(211, Taxation) \
+    X(212, TaxCode) \
+    X(213, TaxInformation) \
+    X(214, TaxInformationList) \
+    X(215, TaxRate) \
+    X(216, TaxRateDefinition) \
+    X(217, TaxType) \
+    X(218, TeleServiceCode) \
+    X(219, ThirdPartyInformation) \
+    X(220, TimeBand) \
+    X(221, TimeBandSubtype) \
+    X(222, TotalChargeValue) \
+    X(223, TotalCallEventDuration) \
+    X(224, TotalChargeValueList) \
+    X(225, TotalDiscountValue) \
+    X(226, TotalTaxValue) \
+    X(227, TransferCutOffTimeStamp) \
+    X(228, TransparencyIndicator) \
+    X(229, TypeOfControllingNode) \
+    X(230, TypeOfNumber) \
+    X(231, UtcTimeOffset) \
+    X(232, UtcTimeOffsetCode) \
+    X(233, UtcTimeOffsetDefinition) \
+    X(234, UtcTimeOffsetInfo) \
+    X(235, ValueAddedServiceUsedList) \
+    X(236, ValueAddedServiceUsed) \
+    X(237, VasCode) \
+    X(238, VasDefinition) \
+    X(239, VasDescription) \
+    X(240, VasShortDescription) \
+    X(241, AbsoluteAmount) \
+    X(242, Bid) \
+    X(243, Code) \
+    X(244, TapDecimalPlaces) \
+    X(245, NetworkInitPDPContext) \
+    X(246, CalledNumAnalysis) \
+    X(247, CalledNumAnalysisCode) \
+    X(249, CalledNumAnalysisList) \
+    X(250, DataVolumeIncoming) \
+    X(251, DataVolumeOutgoing) \
+    X(252, NumberOfChannelsUsed) \
+    X(253, Mdn) \
+    X(254, MinChargeableSubscriber) \
+    X(255, CallTypeLevel2) \
+    X(256, CallTypeLevel3) \
+    X(257, CalledCountryCode) \
+    X(258, CallTypeGroup) \
+    X(259, CallTypeLevel1) \
+    X(260, PDPContextStartTimestamp) \
+    X(261, AccessPointNameNI) \
+    X(262, AccessPointNameOI) \
+    X(263, ChargingCharacteristics) \
+    X(264, QoSMaxBitRateUplink) \
+    X(265, QoSMaxSDUsize) \
+    X(266, QoSResidualBER) \
+    X(267, QoSSDUErrorRatio) \
+    X(268, QoSTrafficClass) \
+    X(269, QoSTransferDelay) \
+    X(270, UMTSQoSRequested) \
+    X(271, UMTSQoSUsed) \
+    X(272, GSMQoSRequested) \
+    X(273, GSMQoSUsed) \
+    X(274, QoSMaxBitRateDownlink) \
+    X(275, QoSAllocRetenPriority) \
+    X(276, QoSHandlingpriority) \
+    X(277, QoSErroneousSDUs) \
+    X(278, QoSDeliveryOrder) \
+    X(279, DialledDigits) \
+    X(280, UserProtocolIndicator) \
+    X(281, ObjectType) \
+    X(283, QoSGuaranteedBitRateDownlink) \
+    X(284, QoSGuaranteedBitRateUplink) \
+    X(285, ContentServiceUsedList) \
+    X(286, GsmChargeableSubscriber) \
+    X(287, ChargedPartyIdentifier) \
+    X(288, HomeIdentifier) \
+    X(289, LocationIdentifier) \
+    X(290, EquipmentId) \
+    X(291, ContentProviderIdType) \
+    X(292, ContentProviderIdentifier) \
+    X(293, IspIdType) \
+    X(294, IspIdentifier) \
+    X(295, NetworkIdentifier) \
+    X(296, GmlcAddress) \
+    X(297, LocationService) \
+    X(298, TrackingCustomerInformation) \
+    X(299, TrackingCustomerIdList) \
+    X(300, OrderPlacementTimeStamp) \
+    X(301, RequestedDeliveryTimeStamp) \
+    X(302, ActualDeliveryTimeStamp) \
+    X(303, TransactionStatus) \
+    X(304, ContentTransactionBasicInfo) \
+    X(305, ChargedPartyIdType) \
+    X(306, LoginName) \
+    X(307, AccountNumber) \
+    X(308, EmailAddress) \
+    X(309, ChargedPartyId) \
+    X(310, ChargedPartyIdList) \
+    X(311, HomeIdType) \
+    X(312, Name) \
+    X(313, ChargedPartyHomeId) \
+    X(314, ChargedPartyHomeIdList) \
+    X(315, LocationIdType) \
+    X(316, CountryName) \
+    X(317, CountryAsciCode) \
+    X(318, Region) \
+    X(319, Place) \
+    X(320, ChargedPartyLocation) \
+    X(321, ChargedPartyLocationList) \
+    X(322, EquipmentIdType) \
+    X(323, ChargedPartyEquipment) \
+    X(324, ChargedPartyInformation) \
+    X(325, ProviderIdType) \
+    X(326, Url) \
+    X(327, ContentProviderId) \
+    X(328, ContentProviderIdList) \
+    X(329, InternetServiceProviderId) \
+    X(330, InternetServiceProviderIdList) \
+    X(331, NetworkIdType) \
+    X(332, NetworkIdGroup) \
+    X(333, NetworkIdList) \
+    X(334, ContentProviderName) \
+    X(335, ServingPartiesInformation) \
+    X(336, ContentTransactionCode) \
+    X(337, ContentTransactionType) \
+    X(338, TransactionDescriptionSupp) \
+    X(339, TransactionDetailDescription) \
+    X(340, TransactionShortDescription) \
+    X(341, TransactionIdentifier) \
+    X(342, TransactionAuthCode) \
+    X(343, TotalDataVolume) \
+    X(344, ChargeRefundIndicator) \
+    X(345, ContentChargingPoint) \
+    X(346, PaidIndicator) \
+    X(347, PaymentMethod) \
+    X(348, AdvisedChargeCurrency) \
+    X(349, AdvisedCharge) \
+    X(350, Commission) \
+    X(351, AdvisedChargeInformation) \
+    X(352, ContentServiceUsed) \
+    X(353, TotalTaxRefund) \
+    X(354, TotalDiscountRefund) \
+    X(355, TotalChargeRefund) \
+    X(356, TotalAdvisedCharge) \
+    X(357, TotalAdvisedChargeRefund) \
+    X(358, TotalCommission) \
+    X(359, TotalCommissionRefund) \
+    X(360, TotalAdvisedChargeValue) \
+    X(361, TotalAdvisedChargeValueList) \
+    X(362, TrackingCustomerIdentification) \
+    X(363, CustomerIdType) \
+    X(364, CustomerIdentifier) \
+    X(365, TrackingCustomerHomeIdList) \
+    X(366, TrackingCustomerHomeId) \
+    X(367, TrackedCustomerInformation) \
+    X(368, TrackingCustomerLocList) \
+    X(369, TrackingCustomerLocation) \
+    X(370, TrackedCustomerIdList) \
+    X(371, TrackingCustomerEquipment) \
+    X(372, TrackedCustomerIdentification) \
+    X(373, LCSSPInformation) \
+    X(374, LCSSPIdentificationList) \
+    X(375, LCSSPIdentification) \
+    X(376, TrackedCustomerHomeIdList) \
+    X(377, TrackedCustomerHomeId) \
+    X(378, ISPList) \
+    X(379, TrackedCustomerLocList) \
+    X(380, TrackedCustomerLocation) \
+    X(381, TrackedCustomerEquipment) \
+    X(382, LocationServiceUsage) \
+    X(383, LCSQosRequested) \
+    X(384, LCSRequestTimestamp) \
+    X(385, HorizontalAccuracyRequested) \
+    X(386, VerticalAccuracyRequested) \
+    X(387, ResponseTimeCategory) \
+    X(388, TrackingPeriod) \
+    X(389, TrackingFrequency) \
+    X(390, LCSQosDelivered) \
+    X(391, LCSTransactionStatus) \
+    X(392, HorizontalAccuracyDelivered) \
+    X(393, VerticalAccuracyDelivered) \
+    X(394, ResponseTime) \
+    X(395, PositioningMethod) \
+    X(396, AgeOfLocation) \
+    X(397, TaxValue) \
+    X(398, TaxableAmount) \
+    X(399, CamelServerAddress) \
+    X(400, RecEntityId) \
+    X(402, NonChargedNumber) \
+    X(403, ThirdPartyNumber) \
+    X(404, CamelDestinationNumber) \
+    X(405, CallingNumber) \
+    X(407, CalledNumber) \
+    X(410, ChargeDetailTimeStamp) \
+    X(411, FixedDiscountValue) \
+    X(412, Discount) \
+    X(413, HomeLocationDescription) \
+    X(414, ServingLocationDescription) \
+    X(415, TotalCharge) \
+    X(416, TotalTransactionDuration) \
+    X(417, NetworkAccessIdentifier) \
+    X(418, IMSSignallingContext) \
+    X(419, SMSDestinationNumber) \
+    X(420, GuaranteedBitRate) \
+    X(421, MaximumBitRate) \
+    X(422, CamelInvocationFee) \
+    X(423, DiscountableAmount) \
+    X(424, HSCSDIndicator) \
+    X(425, SMSOriginator) \
+    X(426, BasicServiceCode) \
+    X(427, ChargeableSubscriber) \
+    X(428, DiscountApplied) \
+    X(429, ImeiOrEsn) \
+    X(430, ScuChargeableSubscriber) \
+    X(431, ThreeGcamelDestination) \
+    X(432, TaxIndicator) \
+    X(433, MessagingEvent) \
+    X(434, MobileSession) \
+    X(435, EventReference) \
+    X(436, ChargedParty) \
+    X(437, ElementId) \
+    X(438, ElementType) \
+    X(439, MessagingEventService) \
+    X(440, MobileSessionService) \
+    X(441, NetworkElement) \
+    X(442, NetworkElementList) \
+    X(443, NonChargedParty) \
+    X(444, NonChargedPartyNumber) \
+    X(445, NonChargedPublicUserId) \
+    X(446, PublicUserId) \
+    X(447, ServiceStartTimestamp) \
+    X(448, SessionChargeInfoList) \
+    X(449, SessionChargeInformation)
+
+/*
+ * TAP03 release bigger and equal than 10
+ */
+#define TAP03GE10_TAGS(X) \
+    X(  1, TransferBatch) \
+    X(  2, Notification) \
+    X(  3, CallEventDetailList) \
+    X(  4, BatchControlInfo) \
+    X(  5, AccountingInfo) \
+    X(  6, NetworkInfo) \
+    X(  7, VasInfoList) \
+    X(  8, MessageDescriptionInfoList) \
+    X(  9, MobileOriginatedCall) \
+    X( 10, MobileTerminatedCall) \
+    X( 11, SupplServiceEvent) \
+    X( 12, ServiceCentreUsage) \
+    X( 13, ValueAddedService) \
+    X( 14, GprsCall) \
+    X( 15, AuditControlInfo) \
+    X( 16, LocalTimeStamp) \
+    X( 17, ContentTransaction) \
+    X( 32, AccessPointName) \
+    X( 33, AddressStringDigits) \
+    X( 34, AiurRequested) \
+    X( 35, BasicHSCSDParameters) \
+    X( 36, BasicService) \
+    X( 37, BasicServiceCodeList) \
+    X( 38, BasicServiceUsedList) \
+    X( 39, BasicServiceUsed) \
+    X( 40, BearerServiceCode) \
+    X( 41, CallOriginator) \
+    X( 42, CalledPlace) \
+    X( 43, CallEventDetailsCount) \
+    X( 44, CallEventStartTimeStamp) \
+    X( 45, CallReference) \
+    X( 46, CalledRegion) \
+    X( 47, CallType) \
+    X( 48, CallTypeSubtype) \
+    X( 49, CamelCallReference) \
+    X( 50, CamelCallReferenceNumber) \
+    X( 51, CamelDestination) \
+    X( 52, CamelInitiatedCFIndicator) \
+    X( 53, CamelModification) \
+    X( 54, CamelModificationList) \
+    X( 55, CamelServiceKey) \
+    X( 56, CamelServiceLevel) \
+    X( 57, CamelServiceUsed) \
+    X( 58, CauseForTerm) \
+    X( 59, CellId) \
+    X( 60, ChannelCoding) \
+    X( 61, ChannelCodingAcceptableList) \
+    X( 62, Charge) \
+    X( 63, ChargeDetail) \
+    X( 64, ChargeDetailList) \
+    X( 65, ChargeableUnits) \
+    X( 66, ChargedItem) \
+    X( 67, ChargedPartyStatus) \
+    X( 68, ChargedUnits) \
+    X( 69, ChargeInformation) \
+    X( 70, ChargeInformationList) \
+    X( 71, ChargeType) \
+    X( 72, ChargingId) \
+    X( 73, ChargingPoint) \
+    X( 74, ChargingTimeStamp) \
+    X( 75, ClirIndicator) \
+    X( 76, CompletionTimeStamp) \
+    X( 77, CountryCode) \
+    X( 78, CountryCodeList) \
+    X( 79, CseInformation) \
+    X( 80, CurrencyConversionList) \
+    X( 81, DataVolume) \
+    X( 82, DataVolumeReference) \
+    X( 83, DateTime) \
+    X( 84, DateTimeLong) \
+    X( 85, DayCategory) \
+    X( 86, DayCategorySubtype) \
+    X( 87, DefaultCallHandlingIndicator) \
+    X( 88, DepositTimeStamp) \
+    X( 89, Destination) \
+    X( 90, DestinationNetwork) \
+    X( 91, DiscountCode) \
+    X( 92, DiscountRate) \
+    X( 93, DiscountValue) \
+    X( 94, Discounting) \
+    X( 95, DiscountingList) \
+    X( 96, DiscountInformation) \
+    X( 97, DiscountInformationList) \
+    X( 98, DistanceChargeBandCode) \
+    X( 99, DualBearerServiceCode) \
+    X(100, DualTeleServiceCode) \
+    X(101, EarliestCallTimeStamp) \
+    X(102, EquipmentInformation) \
+    X(103, Esn) \
+    X(104, ExchangeRate) \
+    X(105, ExchangeRateCode) \
+    X(106, CurrencyConversion) \
+    X(107, FileAvailableTimeStamp) \
+    X(108, FileCreationTimeStamp) \
+    X(109, FileSequenceNumber) \
+    X(110, FileTypeIndicator) \
+    X(111, Fnur) \
+    X(112, FraudMonitorIndicator) \
+    X(113, GeographicalLocation) \
+    X(114, GprsBasicCallInformation) \
+    X(115, GprsChargeableSubscriber) \
+    X(116, GprsDestination) \
+    X(117, GprsLocationInformation) \
+    X(118, GprsNetworkLocation) \
+    X(119, GprsServiceUsage) \
+    X(120, GprsServiceUsageList) \
+    X(121, GprsServiceUsed) \
+    X(122, HomeBid) \
+    X(123, HomeLocationInformation) \
+    X(124, HSCSDInformation) \
+    X(125, HSCSDParameterModification) \
+    X(126, Iac) \
+    X(127, IacList) \
+    X(128, Imei) \
+    X(129, Imsi) \
+    X(130, InitiatingParty) \
+    X(131, IPTextV4Address) \
+    X(132, IPTextV6Address) \
+    X(133, LatestCallTimeStamp) \
+    X(134, Latitude) \
+    X(135, LocalCurrency) \
+    X(136, LocationArea) \
+    X(137, LocationDescription) \
+    X(138, LocationInformation) \
+    X(139, Longitude) \
+    X(140, HSCSDParameterModificationList) \
+    X(141, MessageDescriptionCode) \
+    X(142, MessageDescription) \
+    X(143, MessageDescriptionInformation) \
+    X(144, MessageStatus) \
+    X(145, MessageType) \
+    X(146, Min) \
+    X(147, MoBasicCallInformation) \
+    X(148, MobileStationClassMark) \
+    X(149, ModificationIndicator) \
+    X(150, ModificationTimestamp) \
+    X(151, MscId) \
+    X(152, Msisdn) \
+    X(153, MtBasicCallInformation) \
+    X(154, MultiRateIndicator) \
+    X(155, NetworkId) \
+    X(156, NetworkLocation) \
+    X(157, NetworkType) \
+    X(158, NonChargedParty) \
+    X(159, NumberOfDecimalPlaces) \
+    X(160, NumberingPlan) \
+    X(161, NumberOfChannels) \
+    X(162, OperatorSpecInfoList) \
+    X(163, OperatorSpecInformation) \
+    X(164, OriginatingNetwork) \
+    X(165, PacketDataProtocolAddress) \
+    X(166, PartialTypeIndicator) \
+    X(167, PdpAddress) \
+    X(168, PdpType) \
+    X(169, PlmnId) \
+    X(170, PriorityCode) \
+    X(171, QoSDelay) \
+    X(172, QoSInformation) \
+    X(173, QoSMeanThroughput) \
+    X(174, QoSPeakThroughput) \
+    X(175, QoSPrecedence) \
+    X(176, QoSReliability) \
+    X(177, QoSRequested) \
+    X(178, QoSUsed) \
+    X(179, RadioChannelRequested) \
+    X(180, RadioChannelUsed) \
+    X(181, RapFileSequenceNumber) \
+    X(182, Recipient) \
+    X(183, RecEntityInformation) \
+    X(184, RecEntityCode) \
+    X(185, RecEntityCodeList) \
+    X(186, RecEntityType) \
+    X(188, RecEntityInfoList) \
+    X(189, ReleaseVersionNumber) \
+    X(190, RemotePdpAddressList) \
+    X(191, ScuBasicInformation) \
+    X(192, ScuChargeType) \
+    X(193, ScuTimeStamps) \
+    X(195, ServingNetwork) \
+    X(196, Sender) \
+    X(197, ServiceCentreIdentity) \
+    X(198, ServingBid) \
+    X(199, SimChargeableSubscriber) \
+    X(200, SimToolkitIndicator) \
+    X(201, SpecificationVersionNumber) \
+    X(202, SpeechVersionRequested) \
+    X(203, SpeechVersionUsed) \
+    X(204, SsParameters) \
+    X(206, SupplServiceUsed) \
+    X(207, SupplServiceUsedList) \
+    X(208, SupplServiceActionCode) \
+    X(209, SupplServiceCode) \
+    X(210, TapCurrency) \
+    X(211, TaxationList) \
+    X(212, TaxCode) \
+    X(213, TaxInformation) \
+    X(214, TaxInformationList) \
+    X(215, TaxRate) \
+    X(216, Taxation) \
+    X(217, TaxType) \
+    X(218, TeleServiceCode) \
+    X(219, ThirdPartyInformation) \
+    X(220, TimeBand) \
+    X(221, TimeBandSubtype) \
+    X(222, TotalChargeValue) \
+    X(223, TotalCallEventDuration) \
+    X(224, TotalChargeValueList) \
+    X(225, TotalDiscountValue) \
+    X(226, TotalTaxValue) \
+    X(227, TransferCutOffTimeStamp) \
+    X(228, TransparencyIndicator) \
+    X(229, TypeOfControllingNode) \
+    X(230, TypeOfNumber) \
+    X(231, UtcTimeOffset) \
+    X(232, UtcTimeOffsetCode) \
+    X(233, UtcTimeOffsetInfo) \
+    X(234, UtcTimeOffsetInfoList) \
+    X(235, ValueAddedServiceUsedList) \
+    X(236, ValueAddedServiceUsed) \
+    X(237, VasCode) \
+    X(238, VasInformation) \
+    X(239, VasDescription) \
+    X(240, VasShortDescription) \
+    X(241, AbsoluteAmount) \
+    X(242, Bid) \
+    X(243, Code) \
+    X(244, TapDecimalPlaces) \
+    X(245, NetworkInitPDPContext) \
+    X(246, CalledNumAnalysis) \
+    X(247, CalledNumAnalysisCode) \
+    X(249, CalledNumAnalysisList) \
+    X(250, DataVolumeIncoming) \
+    X(251, DataVolumeOutgoing) \
+    X(252, NumberOfChannelsUsed) \
+    X(253, Mdn) \
+    X(254, MinChargeableSubscriber) \
+    X(255, CallTypeLevel2) \
+    X(256, CallTypeLevel3) \
+    X(257, CalledCountryCode) \
+    X(258, CallTypeGroup) \
+    X(259, CallTypeLevel1) \
+    X(260, PDPContextStartTimestamp) \
+    X(261, AccessPointNameNI) \
+    X(262, AccessPointNameOI) \
+    X(263, ChargingCharacteristics) \
+    X(264, QoSMaxBitRateUplink) \
+    X(265, QoSMaxSDUsize) \
+    X(266, QoSResidualBER) \
+    X(267, QoSSDUErrorRatio) \
+    X(268, QoSTrafficClass) \
+    X(270, UMTSQoSRequested) \
+    X(271, UMTSQoSUsed) \
+    X(272, GSMQoSRequested) \
+    X(273, GSMQoSUsed) \
+    X(274, QoSMaxBitRateDownlink) \
+    X(275, QoSAllocRetenPriority) \
+    X(276, QoSHandlingpriority) \
+    X(277, QoSErroneousSDUs) \
+    X(278, QoSDeliveryOrder) \
+    X(279, DialledDigits) \
+    X(280, UserProtocolIndicator) \
+    X(281, ObjectType) \
+    X(283, QoSGuaranteedBitRateDownlink) \
+    X(284, QoSGuaranteedBitRateUplink) \
+    X(285, ContentServiceUsedList) \
+    X(286, GsmChargeableSubscriber) \
+    X(287, ChargedPartyIdentifier) \
+    X(288, HomeIdentifier) \
+    X(289, LocationIdentifier) \
+    X(290, EquipmentId) \
+    X(291, ContentProviderIdType) \
+    X(292, ContentProviderIdentifier) \
+    X(293, IspIdType) \
+    X(294, IspIdentifier) \
+    X(295, NetworkIdentifier) \
+    X(296, GmlcAddress) \
+    X(297, LocationService) \
+    X(298, TrackingCustomerInformation) \
+    X(299, TrackingCustomerIdList) \
+    X(300, OrderPlacedTimeStamp) \
+    X(301, RequestedDeliveryTimeStamp) \
+    X(302, ActualDeliveryTimeStamp) \
+    X(303, TransactionStatus) \
+    X(304, ContentTransactionBasicInfo) \
+    X(305, ChargedPartyIdType) \
+    X(306, LoginName) \
+    X(307, AccountNumber) \
+    X(308, EmailAddress) \
+    X(309, ChargedPartyIdentification) \
+    X(310, ChargedPartyIdList) \
+    X(311, HomeIdType) \
+    X(312, Name) \
+    X(313, ChargedPartyHomeIdentification) \
+    X(314, ChargedPartyHomeIdList) \
+    X(315, LocationIdType) \
+    X(316, CountryName) \
+    X(317, CountryAsciCode) \
+    X(318, Region) \
+    X(319, Place) \
+    X(320, ChargedPartyLocation) \
+    X(321, ChargedPartyLocationList) \
+    X(322, EquipmentIdType) \
+    X(323, ChargedPartyEquipment) \
+    X(324, ChargedPartyInformation) \
+    X(325, ProviderIdType) \
+    X(326, Url) \
+    X(327, ContentProvider) \
+    X(328, ContentProviderIdList) \
+    X(329, InternetServiceProvider) \
+    X(330, InternetServiceProviderIdList) \
+    X(331, NetworkIdType) \
+    X(332, Network) \
+    X(333, NetworkList) \
+    X(334, ContentProviderName) \
+    X(335, ServingPartiesInformation) \
+    X(336, ContentTransactionCode) \
+    X(337, ContentTransactionType) \
+    X(338, TransactionDescriptionSupp) \
+    X(339, TransactionDetailDescription) \
+    X(340, TransactionShortDescription) \
+    X(341, TransactionIdentifier) \
+    X(342, TransactionAuthCode) \
+    X(343, TotalDataVolume) \
+    X(344, ChargeRefundIndicator) \
+    X(345, ContentChargingPoint) \
+    X(346, PaidIndicator) \
+    X(347, PaymentMethod) \
+    X(348, AdvisedChargeCurrency) \
+    X(349, AdvisedCharge) \
+    X(350, Commission) \
+    X(351, AdvisedChargeInformation) \
+    X(352, ContentServiceUsed) \
+    X(353, TotalTaxRefund) \
+    X(354, TotalDiscountRefund) \
+    X(355, TotalChargeRefund) \
+    X(356, TotalAdvisedCharge) \
+    X(357, TotalAdvisedChargeRefund) \
+    X(358, TotalCommission) \
+    X(359, TotalCommissionRefund) \
+    X(360, TotalAdvisedChargeValue) \
+    X(361, TotalAdvisedChargeValueList) \
+    X(362, TrackingCustomerIdentification) \
+    X(363, CustomerIdType) \
+    X(364, CustomerIdentifier) \
+    X(365, TrackingCustomerHomeIdList) \
+    X(366, TrackingCustomerHomeId) \
+    X(367, TrackedCustomerInformation) \
+    X(368, TrackingCustomerLocList) \
+    X(369, TrackingCustomerLocation) \
+    X(370, TrackedCustomerIdList) \
+    X(371, TrackingCustomerEquipment) \
+    X(372, TrackedCustomerIdentification) \
+    X(373, LCSSPInformation) \
+    X(374, LCSSPIdentificationList) \
+    X(375, LCSSPIdentification) \
+    X(376, TrackedCustomerHomeIdList) \
+    X(377, TrackedCustomerHomeId) \
+    X(378, ISPList) \
+    X(379, TrackedCustomerLocList) \
+    X(380, TrackedCustomerLocation) \
+    X(381, TrackedCustomerEquipment) \
+    X(382, LocationServiceUsage) \
+    X(383, LCSQosRequested) \
+    X(384, LCSRequestTimestamp) \
+    X(385, HorizontalAccuracyRequested) \
+    X(386, VerticalAccuracyRequested) \
+    X(387, ResponseTimeCategory) \
+    X(388, TrackingPeriod) \
+    X(389, TrackingFrequency) \
+    X(390, LCSQosDelivered) \
+    X(391, LCSTransactionStatus) \
+    X(392, HorizontalAccuracyDelivered) \
+    X(393, VerticalAccuracyDelivered) \
+    X(394, ResponseTime) \
+    X(395, PositioningMethod) \
+    X(396, AgeOfLocation) \
+    X(397, TaxValue) \
+    X(398, TaxableAmount) \
+    X(399, CamelServerAddress) \
+    X(400, RecEntityId) \
+    X(402, NonChargedNumber) \
+    X(403, ThirdPartyNumber) \
+    X(404, CamelDestinationNumber) \
+    X(405, CallingNumber) \
+    X(407, CalledNumber) \
+    X(410, ChargeDetailTimeStamp) \
+    X(411, FixedDiscountValue) \
+    X(412, Discount) \
+    X(413, HomeLocationDescription) \
+    X(414, ServingLocationDescription) \
+    X(415, TotalCharge) \
+    X(416, TotalTransactionDuration) \
+    X(417, NetworkAccessIdentifier) \
+    X(418, IMSSignallingContext) \
+    X(419, SMSDestinationNumber) \
+    X(420, GuaranteedBitRate) \
+    X(421, MaximumBitRate) \
+    X(422, CamelInvocationFee) \
+    X(423, DiscountableAmount) \
+    X(424, HSCSDIndicator) \
+    X(425, SMSOriginator) \
+    X(426, BasicServiceCode) \
+    X(427, ChargeableSubscriber) \
+    X(428, DiscountApplied) \
+    X(429, ImeiOrEsn) \
+    X(430, ScuChargeableSubscriber) \
+    X(431, ThreeGcamelDestination) \
+    X(432, TaxIndicator) \
+    X(433, MessagingEvent) \
+    X(434, MobileSession) \
+    X(435, EventReference) \
+    X(436, ChargedParty) \
+    X(437, ElementId) \
+    X(438, ElementType) \
+    X(439, MessagingEventService) \
+    X(440, MobileSessionService) \
+    X(441, NetworkElement) \
+    X(442, NetworkElementList) \
+    X(443, NonChargedParty) \
+    X(444, NonChargedPartyNumber) \
+    X(445, NonChargedPublicUserId) \
+    X(446, PublicUserId) \
+    X(447, ServiceStartTimestamp) \
+    X(448, SessionChargeInfoList) \
+    X(449, SessionChargeInformation) \
+    X(450, RequestedDestination) \
+    X(451, RequestedNumber) \
+    X(452, RequestedPublicUserId)
+
+
+/* 3. Tables built from the lists at compile time
+ *
+ * The names of each list are laid out one after the other in a struct,
+ * after an empty one, and the index keeps the offset of every name in
+ * it (0 for tags without name). No strings are copied at run time and
+ * the tables take the length of the names instead of MAXTAGS * MAXLEN.
+ */
 
-    /* 
-     * NRT
-     */
-    strcpy(nrt0201_tagname_map[  1], "Nrtrde");
-    strcpy(nrt0201_tagname_map[  2], "CallEventList");
-    strcpy(nrt0201_tagname_map[  3], "Moc");
-    strcpy(nrt0201_tagname_map[  4], "Mtc");
-    strcpy(nrt0201_tagname_map[  5], "Gprs");
-    strcpy(nrt0201_tagname_map[ 16], "AccessPointNameNI");
-    strcpy(nrt0201_tagname_map[ 17], "AccessPointNameOI");
-    strcpy(nrt0201_tagname_map[ 18], "BearerServiceCode");
-    strcpy(nrt0201_tagname_map[ 19], "CallEventDuration");
-    strcpy(nrt0201_tagname_map[ 20], "CallEventsCount");
-    strcpy(nrt0201_tagname_map[ 21], "CallEventStartTimeStamp");
-    strcpy(nrt0201_tagname_map[ 22], "CallingNumber");
-    strcpy(nrt0201_tagname_map[ 23], "CallReference");
-    strcpy(nrt0201_tagname_map[ 24], "CauseForTermination");
-    strcpy(nrt0201_tagname_map[ 47], "CellId");
-    strcpy(nrt0201_tagname_map[ 25], "ChargeAmount");
-    strcpy(nrt0201_tagname_map[ 26], "ChargingId");
-    strcpy(nrt0201_tagname_map[ 27], "ConnectedNumber");
-    strcpy(nrt0201_tagname_map[ 28], "DataVolumeIncoming");
-    strcpy(nrt0201_tagname_map[ 29], "DataVolumeOutgoing");
-    strcpy(nrt0201_tagname_map[ 30], "DialledDigits");
-    strcpy(nrt0201_tagname_map[ 31], "FileAvailableTimeStamp");
-    strcpy(nrt0201_tagname_map[ 32], "GgsnAddress");
-    strcpy(nrt0201_tagname_map[ 33], "Imei");
-    strcpy(nrt0201_tagname_map[ 34], "Imsi");
-    strcpy(nrt0201_tagname_map[ 48], "LocationArea");
-    strcpy(nrt0201_tagname_map[ 49], "Msisdn");
-    strcpy(nrt0201_tagname_map[ 35], "RecEntityId");
-    strcpy(nrt0201_tagname_map[ 36], "Recipient");
-    strcpy(nrt0201_tagname_map[ 37], "ReleaseVersionNumber");
-    strcpy(nrt0201_tagname_map[ 38], "Sender");
-    strcpy(nrt0201_tagname_map[ 39], "SequenceNumber");
-    strcpy(nrt0201_tagname_map[ 46], "ServiceCode");
-    strcpy(nrt0201_tagname_map[ 15], "ServingNetwork");
-    strcpy(nrt0201_tagname_map[ 40], "SgsnAddress");
-    strcpy(nrt0201_tagname_map[ 41], "SpecificationVersionNumber");
-    strcpy(nrt0201_tagname_map[ 42], "SupplementaryServiceCode");
-    strcpy(nrt0201_tagname_map[ 43], "TeleServiceCode");
-    strcpy(nrt0201_tagname_map[ 44], "ThirdPartyNumber");
-    strcpy(nrt0201_tagname_map[ 45], "UtcTimeOffset");
+#define TAGNAME_MEMBER(tag, name)   char t##tag[sizeof(#name)];
+#define TAGNAME_STRING(tag, name)   #name,
+#define TAGNAME_OFFSET(tag, name)   [tag] = offsetof(struct TAGNAME_POOL, t##tag),
 
-    /*
-     * RAP01XX
-     */
-    strcpy(rap01XX_tagname_map[  7], "VasInfoList");
-    strcpy(rap01XX_tagname_map[  8], "MessageDescriptionInfoList");
-    strcpy(rap01XX_tagname_map[143], "MessageDescriptionInformationDefinition");
-    strcpy(rap01XX_tagname_map[238], "VasInformationDefinition");
-    strcpy(rap01XX_tagname_map[512], "AccountingInfoError");
-    strcpy(rap01XX_tagname_map[513], "AuditControlInfoError");
-    strcpy(rap01XX_tagname_map[515], "AckFileAvailableTimeStamp");
-    strcpy(rap01XX_tagname_map[516], "AckFileCreationTimeStamp");
-    strcpy(rap01XX_tagname_map[517], "BatchControlError");
-    strcpy(rap01XX_tagname_map[518], "EndMissingSeqNumber");
-    strcpy(rap01XX_tagname_map[519], "ErrorCode");
-    strcpy(rap01XX_tagname_map[520], "ErrorDetailList");
-    strcpy(rap01XX_tagname_map[521], "ErrorDetail");
-    strcpy(rap01XX_tagname_map[522], "MessageDescriptionError");
-    strcpy(rap01XX_tagname_map[523], "NetworkInfoError");
-    strcpy(rap01XX_tagname_map[524], "ItemOffset");
-    strcpy(rap01XX_tagname_map[525], "RapFileAvailableTimeStamp");
-    strcpy(rap01XX_tagname_map[526], "RapFileCreationTimeStamp");
-    strcpy(rap01XX_tagname_map[527], "VASInformationError");
-    strcpy(rap01XX_tagname_map[528], "ReturnDetailsCount");
-    strcpy(rap01XX_tagname_map[529], "SevereReturnValue");
-    strcpy(rap01XX_tagname_map[530], "ReturnSummary");
-    strcpy(rap01XX_tagname_map[531], "ReturnSummaryList");
-    strcpy(rap01XX_tagname_map[532], "StartMissingSeqNumber");
-    strcpy(rap01XX_tagname_map[533], "TotalSevereReturnValue");
-    strcpy(rap01XX_tagname_map[534], "ReturnBatch");
-    strcpy(rap01XX_tagname_map[535], "Acknowledgement");
-    strcpy(rap01XX_tagname_map[536], "ReturnDetailList");
-    strcpy(rap01XX_tagname_map[537], "RapBatchControlInfo");
-    strcpy(rap01XX_tagname_map[538], "MissingReturn");
-    strcpy(rap01XX_tagname_map[539], "FatalReturn");
-    strcpy(rap01XX_tagname_map[540], "SevereReturn");
-    strcpy(rap01XX_tagname_map[541], "RapAuditControlInfo");
-    strcpy(rap01XX_tagname_map[542], "TransferBatchError");
-    strcpy(rap01XX_tagname_map[543], "RapReleaseVersionNumber");
-    strcpy(rap01XX_tagname_map[544], "RapSpecificationVersionNumber");
-    strcpy(rap01XX_tagname_map[545], "ErrorContext");
-    strcpy(rap01XX_tagname_map[546], "PathItemId");
-    strcpy(rap01XX_tagname_map[547], "ItemOccurrence");
-    strcpy(rap01XX_tagname_map[548], "ItemLevel");
-    strcpy(rap01XX_tagname_map[549], "ErrorContextList");
-    strcpy(rap01XX_tagname_map[550], "RoamingPartner");
-    strcpy(rap01XX_tagname_map[551], "OperatorSpecList");
-    strcpy(rap01XX_tagname_map[552], "NotificationError");
-    strcpy(rap01XX_tagname_map[553], "TotalSevereReturnTax");
+#define TAGNAME_POOL nrt0201_pool
+static const struct nrt0201_pool { char t0; NRT0201_TAGS(TAGNAME_MEMBER) } nrt0201_pool = { '\0', NRT0201_TAGS(TAGNAME_STRING) };
+static const unsigned int nrt0201_idx[MAXTAGS] = { NRT0201_TAGS(TAGNAME_OFFSET) };
+#undef TAGNAME_POOL
 
-    /*
-     * TAP03 release less and equal than 09
-     */
-    strcpy(tap03le09_tagname_map[  1], "TransferBatch");
-    strcpy(tap03le09_tagname_map[  2], "Notification");
-    strcpy(tap03le09_tagname_map[  3], "CallEventDetailList");
-    strcpy(tap03le09_tagname_map[  4], "BatchControlInfo");
-    strcpy(tap03le09_tagname_map[  5], "AccountingInfo");
-    strcpy(tap03le09_tagname_map[  6], "NetworkInfo");
-    strcpy(tap03le09_tagname_map[  7], "VasInfo");
-    strcpy(tap03le09_tagname_map[  8], "MessageDescriptionInfo");
-    strcpy(tap03le09_tagname_map[  9], "MobileOriginatedCall");
-    strcpy(tap03le09_tagname_map[ 10], "MobileTerminatedCall");
-    strcpy(tap03le09_tagname_map[ 11], "SupplServiceEvent");
-    strcpy(tap03le09_tagname_map[ 12], "ServiceCentreUsage");
-    strcpy(tap03le09_tagname_map[ 13], "ValueAddedService");
-    strcpy(tap03le09_tagname_map[ 14], "GprsCall");
-    strcpy(tap03le09_tagname_map[ 15], "AuditControlInfo");
-    strcpy(tap03le09_tagname_map[ 16], "LocalTimeStamp");
-    strcpy(tap03le09_tagname_map[ 17], "ContentTransaction");
-    strcpy(tap03le09_tagname_map[ 32], "AccessPointName");
-    strcpy(tap03le09_tagname_map[ 33], "AddressStringDigits");
-    strcpy(tap03le09_tagname_map[ 34], "AiurRequested");
-    strcpy(tap03le09_tagname_map[ 35], "BasicHSCSDParameters");
-    strcpy(tap03le09_tagname_map[ 36], "BasicService");
-    strcpy(tap03le09_tagname_map[ 37], "BasicServiceCodeList");
-    strcpy(tap03le09_tagname_map[ 38], "BasicServiceUsedList");
-    strcpy(tap03le09_tagname_map[ 39], "BasicServiceUsed");
-    strcpy(tap03le09_tagname_map[ 40], "BearerServiceCode");
-    strcpy(tap03le09_tagname_map[ 41], "CallOriginator");
-    strcpy(tap03le09_tagname_map[ 42], "CalledPlace");
-    strcpy(tap03le09_tagname_map[ 43], "CallEventDetailsCount");
-    strcpy(tap03le09_tagname_map[ 44], "CallEventStartTimeStamp");
-    strcpy(tap03le09_tagname_map[ 45], "CallReference");
-    strcpy(tap03le09_tagname_map[ 46], "CalledRegion");
-    strcpy(tap03le09_tagname_map[ 47], "CallType");
-    strcpy(tap03le09_tagname_map[ 48], "CallTypeSubtype");
-    strcpy(tap03le09_tagname_map[ 49], "CamelCallReference");
-    strcpy(tap03le09_tagname_map[ 50], "CamelCallReferenceNumber");
-    strcpy(tap03le09_tagname_map[ 51], "CamelDestination");
-    strcpy(tap03le09_tagname_map[ 52], "CamelInitiatedCFIndicator");
-    strcpy(tap03le09_tagname_map[ 53], "CamelModification");
-    strcpy(tap03le09_tagname_map[ 54], "CamelModificationList");
-    strcpy(tap03le09_tagname_map[ 55], "CamelServiceKey");
-    strcpy(tap03le09_tagname_map[ 56], "CamelServiceLevel");
-    strcpy(tap03le09_tagname_map[ 57], "CamelServiceUsed");
-    strcpy(tap03le09_tagname_map[ 58], "CauseForTerm");
-    strcpy(tap03le09_tagname_map[ 59], "CellId");
-    strcpy(tap03le09_tagname_map[ 60], "ChannelCoding");
-    strcpy(tap03le09_tagname_map[ 61], "ChannelCodingsAcceptable");
-    strcpy(tap03le09_tagname_map[ 62], "Charge");
-    strcpy(tap03le09_tagname_map[ 63], "ChargeDetail");
-    strcpy(tap03le09_tagname_map[ 64], "ChargeDetailList");
-    strcpy(tap03le09_tagname_map[ 65], "ChargeableUnits");
-    strcpy(tap03le09_tagname_map[ 66], "ChargedItem");
-    strcpy(tap03le09_tagname_map[ 67], "ChargedPartyStatus");
-    strcpy(tap03le09_tagname_map[ 68], "ChargedUnits");
-    strcpy(tap03le09_tagname_map[ 69], "ChargeInformation");
-    strcpy(tap03le09_tagname_map[ 70], "ChargeInformationList");
-    strcpy(tap03le09_tagname_map[ 71], "ChargeType");
-    strcpy(tap03le09_tagname_map[ 72], "ChargingId");
-    strcpy(tap03le09_tagname_map[ 73], "ChargingPoint");
-    strcpy(tap03le09_tagname_map[ 74], "ChargingTimeStamp");
-    strcpy(tap03le09_tagname_map[ 75], "ClirIndicator");
-    strcpy(tap03le09_tagname_map[ 76], "CompletionTimeStamp");
-    strcpy(tap03le09_tagname_map[ 77], "CountryCode");
-    strcpy(tap03le09_tagname_map[ 78], "CountryCodeTable");
-    strcpy(tap03le09_tagname_map[ 79], "CseInformation");
-    strcpy(tap03le09_tagname_map[ 80], "CurrencyConversion");
-    strcpy(tap03le09_tagname_map[ 81], "DataVolume");
-    strcpy(tap03le09_tagname_map[ 82], "DataVolumeReference");
-    strcpy(tap03le09_tagname_map[ 83], "DateTime");
-    strcpy(tap03le09_tagname_map[ 84], "DateTimeLong");
-    strcpy(tap03le09_tagname_map[ 85], "DayCategory");
-    strcpy(tap03le09_tagname_map[ 86], "DayCategorySubtype");
-    strcpy(tap03le09_tagname_map[ 87], "DefaultCallHandlingIndicator");
-    strcpy(tap03le09_tagname_map[ 88], "DepositTimeStamp");
-    strcpy(tap03le09_tagname_map[ 89], "Destination");
-    strcpy(tap03le09_tagname_map[ 90], "DestinationNetwork");
-    strcpy(tap03le09_tagname_map[ 91], "DiscountCode");
-    strcpy(tap03le09_tagname_map[ 92], "DiscountRate");
-    strcpy(tap03le09_tagname_map[ 93], "DiscountValue");
-    strcpy(tap03le09_tagname_map[ 94], "DiscountDefinition");
-    strcpy(tap03le09_tagname_map[ 95], "Discounting");
-    strcpy(tap03le09_tagname_map[ 96], "DiscountInformation");
-    strcpy(tap03le09_tagname_map[ 97], "DiscountInformationList");
-    strcpy(tap03le09_tagname_map[ 98], "DistanceChargeBandCode");
-    strcpy(tap03le09_tagname_map[ 99], "DualBearerServiceCode");
-    strcpy(tap03le09_tagname_map[100], "DualTeleServiceCode");
-    strcpy(tap03le09_tagname_map[101], "EarliestCallTimeStamp");
-    strcpy(tap03le09_tagname_map[102], "EquipmentInformation");
-    strcpy(tap03le09_tagname_map[103], "Esn");
-    strcpy(tap03le09_tagname_map[104], "ExchangeRate");
-    strcpy(tap03le09_tagname_map[105], "ExchangeRateCode");
-    strcpy(tap03le09_tagname_map[106], "ExchangeRateDefinition");
-    strcpy(tap03le09_tagname_map[107], "FileAvailableTimeStamp");
-    strcpy(tap03le09_tagname_map[108], "FileCreationTimeStamp");
-    strcpy(tap03le09_tagname_map[109], "FileSequenceNumber");
-    strcpy(tap03le09_tagname_map[110], "FileTypeIndicator");
-    strcpy(tap03le09_tagname_map[111], "Fnur");
-    strcpy(tap03le09_tagname_map[112], "FraudMonitorIndicator");
-    strcpy(tap03le09_tagname_map[113], "GeographicalLocation");
-    strcpy(tap03le09_tagname_map[114], "GprsBasicCallInformation");
-    strcpy(tap03le09_tagname_map[115], "GprsChargeableSubscriber");
-    strcpy(tap03le09_tagname_map[116], "GprsDestination");
-    strcpy(tap03le09_tagname_map[117], "GprsLocationInformation");
-    strcpy(tap03le09_tagname_map[118], "GprsNetworkLocation");
-    strcpy(tap03le09_tagname_map[119], "GprsServiceUsage");
-    strcpy(tap03le09_tagname_map[120], "GprsServiceUsageList");
-    strcpy(tap03le09_tagname_map[121], "GprsServiceUsed");
-    strcpy(tap03le09_tagname_map[122], "HomeBid");
-    strcpy(tap03le09_tagname_map[123], "HomeLocationInformation");
-    strcpy(tap03le09_tagname_map[124], "HSCSDInformation");
-    strcpy(tap03le09_tagname_map[125], "HSCSDParameterModification");
-    strcpy(tap03le09_tagname_map[126], "Iac");
-    strcpy(tap03le09_tagname_map[127], "IacTable");
-    strcpy(tap03le09_tagname_map[128], "Imei");
-    strcpy(tap03le09_tagname_map[129], "Imsi");
-    strcpy(tap03le09_tagname_map[130], "InitiatingParty");
-    strcpy(tap03le09_tagname_map[131], "IPTextV4Address");
-    strcpy(tap03le09_tagname_map[132], "IPTextV6Address");
-    strcpy(tap03le09_tagname_map[133], "LatestCallTimeStamp");
-    strcpy(tap03le09_tagname_map[134], "Latitude");
-    strcpy(tap03le09_tagname_map[135], "LocalCurrency");
-    strcpy(tap03le09_tagname_map[136], "LocationArea");
-    strcpy(tap03le09_tagname_map[137], "LocationDescription");
-    strcpy(tap03le09_tagname_map[138], "LocationInformation");
-    strcpy(tap03le09_tagname_map[139], "Longitude");
-    strcpy(tap03le09_tagname_map[140], "HSCSDParameterModificationList");
-    strcpy(tap03le09_tagname_map[141], "MessageDescriptionCode");
-    strcpy(tap03le09_tagname_map[142], "MessageDescription");
-    strcpy(tap03le09_tagname_map[143], "MessageDescriptionDefinition");
-    strcpy(tap03le09_tagname_map[144], "MessageStatus");
-    strcpy(tap03le09_tagname_map[145], "MessageType");
-    strcpy(tap03le09_tagname_map[146], "Min");
-    strcpy(tap03le09_tagname_map[147], "MoBasicCallInformation");
-    strcpy(tap03le09_tagname_map[148], "MobileStationClassMark");
-    strcpy(tap03le09_tagname_map[149], "ModificationIndicator");
-    strcpy(tap03le09_tagname_map[150], "ModificationTimestamp");
-    strcpy(tap03le09_tagname_map[151], "MscId");
-    strcpy(tap03le09_tagname_map[152], "Msisdn");
-    strcpy(tap03le09_tagname_map[153], "MtBasicCallInformation");
-    strcpy(tap03le09_tagname_map[154], "MultiRateIndicator");
-    strcpy(tap03le09_tagname_map[155], "NetworkId");
-    strcpy(tap03le09_tagname_map[156], "NetworkLocation");
-    strcpy(tap03le09_tagname_map[157], "NetworkType");
-    strcpy(tap03le09_tagname_map[158], "NonChargedParty");
-    strcpy(tap03le09_tagname_map[159], "NumberOfDecimalPlaces");
-    strcpy(tap03le09_tagname_map[160], "NumberingPlan");
-    strcpy(tap03le09_tagname_map[161], "NumberOfChannels");
-    strcpy(tap03le09_tagname_map[162], "OperatorSpecInfoList");
-    strcpy(tap03le09_tagname_map[163], "OperatorSpecInformation");
-    strcpy(tap03le09_tagname_map[164], "OriginatingNetwork");
-    strcpy(tap03le09_tagname_map[165], "PacketDataProtocolAddress");
-    strcpy(tap03le09_tagname_map[166], "PartialTypeIndicator");
-    strcpy(tap03le09_tagname_map[167], "PdpAddress");
-    strcpy(tap03le09_tagname_map[168], "PdpType");
-    strcpy(tap03le09_tagname_map[169], "PlmnId");
-    strcpy(tap03le09_tagname_map[170], "PriorityCode");
-    strcpy(tap03le09_tagname_map[171], "QoSDelay");
-    strcpy(tap03le09_tagname_map[172], "QoSInformation");
-    strcpy(tap03le09_tagname_map[173], "QoSMeanThroughput");
-    strcpy(tap03le09_tagname_map[174], "QoSPeakThroughput");
-    strcpy(tap03le09_tagname_map[175], "QoSPrecedence");
-    strcpy(tap03le09_tagname_map[176], "QoSReliability");
-    strcpy(tap03le09_tagname_map[177], "QoSRequested");
-    strcpy(tap03le09_tagname_map[178], "QoSUsed");
-    strcpy(tap03le09_tagname_map[179], "RadioChannelRequested");
-    strcpy(tap03le09_tagname_map[180], "RadioChannelUsed");
-    strcpy(tap03le09_tagname_map[181], "RapFileSequenceNumber");
-    strcpy(tap03le09_tagname_map[182], "Recipient");
-    strcpy(tap03le09_tagname_map[183], "RecEntityDefinition");
-    strcpy(tap03le09_tagname_map[184], "RecEntityCode");
-    strcpy(tap03le09_tagname_map[185], "RecEntityCodeList");
-    strcpy(tap03le09_tagname_map[186], "RecEntityType");
-    strcpy(tap03le09_tagname_map[188], "RecEntityTable");
-    strcpy(tap03le09_tagname_map[189], "ReleaseVersionNumber");
-    strcpy(tap03le09_tagname_map[190], "RemotePdpAddressList");
-    strcpy(tap03le09_tagname_map[191], "ScuBasicInformation");
-    strcpy(tap03le09_tagname_map[192], "ScuChargeType");
-    strcpy(tap03le09_tagname_map[193], "ScuTimeStamps");
-    strcpy(tap03le09_tagname_map[195], "ServingNetwork");
-    strcpy(tap03le09_tagname_map[196], "Sender");
-    strcpy(tap03le09_tagname_map[197], "ServiceCentreIdentity");
-    strcpy(tap03le09_tagname_map[198], "ServingBid");
-    strcpy(tap03le09_tagname_map[199], "SimChargeableSubscriber");
-    strcpy(tap03le09_tagname_map[200], "SimToolkitIndicator");
-    strcpy(tap03le09_tagname_map[201], "SpecificationVersionNumber");
-    strcpy(tap03le09_tagname_map[202], "SpeechVersionRequested");
-    strcpy(tap03le09_tagname_map[203], "SpeechVersionUsed");
-    strcpy(tap03le09_tagname_map[204], "SsParameters");
-    strcpy(tap03le09_tagname_map[206], "SupplServiceUsed");
-    strcpy(tap03le09_tagname_map[207], "SupplServiceUsedList");
-    strcpy(tap03le09_tagname_map[208], "SupplServiceActionCode");
-    strcpy(tap03le09_tagname_map[209], "SupplServiceCode");
-    strcpy(tap03le09_tagname_map[210], "TapCurrency");
-    strcpy(tap03le09_tagname_map[211], "Taxation");
-    strcpy(tap03le09_tagname_map[212], "TaxCode");
-    strcpy(tap03le09_tagname_map[213], "TaxInformation");
-    strcpy(tap03le09_tagname_map[214], "TaxInformationList");
-    strcpy(tap03le09_tagname_map[215], "TaxRate");
-    strcpy(tap03le09_tagname_map[216], "TaxRateDefinition");
-    strcpy(tap03le09_tagname_map[217], "TaxType");
-    strcpy(tap03le09_tagname_map[218], "TeleServiceCode");
-    strcpy(tap03le09_tagname_map[219], "ThirdPartyInformation");
-    strcpy(tap03le09_tagname_map[220], "TimeBand");
-    strcpy(tap03le09_tagname_map[221], "TimeBandSubtype");
-    strcpy(tap03le09_tagname_map[222], "TotalChargeValue");
-    strcpy(tap03le09_tagname_map[223], "TotalCallEventDuration");
-    strcpy(tap03le09_tagname_map[224], "TotalChargeValueList");
-    strcpy(tap03le09_tagname_map[225], "TotalDiscountValue");
-    strcpy(tap03le09_tagname_map[226], "TotalTaxValue");
-    strcpy(tap03le09_tagname_map[227], "TransferCutOffTimeStamp");
-    strcpy(tap03le09_tagname_map[228], "TransparencyIndicator");
-    strcpy(tap03le09_tagname_map[229], "TypeOfControllingNode");
-    strcpy(tap03le09_tagname_map[230], "TypeOfNumber");
-    strcpy(tap03le09_tagname_map[231], "UtcTimeOffset");
-    strcpy(tap03le09_tagname_map[232], "UtcTimeOffsetCode");
-    strcpy(tap03le09_tagname_map[233], "UtcTimeOffsetDefinition");
-    strcpy(tap03le09_tagname_map[234], "UtcTimeOffsetInfo");
-    strcpy(tap03le09_tagname_map[235], "ValueAddedServiceUsedList");
-    strcpy(tap03le09_tagname_map[236], "ValueAddedServiceUsed");
-    strcpy(tap03le09_tagname_map[237], "VasCode");
-    strcpy(tap03le09_tagname_map[238], "VasDefinition");
-    strcpy(tap03le09_tagname_map[239], "VasDescription");
-    strcpy(tap03le09_tagname_map[240], "VasShortDescription");
-    strcpy(tap03le09_tagname_map[241], "AbsoluteAmount");
-    strcpy(tap03le09_tagname_map[242], "Bid");
-    strcpy(tap03le09_tagname_map[243], "Code");
-    strcpy(tap03le09_tagname_map[244], "TapDecimalPlaces");
-    strcpy(tap03le09_tagname_map[245], "NetworkInitPDPContext");
-    strcpy(tap03le09_tagname_map[246], "CalledNumAnalysis");
-    strcpy(tap03le09_tagname_map[247], "CalledNumAnalysisCode");
-    strcpy(tap03le09_tagname_map[249], "CalledNumAnalysisList");
-    strcpy(tap03le09_tagname_map[250], "DataVolumeIncoming");
-    strcpy(tap03le09_tagname_map[251], "DataVolumeOutgoing");
-    strcpy(tap03le09_tagname_map[252], "NumberOfChannelsUsed");
-    strcpy(tap03le09_tagname_map[253], "Mdn");
-    strcpy(tap03le09_tagname_map[254], "MinChargeableSubscriber");
-    strcpy(tap03le09_tagname_map[255], "CallTypeLevel2");
-    strcpy(tap03le09_tagname_map[256], "CallTypeLevel3");
-    strcpy(tap03le09_tagname_map[257], "CalledCountryCode");
-    strcpy(tap03le09_tagname_map[258], "CallTypeGroup");
-    strcpy(tap03le09_tagname_map[259], "CallTypeLevel1");
-    strcpy(tap03le09_tagname_map[260], "PDPContextStartTimestamp");
-    strcpy(tap03le09_tagname_map[261], "AccessPointNameNI");
-    strcpy(tap03le09_tagname_map[262], "AccessPointNameOI");
-    strcpy(tap03le09_tagname_map[263], "ChargingCharacteristics");
-    strcpy(tap03le09_tagname_map[264], "QoSMaxBitRateUplink");
-    strcpy(tap03le09_tagname_map[265], "QoSMaxSDUsize");
-    strcpy(tap03le09_tagname_map[266], "QoSResidualBER");
-    strcpy(tap03le09_tagname_map[267], "QoSSDUErrorRatio");
-    strcpy(tap03le09_tagname_map[268], "QoSTrafficClass");
-    strcpy(tap03le09_tagname_map[269], "QoSTransferDelay");
-    strcpy(tap03le09_tagname_map[270], "UMTSQoSRequested");
-    strcpy(tap03le09_tagname_map[271], "UMTSQoSUsed");
-    strcpy(tap03le09_tagname_map[272], "GSMQoSRequested");
-    strcpy(tap03le09_tagname_map[273], "GSMQoSUsed");
-    strcpy(tap03le09_tagname_map[274], "QoSMaxBitRateDownlink");
-    strcpy(tap03le09_tagname_map[275], "QoSAllocRetenPriority");
-    strcpy(tap03le09_tagname_map[276], "QoSHandlingpriority");
-    strcpy(tap03le09_tagname_map[277], "QoSErroneousSDUs");
-    strcpy(tap03le09_tagname_map[278], "QoSDeliveryOrder");
-    strcpy(tap03le09_tagname_map[279], "DialledDigits");
-    strcpy(tap03le09_tagname_map[280], "UserProtocolIndicator");
-    strcpy(tap03le09_tagname_map[281], "ObjectType");
-    strcpy(tap03le09_tagname_map[283], "QoSGuaranteedBitRateDownlink");
-    strcpy(tap03le09_tagname_map[284], "QoSGuaranteedBitRateUplink");
-    strcpy(tap03le09_tagname_map[285], "ContentServiceUsedList");
-    strcpy(tap03le09_tagname_map[286], "GsmChargeableSubscriber");
-    strcpy(tap03le09_tagname_map[287], "ChargedPartyIdentifier");
-    strcpy(tap03le09_tagname_map[288], "HomeIdentifier");
-    strcpy(tap03le09_tagname_map[289], "LocationIdentifier");
-    strcpy(tap03le09_tagname_map[290], "EquipmentId");
-    strcpy(tap03le09_tagname_map[291], "ContentProviderIdType");
-    strcpy(tap03le09_tagname_map[292], "ContentProviderIdentifier");
-    strcpy(tap03le09_tagname_map[293], "IspIdType");
-    strcpy(tap03le09_tagname_map[294], "IspIdentifier");
-    strcpy(tap03le09_tagname_map[295], "NetworkIdentifier");
-    strcpy(tap03le09_tagname_map[296], "GmlcAddress");
-    strcpy(tap03le09_tagname_map[297], "LocationService");
-    strcpy(tap03le09_tagname_map[298], "TrackingCustomerInformation");
-    strcpy(tap03le09_tagname_map[299], "TrackingCustomerIdList");
-    strcpy(tap03le09_tagname_map[300], "OrderPlacementTimeStamp");
-    strcpy(tap03le09_tagname_map[301], "RequestedDeliveryTimeStamp");
-    strcpy(tap03le09_tagname_map[302], "ActualDeliveryTimeStamp");
-    strcpy(tap03le09_tagname_map[303], "TransactionStatus");
-    strcpy(tap03le09_tagname_map[304], "ContentTransactionBasicInfo");
-    strcpy(tap03le09_tagname_map[305], "ChargedPartyIdType");
-    strcpy(tap03le09_tagname_map[306], "LoginName");
-    strcpy(tap03le09_tagname_map[307], "AccountNumber");
-    strcpy(tap03le09_tagname_map[308], "EmailAddress");
-    strcpy(tap03le09_tagname_map[309], "ChargedPartyId");
-    strcpy(tap03le09_tagname_map[310], "ChargedPartyIdList");
-    strcpy(tap03le09_tagname_map[311], "HomeIdType");
-    strcpy(tap03le09_tagname_map[312], "Name");
-    strcpy(tap03le09_tagname_map[313], "ChargedPartyHomeId");
-    strcpy(tap03le09_tagname_map[314], "ChargedPartyHomeIdList");
-    strcpy(tap03le09_tagname_map[315], "LocationIdType");
-    strcpy(tap03le09_tagname_map[316], "CountryName");
-    strcpy(tap03le09_tagname_map[317], "CountryAsciCode");
-    strcpy(tap03le09_tagname_map[318], "Region");
-    strcpy(tap03le09_tagname_map[319], "Place");
-    strcpy(tap03le09_tagname_map[320], "ChargedPartyLocation");
-    strcpy(tap03le09_tagname_map[321], "ChargedPartyLocationList");
-    strcpy(tap03le09_tagname_map[322], "EquipmentIdType");
-    strcpy(tap03le09_tagname_map[323], "ChargedPartyEquipment");
-    strcpy(tap03le09_tagname_map[324], "ChargedPartyInformation");
-    strcpy(tap03le09_tagname_map[325], "ProviderIdType");
-    strcpy(tap03le09_tagname_map[326], "Url");
-    strcpy(tap03le09_tagname_map[327], "ContentProviderId");
-    strcpy(tap03le09_tagname_map[328], "ContentProviderIdList");
-    strcpy(tap03le09_tagname_map[329], "InternetServiceProviderId");
-    strcpy(tap03le09_tagname_map[330], "InternetServiceProviderIdList");
-    strcpy(tap03le09_tagname_map[331], "NetworkIdType");
-    strcpy(tap03le09_tagname_map[332], "NetworkIdGroup");
-    strcpy(tap03le09_tagname_map[333], "NetworkIdList");
-    strcpy(tap03le09_tagname_map[334], "ContentProviderName");
-    strcpy(tap03le09_tagname_map[335], "ServingPartiesInformation");
-    strcpy(tap03le09_tagname_map[336], "ContentTransactionCode");
-    strcpy(tap03le09_tagname_map[337], "ContentTransactionType");
-    strcpy(tap03le09_tagname_map[338], "TransactionDescriptionSupp");
-    strcpy(tap03le09_tagname_map[339], "TransactionDetailDescription");
-    strcpy(tap03le09_tagname_map[340], "TransactionShortDescription");
-    strcpy(tap03le09_tagname_map[341], "TransactionIdentifier");
-    strcpy(tap03le09_tagname_map[342], "TransactionAuthCode");
-    strcpy(tap03le09_tagname_map[343], "TotalDataVolume");
-    strcpy(tap03le09_tagname_map[344], "ChargeRefundIndicator");
-    strcpy(tap03le09_tagname_map[345], "ContentChargingPoint");
-    strcpy(tap03le09_tagname_map[346], "PaidIndicator");
-    strcpy(tap03le09_tagname_map[347], "PaymentMethod");
-    strcpy(tap03le09_tagname_map[348], "AdvisedChargeCurrency");
-    strcpy(tap03le09_tagname_map[349], "AdvisedCharge");
-    strcpy(tap03le09_tagname_map[350], "Commission");
-    strcpy(tap03le09_tagname_map[351], "AdvisedChargeInformation");
-    strcpy(tap03le09_tagname_map[352], "ContentServiceUsed");
-    strcpy(tap03le09_tagname_map[353], "TotalTaxRefund");
-    strcpy(tap03le09_tagname_map[354], "TotalDiscountRefund");
-    strcpy(tap03le09_tagname_map[355], "TotalChargeRefund");
-    strcpy(tap03le09_tagname_map[356], "TotalAdvisedCharge");
-    strcpy(tap03le09_tagname_map[357], "TotalAdvisedChargeRefund");
-    strcpy(tap03le09_tagname_map[358], "TotalCommission");
-    strcpy(tap03le09_tagname_map[359], "TotalCommissionRefund");
-    strcpy(tap03le09_tagname_map[360], "TotalAdvisedChargeValue");
-    strcpy(tap03le09_tagname_map[361], "TotalAdvisedChargeValueList");
-    strcpy(tap03le09_tagname_map[362], "TrackingCustomerIdentification");
-    strcpy(tap03le09_tagname_map[363], "CustomerIdType");
-    strcpy(tap03le09_tagname_map[364], "CustomerIdentifier");
-    strcpy(tap03le09_tagname_map[365], "TrackingCustomerHomeIdList");
-    strcpy(tap03le09_tagname_map[366], "TrackingCustomerHomeId");
-    strcpy(tap03le09_tagname_map[367], "TrackedCustomerInformation");
-    strcpy(tap03le09_tagname_map[368], "TrackingCustomerLocList");
-    strcpy(tap03le09_tagname_map[369], "TrackingCustomerLocation");
-    strcpy(tap03le09_tagname_map[370], "TrackedCustomerIdList");
-    strcpy(tap03le09_tagname_map[371], "TrackingCustomerEquipment");
-    strcpy(tap03le09_tagname_map[372], "TrackedCustomerIdentification");
-    strcpy(tap03le09_tagname_map[373], "LCSSPInformation");
-    strcpy(tap03le09_tagname_map[374], "LCSSPIdentificationList");
-    strcpy(tap03le09_tagname_map[375], "LCSSPIdentification");
-    strcpy(tap03le09_tagname_map[376], "TrackedCustomerHomeIdList");
-    strcpy(tap03le09_tagname_map[377], "TrackedCustomerHomeId");
-    strcpy(tap03le09_tagname_map[378], "ISPList");
-    strcpy(tap03le09_tagname_map[379], "TrackedCustomerLocList");
-    strcpy(tap03le09_tagname_map[380], "TrackedCustomerLocation");
-    strcpy(tap03le09_tagname_map[381], "TrackedCustomerEquipment");
-    strcpy(tap03le09_tagname_map[382], "LocationServiceUsage");
-    strcpy(tap03le09_tagname_map[383], "LCSQosRequested");
-    strcpy(tap03le09_tagname_map[384], "LCSRequestTimestamp");
-    strcpy(tap03le09_tagname_map[385], "HorizontalAccuracyRequested");
-    strcpy(tap03le09_tagname_map[386], "VerticalAccuracyRequested");
-    strcpy(tap03le09_tagname_map[387], "ResponseTimeCategory");
-    strcpy(tap03le09_tagname_map[388], "TrackingPeriod");
-    strcpy(tap03le09_tagname_map[389], "TrackingFrequency");
-    strcpy(tap03le09_tagname_map[390], "LCSQosDelivered");
-    strcpy(tap03le09_tagname_map[391], "LCSTransactionStatus");
-    strcpy(tap03le09_tagname_map[392], "HorizontalAccuracyDelivered");
-    strcpy(tap03le09_tagname_map[393], "VerticalAccuracyDelivered");
-    strcpy(tap03le09_tagname_map[394], "ResponseTime");
-    strcpy(tap03le09_tagname_map[395], "PositioningMethod");
-    strcpy(tap03le09_tagname_map[396], "AgeOfLocation");
-    strcpy(tap03le09_tagname_map[397], "TaxValue");
-    strcpy(tap03le09_tagname_map[398], "TaxableAmount");
-    strcpy(tap03le09_tagname_map[399], "CamelServerAddress");
-    strcpy(tap03le09_tagname_map[400], "RecEntityId");
-    strcpy(tap03le09_tagname_map[402], "NonChargedNumber");
-    strcpy(tap03le09_tagname_map[403], "ThirdPartyNumber");
-    strcpy(tap03le09_tagname_map[404], "CamelDestinationNumber");
-    strcpy(tap03le09_tagname_map[405], "CallingNumber");
-    strcpy(tap03le09_tagname_map[407], "CalledNumber");
-    strcpy(tap03le09_tagname_map[410], "ChargeDetailTimeStamp");
-    strcpy(tap03le09_tagname_map[411], "FixedDiscountValue");
-    strcpy(tap03le09_tagname_map[412], "Discount");
-    strcpy(tap03le09_tagname_map[413], "HomeLocationDescription");
-    strcpy(tap03le09_tagname_map[414], "ServingLocationDescription");
-    strcpy(tap03le09_tagname_map[415], "TotalCharge");
-    strcpy(tap03le09_tagname_map[416], "TotalTransactionDuration");
-    strcpy(tap03le09_tagname_map[417], "NetworkAccessIdentifier");
-    strcpy(tap03le09_tagname_map[418], "IMSSignallingContext");
-    strcpy(tap03le09_tagname_map[419], "SMSDestinationNumber");
-    strcpy(tap03le09_tagname_map[420], "GuaranteedBitRate");
-    strcpy(tap03le09_tagname_map[421], "MaximumBitRate");
-    strcpy(tap03le09_tagname_map[422], "CamelInvocationFee");
-    strcpy(tap03le09_tagname_map[423], "DiscountableAmount");
-    strcpy(tap03le09_tagname_map[424], "HSCSDIndicator");
-    strcpy(tap03le09_tagname_map[425], "SMSOriginator");
-    strcpy(tap03le09_tagname_map[426], "BasicServiceCode");
-    strcpy(tap03le09_tagname_map[427], "ChargeableSubscriber");
-    strcpy(tap03le09_tagname_map[428], "DiscountApplied");
-    strcpy(tap03le09_tagname_map[429], "ImeiOrEsn");
-    strcpy(tap03le09_tagname_map[430], "ScuChargeableSubscriber");
-    strcpy(tap03le09_tagname_map[431], "ThreeGcamelDestination");
-    strcpy(tap03le09_tagname_map[432], "TaxIndicator");
-    strcpy(tap03le09_tagname_map[433], "MessagingEvent");
-    strcpy(tap03le09_tagname_map[434], "MobileSession");
-    strcpy(tap03le09_tagname_map[435], "EventReference");
-    strcpy(tap03le09_tagname_map[436], "ChargedParty");
-    strcpy(tap03le09_tagname_map[437], "ElementId");
-    strcpy(tap03le09_tagname_map[438], "ElementType");
-    strcpy(tap03le09_tagname_map[439], "MessagingEventService");
-    strcpy(tap03le09_tagname_map[440], "MobileSessionService");
-    strcpy(tap03le09_tagname_map[441], "NetworkElement");
-    strcpy(tap03le09_tagname_map[442], "NetworkElementList");
-    strcpy(tap03le09_tagname_map[443], "NonChargedParty");
-    strcpy(tap03le09_tagname_map[444], "NonChargedPartyNumber");
-    strcpy(tap03le09_tagname_map[445], "NonChargedPublicUserId");
-    strcpy(tap03le09_tagname_map[446], "PublicUserId");
-    strcpy(tap03le09_tagname_map[447], "ServiceStartTimestamp");
-    strcpy(tap03le09_tagname_map[448], "SessionChargeInfoList");
-    strcpy(tap03le09_tagname_map[449], "SessionChargeInformation");
+const tagmap_t nrt0201_tagname_map = { nrt0201_idx, (const char *)&nrt0201_pool, MAXTAGS, NULL };
 
-    /*
-     * TAP03 release bigger and equal than 10
-     */
-    strcpy(tap03ge10_tagname_map[  1], "TransferBatch");
-    strcpy(tap03ge10_tagname_map[  2], "Notification");
-    strcpy(tap03ge10_tagname_map[  3], "CallEventDetailList");
-    strcpy(tap03ge10_tagname_map[  4], "BatchControlInfo");
-    strcpy(tap03ge10_tagname_map[  5], "AccountingInfo");
-    strcpy(tap03ge10_tagname_map[  6], "NetworkInfo");
-    strcpy(tap03ge10_tagname_map[  7], "VasInfoList");
-    strcpy(tap03ge10_tagname_map[  8], "MessageDescriptionInfoList");
-    strcpy(tap03ge10_tagname_map[  9], "MobileOriginatedCall");
-    strcpy(tap03ge10_tagname_map[ 10], "MobileTerminatedCall");
-    strcpy(tap03ge10_tagname_map[ 11], "SupplServiceEvent");
-    strcpy(tap03ge10_tagname_map[ 12], "ServiceCentreUsage");
-    strcpy(tap03ge10_tagname_map[ 13], "ValueAddedService");
-    strcpy(tap03ge10_tagname_map[ 14], "GprsCall");
-    strcpy(tap03ge10_tagname_map[ 15], "AuditControlInfo");
-    strcpy(tap03ge10_tagname_map[ 16], "LocalTimeStamp");
-    strcpy(tap03ge10_tagname_map[ 17], "ContentTransaction");
-    strcpy(tap03ge10_tagname_map[ 32], "AccessPointName");
-    strcpy(tap03ge10_tagname_map[ 33], "AddressStringDigits");
-    strcpy(tap03ge10_tagname_map[ 34], "AiurRequested");
-    strcpy(tap03ge10_tagname_map[ 35], "BasicHSCSDParameters");
-    strcpy(tap03ge10_tagname_map[ 36], "BasicService");
-    strcpy(tap03ge10_tagname_map[ 37], "BasicServiceCodeList");
-    strcpy(tap03ge10_tagname_map[ 38], "BasicServiceUsedList");
-    strcpy(tap03ge10_tagname_map[ 39], "BasicServiceUsed");
-    strcpy(tap03ge10_tagname_map[ 40], "BearerServiceCode");
-    strcpy(tap03ge10_tagname_map[ 41], "CallOriginator");
-    strcpy(tap03ge10_tagname_map[ 42], "CalledPlace");
-    strcpy(tap03ge10_tagname_map[ 43], "CallEventDetailsCount");
-    strcpy(tap03ge10_tagname_map[ 44], "CallEventStartTimeStamp");
-    strcpy(tap03ge10_tagname_map[ 45], "CallReference");
-    strcpy(tap03ge10_tagname_map[ 46], "CalledRegion");
-    strcpy(tap03ge10_tagname_map[ 47], "CallType");
-    strcpy(tap03ge10_tagname_map[ 48], "CallTypeSubtype");
-    strcpy(tap03ge10_tagname_map[ 49], "CamelCallReference");
-    strcpy(tap03ge10_tagname_map[ 50], "CamelCallReferenceNumber");
-    strcpy(tap03ge10_tagname_map[ 51], "CamelDestination");
-    strcpy(tap03ge10_tagname_map[ 52], "CamelInitiatedCFIndicator");
-    strcpy(tap03ge10_tagname_map[ 53], "CamelModification");
-    strcpy(tap03ge10_tagname_map[ 54], "CamelModificationList");
-    strcpy(tap03ge10_tagname_map[ 55], "CamelServiceKey");
-    strcpy(tap03ge10_tagname_map[ 56], "CamelServiceLevel");
-    strcpy(tap03ge10_tagname_map[ 57], "CamelServiceUsed");
-    strcpy(tap03ge10_tagname_map[ 58], "CauseForTerm");
-    strcpy(tap03ge10_tagname_map[ 59], "CellId");
-    strcpy(tap03ge10_tagname_map[ 60], "ChannelCoding");
-    strcpy(tap03ge10_tagname_map[ 61], "ChannelCodingAcceptableList");
-    strcpy(tap03ge10_tagname_map[ 62], "Charge");
-    strcpy(tap03ge10_tagname_map[ 63], "ChargeDetail");
-    strcpy(tap03ge10_tagname_map[ 64], "ChargeDetailList");
-    strcpy(tap03ge10_tagname_map[ 65], "ChargeableUnits");
-    strcpy(tap03ge10_tagname_map[ 66], "ChargedItem");
-    strcpy(tap03ge10_tagname_map[ 67], "ChargedPartyStatus");
-    strcpy(tap03ge10_tagname_map[ 68], "ChargedUnits");
-    strcpy(tap03ge10_tagname_map[ 69], "ChargeInformation");
-    strcpy(tap03ge10_tagname_map[ 70], "ChargeInformationList");
-    strcpy(tap03ge10_tagname_map[ 71], "ChargeType");
-    strcpy(tap03ge10_tagname_map[ 72], "ChargingId");
-    strcpy(tap03ge10_tagname_map[ 73], "ChargingPoint");
-    strcpy(tap03ge10_tagname_map[ 74], "ChargingTimeStamp");
-    strcpy(tap03ge10_tagname_map[ 75], "ClirIndicator");
-    strcpy(tap03ge10_tagname_map[ 76], "CompletionTimeStamp");
-    strcpy(tap03ge10_tagname_map[ 77], "CountryCode");
-    strcpy(tap03ge10_tagname_map[ 78], "CountryCodeList");
-    strcpy(tap03ge10_tagname_map[ 79], "CseInformation");
-    strcpy(tap03ge10_tagname_map[ 80], "CurrencyConversionList");
-    strcpy(tap03ge10_tagname_map[ 81], "DataVolume");
-    strcpy(tap03ge10_tagname_map[ 82], "DataVolumeReference");
-    strcpy(tap03ge10_tagname_map[ 83], "DateTime");
-    strcpy(tap03ge10_tagname_map[ 84], "DateTimeLong");
-    strcpy(tap03ge10_tagname_map[ 85], "DayCategory");
-    strcpy(tap03ge10_tagname_map[ 86], "DayCategorySubtype");
-    strcpy(tap03ge10_tagname_map[ 87], "DefaultCallHandlingIndicator");
-    strcpy(tap03ge10_tagname_map[ 88], "DepositTimeStamp");
-    strcpy(tap03ge10_tagname_map[ 89], "Destination");
-    strcpy(tap03ge10_tagname_map[ 90], "DestinationNetwork");
-    strcpy(tap03ge10_tagname_map[ 91], "DiscountCode");
-    strcpy(tap03ge10_tagname_map[ 92], "DiscountRate");
-    strcpy(tap03ge10_tagname_map[ 93], "DiscountValue");
-    strcpy(tap03ge10_tagname_map[ 94], "Discounting");
-    strcpy(tap03ge10_tagname_map[ 95], "DiscountingList");
-    strcpy(tap03ge10_tagname_map[ 96], "DiscountInformation");
-    strcpy(tap03ge10_tagname_map[ 97], "DiscountInformationList");
-    strcpy(tap03ge10_tagname_map[ 98], "DistanceChargeBandCode");
-    strcpy(tap03ge10_tagname_map[ 99], "DualBearerServiceCode");
-    strcpy(tap03ge10_tagname_map[100], "DualTeleServiceCode");
-    strcpy(tap03ge10_tagname_map[101], "EarliestCallTimeStamp");
-    strcpy(tap03ge10_tagname_map[102], "EquipmentInformation");
-    strcpy(tap03ge10_tagname_map[103], "Esn");
-    strcpy(tap03ge10_tagname_map[104], "ExchangeRate");
-    strcpy(tap03ge10_tagname_map[105], "ExchangeRateCode");
-    strcpy(tap03ge10_tagname_map[106], "CurrencyConversion");
-    strcpy(tap03ge10_tagname_map[107], "FileAvailableTimeStamp");
-    strcpy(tap03ge10_tagname_map[108], "FileCreationTimeStamp");
-    strcpy(tap03ge10_tagname_map[109], "FileSequenceNumber");
-    strcpy(tap03ge10_tagname_map[110], "FileTypeIndicator");
-    strcpy(tap03ge10_tagname_map[111], "Fnur");
-    strcpy(tap03ge10_tagname_map[112], "FraudMonitorIndicator");
-    strcpy(tap03ge10_tagname_map[113], "GeographicalLocation");
-    strcpy(tap03ge10_tagname_map[114], "GprsBasicCallInformation");
-    strcpy(tap03ge10_tagname_map[115], "GprsChargeableSubscriber");
-    strcpy(tap03ge10_tagname_map[116], "GprsDestination");
-    strcpy(tap03ge10_tagname_map[117], "GprsLocationInformation");
-    strcpy(tap03ge10_tagname_map[118], "GprsNetworkLocation");
-    strcpy(tap03ge10_tagname_map[119], "GprsServiceUsage");
-    strcpy(tap03ge10_tagname_map[120], "GprsServiceUsageList");
-    strcpy(tap03ge10_tagname_map[121], "GprsServiceUsed");
-    strcpy(tap03ge10_tagname_map[122], "HomeBid");
-    strcpy(tap03ge10_tagname_map[123], "HomeLocationInformation");
-    strcpy(tap03ge10_tagname_map[124], "HSCSDInformation");
-    strcpy(tap03ge10_tagname_map[125], "HSCSDParameterModification");
-    strcpy(tap03ge10_tagname_map[126], "Iac");
-    strcpy(tap03ge10_tagname_map[127], "IacList");
-    strcpy(tap03ge10_tagname_map[128], "Imei");
-    strcpy(tap03ge10_tagname_map[129], "Imsi");
-    strcpy(tap03ge10_tagname_map[130], "InitiatingParty");
-    strcpy(tap03ge10_tagname_map[131], "IPTextV4Address");
-    strcpy(tap03ge10_tagname_map[132], "IPTextV6Address");
-    strcpy(tap03ge10_tagname_map[133], "LatestCallTimeStamp");
-    strcpy(tap03ge10_tagname_map[134], "Latitude");
-    strcpy(tap03ge10_tagname_map[135], "LocalCurrency");
-    strcpy(tap03ge10_tagname_map[136], "LocationArea");
-    strcpy(tap03ge10_tagname_map[137], "LocationDescription");
-    strcpy(tap03ge10_tagname_map[138], "LocationInformation");
-    strcpy(tap03ge10_tagname_map[139], "Longitude");
-    strcpy(tap03ge10_tagname_map[140], "HSCSDParameterModificationList");
-    strcpy(tap03ge10_tagname_map[141], "MessageDescriptionCode");
-    strcpy(tap03ge10_tagname_map[142], "MessageDescription");
-    strcpy(tap03ge10_tagname_map[143], "MessageDescriptionInformation");
-    strcpy(tap03ge10_tagname_map[144], "MessageStatus");
-    strcpy(tap03ge10_tagname_map[145], "MessageType");
-    strcpy(tap03ge10_tagname_map[146], "Min");
-    strcpy(tap03ge10_tagname_map[147], "MoBasicCallInformation");
-    strcpy(tap03ge10_tagname_map[148], "MobileStationClassMark");
-    strcpy(tap03ge10_tagname_map[149], "ModificationIndicator");
-    strcpy(tap03ge10_tagname_map[150], "ModificationTimestamp");
-    strcpy(tap03ge10_tagname_map[151], "MscId");
-    strcpy(tap03ge10_tagname_map[152], "Msisdn");
-    strcpy(tap03ge10_tagname_map[153], "MtBasicCallInformation");
-    strcpy(tap03ge10_tagname_map[154], "MultiRateIndicator");
-    strcpy(tap03ge10_tagname_map[155], "NetworkId");
-    strcpy(tap03ge10_tagname_map[156], "NetworkLocation");
-    strcpy(tap03ge10_tagname_map[157], "NetworkType");
-    strcpy(tap03ge10_tagname_map[158], "NonChargedParty");
-    strcpy(tap03ge10_tagname_map[159], "NumberOfDecimalPlaces");
-    strcpy(tap03ge10_tagname_map[160], "NumberingPlan");
-    strcpy(tap03ge10_tagname_map[161], "NumberOfChannels");
-    strcpy(tap03ge10_tagname_map[162], "OperatorSpecInfoList");
-    strcpy(tap03ge10_tagname_map[163], "OperatorSpecInformation");
-    strcpy(tap03ge10_tagname_map[164], "OriginatingNetwork");
-    strcpy(tap03ge10_tagname_map[165], "PacketDataProtocolAddress");
-    strcpy(tap03ge10_tagname_map[166], "PartialTypeIndicator");
-    strcpy(tap03ge10_tagname_map[167], "PdpAddress");
-    strcpy(tap03ge10_tagname_map[168], "PdpType");
-    strcpy(tap03ge10_tagname_map[169], "PlmnId");
-    strcpy(tap03ge10_tagname_map[170], "PriorityCode");
-    strcpy(tap03ge10_tagname_map[171], "QoSDelay");
-    strcpy(tap03ge10_tagname_map[172], "QoSInformation");
-    strcpy(tap03ge10_tagname_map[173], "QoSMeanThroughput");
-    strcpy(tap03ge10_tagname_map[174], "QoSPeakThroughput");
-    strcpy(tap03ge10_tagname_map[175], "QoSPrecedence");
-    strcpy(tap03ge10_tagname_map[176], "QoSReliability");
-    strcpy(tap03ge10_tagname_map[177], "QoSRequested");
-    strcpy(tap03ge10_tagname_map[178], "QoSUsed");
-    strcpy(tap03ge10_tagname_map[179], "RadioChannelRequested");
-    strcpy(tap03ge10_tagname_map[180], "RadioChannelUsed");
-    strcpy(tap03ge10_tagname_map[181], "RapFileSequenceNumber");
-    strcpy(tap03ge10_tagname_map[182], "Recipient");
-    strcpy(tap03ge10_tagname_map[183], "RecEntityInformation");
-    strcpy(tap03ge10_tagname_map[184], "RecEntityCode");
-    strcpy(tap03ge10_tagname_map[185], "RecEntityCodeList");
-    strcpy(tap03ge10_tagname_map[186], "RecEntityType");
-    strcpy(tap03ge10_tagname_map[188], "RecEntityInfoList");
-    strcpy(tap03ge10_tagname_map[189], "ReleaseVersionNumber");
-    strcpy(tap03ge10_tagname_map[190], "RemotePdpAddressList");
-    strcpy(tap03ge10_tagname_map[191], "ScuBasicInformation");
-    strcpy(tap03ge10_tagname_map[192], "ScuChargeType");
-    strcpy(tap03ge10_tagname_map[193], "ScuTimeStamps");
-    strcpy(tap03ge10_tagname_map[195], "ServingNetwork");
-    strcpy(tap03ge10_tagname_map[196], "Sender");
-    strcpy(tap03ge10_tagname_map[197], "ServiceCentreIdentity");
-    strcpy(tap03ge10_tagname_map[198], "ServingBid");
-    strcpy(tap03ge10_tagname_map[199], "SimChargeableSubscriber");
-    strcpy(tap03ge10_tagname_map[200], "SimToolkitIndicator");
-    strcpy(tap03ge10_tagname_map[201], "SpecificationVersionNumber");
-    strcpy(tap03ge10_tagname_map[202], "SpeechVersionRequested");
-    strcpy(tap03ge10_tagname_map[203], "SpeechVersionUsed");
-    strcpy(tap03ge10_tagname_map[204], "SsParameters");
-    strcpy(tap03ge10_tagname_map[206], "SupplServiceUsed");
-    strcpy(tap03ge10_tagname_map[207], "SupplServiceUsedList");
-    strcpy(tap03ge10_tagname_map[208], "SupplServiceActionCode");
-    strcpy(tap03ge10_tagname_map[209], "SupplServiceCode");
-    strcpy(tap03ge10_tagname_map[210], "TapCurrency");
-    strcpy(tap03ge10_tagname_map[211], "TaxationList");
-    strcpy(tap03ge10_tagname_map[212], "TaxCode");
-    strcpy(tap03ge10_tagname_map[213], "TaxInformation");
-    strcpy(tap03ge10_tagname_map[214], "TaxInformationList");
-    strcpy(tap03ge10_tagname_map[215], "TaxRate");
-    strcpy(tap03ge10_tagname_map[216], "Taxation");
-    strcpy(tap03ge10_tagname_map[217], "TaxType");
-    strcpy(tap03ge10_tagname_map[218], "TeleServiceCode");
-    strcpy(tap03ge10_tagname_map[219], "ThirdPartyInformation");
-    strcpy(tap03ge10_tagname_map[220], "TimeBand");
-    strcpy(tap03ge10_tagname_map[221], "TimeBandSubtype");
-    strcpy(tap03ge10_tagname_map[222], "TotalChargeValue");
-    strcpy(tap03ge10_tagname_map[223], "TotalCallEventDuration");
-    strcpy(tap03ge10_tagname_map[224], "TotalChargeValueList");
-    strcpy(tap03ge10_tagname_map[225], "TotalDiscountValue");
-    strcpy(tap03ge10_tagname_map[226], "TotalTaxValue");
-    strcpy(tap03ge10_tagname_map[227], "TransferCutOffTimeStamp");
-    strcpy(tap03ge10_tagname_map[228], "TransparencyIndicator");
-    strcpy(tap03ge10_tagname_map[229], "TypeOfControllingNode");
-    strcpy(tap03ge10_tagname_map[230], "TypeOfNumber");
-    strcpy(tap03ge10_tagname_map[231], "UtcTimeOffset");
-    strcpy(tap03ge10_tagname_map[232], "UtcTimeOffsetCode");
-    strcpy(tap03ge10_tagname_map[233], "UtcTimeOffsetInfo");
-    strcpy(tap03ge10_tagname_map[234], "UtcTimeOffsetInfoList");
-    strcpy(tap03ge10_tagname_map[235], "ValueAddedServiceUsedList");
-    strcpy(tap03ge10_tagname_map[236], "ValueAddedServiceUsed");
-    strcpy(tap03ge10_tagname_map[237], "VasCode");
-    strcpy(tap03ge10_tagname_map[238], "VasInformation");
-    strcpy(tap03ge10_tagname_map[239], "VasDescription");
-    strcpy(tap03ge10_tagname_map[240], "VasShortDescription");
-    strcpy(tap03ge10_tagname_map[241], "AbsoluteAmount");
-    strcpy(tap03ge10_tagname_map[242], "Bid");
-    strcpy(tap03ge10_tagname_map[243], "Code");
-    strcpy(tap03ge10_tagname_map[244], "TapDecimalPlaces");
-    strcpy(tap03ge10_tagname_map[245], "NetworkInitPDPContext");
-    strcpy(tap03ge10_tagname_map[246], "CalledNumAnalysis");
-    strcpy(tap03ge10_tagname_map[247], "CalledNumAnalysisCode");
-    strcpy(tap03ge10_tagname_map[249], "CalledNumAnalysisList");
-    strcpy(tap03ge10_tagname_map[250], "DataVolumeIncoming");
-    strcpy(tap03ge10_tagname_map[251], "DataVolumeOutgoing");
-    strcpy(tap03ge10_tagname_map[252], "NumberOfChannelsUsed");
-    strcpy(tap03ge10_tagname_map[253], "Mdn");
-    strcpy(tap03ge10_tagname_map[254], "MinChargeableSubscriber");
-    strcpy(tap03ge10_tagname_map[255], "CallTypeLevel2");
-    strcpy(tap03ge10_tagname_map[256], "CallTypeLevel3");
-    strcpy(tap03ge10_tagname_map[257], "CalledCountryCode");
-    strcpy(tap03ge10_tagname_map[258], "CallTypeGroup");
-    strcpy(tap03ge10_tagname_map[259], "CallTypeLevel1");
-    strcpy(tap03ge10_tagname_map[260], "PDPContextStartTimestamp");
-    strcpy(tap03ge10_tagname_map[261], "AccessPointNameNI");
-    strcpy(tap03ge10_tagname_map[262], "AccessPointNameOI");
-    strcpy(tap03ge10_tagname_map[263], "ChargingCharacteristics");
-    strcpy(tap03ge10_tagname_map[264], "QoSMaxBitRateUplink");
-    strcpy(tap03ge10_tagname_map[265], "QoSMaxSDUsize");
-    strcpy(tap03ge10_tagname_map[266], "QoSResidualBER");
-    strcpy(tap03ge10_tagname_map[267], "QoSSDUErrorRatio");
-    strcpy(tap03ge10_tagname_map[268], "QoSTrafficClass");
-    strcpy(tap03ge10_tagname_map[270], "UMTSQoSRequested");
-    strcpy(tap03ge10_tagname_map[271], "UMTSQoSUsed");
-    strcpy(tap03ge10_tagname_map[272], "GSMQoSRequested");
-    strcpy(tap03ge10_tagname_map[273], "GSMQoSUsed");
-    strcpy(tap03ge10_tagname_map[274], "QoSMaxBitRateDownlink");
-    strcpy(tap03ge10_tagname_map[275], "QoSAllocRetenPriority");
-    strcpy(tap03ge10_tagname_map[276], "QoSHandlingpriority");
-    strcpy(tap03ge10_tagname_map[277], "QoSErroneousSDUs");
-    strcpy(tap03ge10_tagname_map[278], "QoSDeliveryOrder");
-    strcpy(tap03ge10_tagname_map[279], "DialledDigits");
-    strcpy(tap03ge10_tagname_map[280], "UserProtocolIndicator");
-    strcpy(tap03ge10_tagname_map[281], "ObjectType");
-    strcpy(tap03ge10_tagname_map[283], "QoSGuaranteedBitRateDownlink");
-    strcpy(tap03ge10_tagname_map[284], "QoSGuaranteedBitRateUplink");
-    strcpy(tap03ge10_tagname_map[285], "ContentServiceUsedList");
-    strcpy(tap03ge10_tagname_map[286], "GsmChargeableSubscriber");
-    strcpy(tap03ge10_tagname_map[287], "ChargedPartyIdentifier");
-    strcpy(tap03ge10_tagname_map[288], "HomeIdentifier");
-    strcpy(tap03ge10_tagname_map[289], "LocationIdentifier");
-    strcpy(tap03ge10_tagname_map[290], "EquipmentId");
-    strcpy(tap03ge10_tagname_map[291], "ContentProviderIdType");
-    strcpy(tap03ge10_tagname_map[292], "ContentProviderIdentifier");
-    strcpy(tap03ge10_tagname_map[293], "IspIdType");
-    strcpy(tap03ge10_tagname_map[294], "IspIdentifier");
-    strcpy(tap03ge10_tagname_map[295], "NetworkIdentifier");
-    strcpy(tap03ge10_tagname_map[296], "GmlcAddress");
-    strcpy(tap03ge10_tagname_map[297], "LocationService");
-    strcpy(tap03ge10_tagname_map[298], "TrackingCustomerInformation");
-    strcpy(tap03ge10_tagname_map[299], "TrackingCustomerIdList");
-    strcpy(tap03ge10_tagname_map[300], "OrderPlacedTimeStamp");
-    strcpy(tap03ge10_tagname_map[301], "RequestedDeliveryTimeStamp");
-    strcpy(tap03ge10_tagname_map[302], "ActualDeliveryTimeStamp");
-    strcpy(tap03ge10_tagname_map[303], "TransactionStatus");
-    strcpy(tap03ge10_tagname_map[304], "ContentTransactionBasicInfo");
-    strcpy(tap03ge10_tagname_map[305], "ChargedPartyIdType");
-    strcpy(tap03ge10_tagname_map[306], "LoginName");
-    strcpy(tap03ge10_tagname_map[307], "AccountNumber");
-    strcpy(tap03ge10_tagname_map[308], "EmailAddress");
-    strcpy(tap03ge10_tagname_map[309], "ChargedPartyIdentification");
-    strcpy(tap03ge10_tagname_map[310], "ChargedPartyIdList");
-    strcpy(tap03ge10_tagname_map[311], "HomeIdType");
-    strcpy(tap03ge10_tagname_map[312], "Name");
-    strcpy(tap03ge10_tagname_map[313], "ChargedPartyHomeIdentification");
-    strcpy(tap03ge10_tagname_map[314], "ChargedPartyHomeIdList");
-    strcpy(tap03ge10_tagname_map[315], "LocationIdType");
-    strcpy(tap03ge10_tagname_map[316], "CountryName");
-    strcpy(tap03ge10_tagname_map[317], "CountryAsciCode");
-    strcpy(tap03ge10_tagname_map[318], "Region");
-    strcpy(tap03ge10_tagname_map[319], "Place");
-    strcpy(tap03ge10_tagname_map[320], "ChargedPartyLocation");
-    strcpy(tap03ge10_tagname_map[321], "ChargedPartyLocationList");
-    strcpy(tap03ge10_tagname_map[322], "EquipmentIdType");
-    strcpy(tap03ge10_tagname_map[323], "ChargedPartyEquipment");
-    strcpy(tap03ge10_tagname_map[324], "ChargedPartyInformation");
-    strcpy(tap03ge10_tagname_map[325], "ProviderIdType");
-    strcpy(tap03ge10_tagname_map[326], "Url");
-    strcpy(tap03ge10_tagname_map[327], "ContentProvider");
-    strcpy(tap03ge10_tagname_map[328], "ContentProviderIdList");
-    strcpy(tap03ge10_tagname_map[329], "InternetServiceProvider");
-    strcpy(tap03ge10_tagname_map[330], "InternetServiceProviderIdList");
-    strcpy(tap03ge10_tagname_map[331], "NetworkIdType");
-    strcpy(tap03ge10_tagname_map[332], "Network");
-    strcpy(tap03ge10_tagname_map[333], "NetworkList");
-    strcpy(tap03ge10_tagname_map[334], "ContentProviderName");
-    strcpy(tap03ge10_tagname_map[335], "ServingPartiesInformation");
-    strcpy(tap03ge10_tagname_map[336], "ContentTransactionCode");
-    strcpy(tap03ge10_tagname_map[337], "ContentTransactionType");
-    strcpy(tap03ge10_tagname_map[338], "TransactionDescriptionSupp");
-    strcpy(tap03ge10_tagname_map[339], "TransactionDetailDescription");
-    strcpy(tap03ge10_tagname_map[340], "TransactionShortDescription");
-    strcpy(tap03ge10_tagname_map[341], "TransactionIdentifier");
-    strcpy(tap03ge10_tagname_map[342], "TransactionAuthCode");
-    strcpy(tap03ge10_tagname_map[343], "TotalDataVolume");
-    strcpy(tap03ge10_tagname_map[344], "ChargeRefundIndicator");
-    strcpy(tap03ge10_tagname_map[345], "ContentChargingPoint");
-    strcpy(tap03ge10_tagname_map[346], "PaidIndicator");
-    strcpy(tap03ge10_tagname_map[347], "PaymentMethod");
-    strcpy(tap03ge10_tagname_map[348], "AdvisedChargeCurrency");
-    strcpy(tap03ge10_tagname_map[349], "AdvisedCharge");
-    strcpy(tap03ge10_tagname_map[350], "Commission");
-    strcpy(tap03ge10_tagname_map[351], "AdvisedChargeInformation");
-    strcpy(tap03ge10_tagname_map[352], "ContentServiceUsed");
-    strcpy(tap03ge10_tagname_map[353], "TotalTaxRefund");
-    strcpy(tap03ge10_tagname_map[354], "TotalDiscountRefund");
-    strcpy(tap03ge10_tagname_map[355], "TotalChargeRefund");
-    strcpy(tap03ge10_tagname_map[356], "TotalAdvisedCharge");
-    strcpy(tap03ge10_tagname_map[357], "TotalAdvisedChargeRefund");
-    strcpy(tap03ge10_tagname_map[358], "TotalCommission");
-    strcpy(tap03ge10_tagname_map[359], "TotalCommissionRefund");
-    strcpy(tap03ge10_tagname_map[360], "TotalAdvisedChargeValue");
-    strcpy(tap03ge10_tagname_map[361], "TotalAdvisedChargeValueList");
-    strcpy(tap03ge10_tagname_map[362], "TrackingCustomerIdentification");
-    strcpy(tap03ge10_tagname_map[363], "CustomerIdType");
-    strcpy(tap03ge10_tagname_map[364], "CustomerIdentifier");
-    strcpy(tap03ge10_tagname_map[365], "TrackingCustomerHomeIdList");
-    strcpy(tap03ge10_tagname_map[366], "TrackingCustomerHomeId");
-    strcpy(tap03ge10_tagname_map[367], "TrackedCustomerInformation");
-    strcpy(tap03ge10_tagname_map[368], "TrackingCustomerLocList");
-    strcpy(tap03ge10_tagname_map[369], "TrackingCustomerLocation");
-    strcpy(tap03ge10_tagname_map[370], "TrackedCustomerIdList");
-    strcpy(tap03ge10_tagname_map[371], "TrackingCustomerEquipment");
-    strcpy(tap03ge10_tagname_map[372], "TrackedCustomerIdentification");
-    strcpy(tap03ge10_tagname_map[373], "LCSSPInformation");
-    strcpy(tap03ge10_tagname_map[374], "LCSSPIdentificationList");
-    strcpy(tap03ge10_tagname_map[375], "LCSSPIdentification");
-    strcpy(tap03ge10_tagname_map[376], "TrackedCustomerHomeIdList");
-    strcpy(tap03ge10_tagname_map[377], "TrackedCustomerHomeId");
-    strcpy(tap03ge10_tagname_map[378], "ISPList");
-    strcpy(tap03ge10_tagname_map[379], "TrackedCustomerLocList");
-    strcpy(tap03ge10_tagname_map[380], "TrackedCustomerLocation");
-    strcpy(tap03ge10_tagname_map[381], "TrackedCustomerEquipment");
-    strcpy(tap03ge10_tagname_map[382], "LocationServiceUsage");
-    strcpy(tap03ge10_tagname_map[383], "LCSQosRequested");
-    strcpy(tap03ge10_tagname_map[384], "LCSRequestTimestamp");
-    strcpy(tap03ge10_tagname_map[385], "HorizontalAccuracyRequested");
-    strcpy(tap03ge10_tagname_map[386], "VerticalAccuracyRequested");
-    strcpy(tap03ge10_tagname_map[387], "ResponseTimeCategory");
-    strcpy(tap03ge10_tagname_map[388], "TrackingPeriod");
-    strcpy(tap03ge10_tagname_map[389], "TrackingFrequency");
-    strcpy(tap03ge10_tagname_map[390], "LCSQosDelivered");
-    strcpy(tap03ge10_tagname_map[391], "LCSTransactionStatus");
-    strcpy(tap03ge10_tagname_map[392], "HorizontalAccuracyDelivered");
-    strcpy(tap03ge10_tagname_map[393], "VerticalAccuracyDelivered");
-    strcpy(tap03ge10_tagname_map[394], "ResponseTime");
-    strcpy(tap03ge10_tagname_map[395], "PositioningMethod");
-    strcpy(tap03ge10_tagname_map[396], "AgeOfLocation");
-    strcpy(tap03ge10_tagname_map[397], "TaxValue");
-    strcpy(tap03ge10_tagname_map[398], "TaxableAmount");
-    strcpy(tap03ge10_tagname_map[399], "CamelServerAddress");
-    strcpy(tap03ge10_tagname_map[400], "RecEntityId");
-    strcpy(tap03ge10_tagname_map[402], "NonChargedNumber");
-    strcpy(tap03ge10_tagname_map[403], "ThirdPartyNumber");
-    strcpy(tap03ge10_tagname_map[404], "CamelDestinationNumber");
-    strcpy(tap03ge10_tagname_map[405], "CallingNumber");
-    strcpy(tap03ge10_tagname_map[407], "CalledNumber");
-    strcpy(tap03ge10_tagname_map[410], "ChargeDetailTimeStamp");
-    strcpy(tap03ge10_tagname_map[411], "FixedDiscountValue");
-    strcpy(tap03ge10_tagname_map[412], "Discount");
-    strcpy(tap03ge10_tagname_map[413], "HomeLocationDescription");
-    strcpy(tap03ge10_tagname_map[414], "ServingLocationDescription");
-    strcpy(tap03ge10_tagname_map[415], "TotalCharge");
-    strcpy(tap03ge10_tagname_map[416], "TotalTransactionDuration");
-    strcpy(tap03ge10_tagname_map[417], "NetworkAccessIdentifier");
-    strcpy(tap03ge10_tagname_map[418], "IMSSignallingContext");
-    strcpy(tap03ge10_tagname_map[419], "SMSDestinationNumber");
-    strcpy(tap03ge10_tagname_map[420], "GuaranteedBitRate");
-    strcpy(tap03ge10_tagname_map[421], "MaximumBitRate");
-    strcpy(tap03ge10_tagname_map[422], "CamelInvocationFee");
-    strcpy(tap03ge10_tagname_map[423], "DiscountableAmount");
-    strcpy(tap03ge10_tagname_map[424], "HSCSDIndicator");
-    strcpy(tap03ge10_tagname_map[425], "SMSOriginator");
-    strcpy(tap03ge10_tagname_map[426], "BasicServiceCode");
-    strcpy(tap03ge10_tagname_map[427], "ChargeableSubscriber");
-    strcpy(tap03ge10_tagname_map[428], "DiscountApplied");
-    strcpy(tap03ge10_tagname_map[429], "ImeiOrEsn");
-    strcpy(tap03ge10_tagname_map[430], "ScuChargeableSubscriber");
-    strcpy(tap03ge10_tagname_map[431], "ThreeGcamelDestination");
-    strcpy(tap03ge10_tagname_map[432], "TaxIndicator");
-    strcpy(tap03ge10_tagname_map[433], "MessagingEvent");
-    strcpy(tap03ge10_tagname_map[434], "MobileSession");
-    strcpy(tap03ge10_tagname_map[435], "EventReference");
-    strcpy(tap03ge10_tagname_map[436], "ChargedParty");
-    strcpy(tap03ge10_tagname_map[437], "ElementId");
-    strcpy(tap03ge10_tagname_map[438], "ElementType");
-    strcpy(tap03ge10_tagname_map[439], "MessagingEventService");
-    strcpy(tap03ge10_tagname_map[440], "MobileSessionService");
-    strcpy(tap03ge10_tagname_map[441], "NetworkElement");
-    strcpy(tap03ge10_tagname_map[442], "NetworkElementList");
-    strcpy(tap03ge10_tagname_map[443], "NonChargedParty");
-    strcpy(tap03ge10_tagname_map[444], "NonChargedPartyNumber");
-    strcpy(tap03ge10_tagname_map[445], "NonChargedPublicUserId");
-    strcpy(tap03ge10_tagname_map[446], "PublicUserId");
-    strcpy(tap03ge10_tagname_map[447], "ServiceStartTimestamp");
-    strcpy(tap03ge10_tagname_map[448], "SessionChargeInfoList");
-    strcpy(tap03ge10_tagname_map[449], "SessionChargeInformation");
-    strcpy(tap03ge10_tagname_map[450], "RequestedDestination");
-    strcpy(tap03ge10_tagname_map[451], "RequestedNumber");
-    strcpy(tap03ge10_tagname_map[452], "RequestedPublicUserId");
+#define TAGNAME_POOL rap01XX_pool
+static const struct rap01XX_pool { char t0; RAP01XX_TAGS(TAGNAME_MEMBER) } rap01XX_pool = { '\0', RAP01XX_TAGS(TAGNAME_STRING) };
+static const unsigned int rap01XX_idx[MAXTAGS] = { RAP01XX_TAGS(TAGNAME_OFFSET) };
+#undef TAGNAME_POOL
 
-}
+const tagmap_t rap01XX_tagname_map = { rap01XX_idx, (const char *)&rap01XX_pool, MAXTAGS, NULL };
 
+#define TAGNAME_POOL tap03le09_pool
+static const struct tap03le09_pool { char t0; TAP03LE09_TAGS(TAGNAME_MEMBER) } tap03le09_pool = { '\0', TAP03LE09_TAGS(TAGNAME_STRING) };
+static const unsigned int tap03le09_idx[MAXTAGS] = { TAP03LE09_TAGS(TAGNAME_OFFSET) };
+#undef TAGNAME_POOL
 
-int merge_tap_rapids(char tap_tagname_map[MAXTAGS][MAXLEN], char rap_tagname_map[MAXTAGS][MAXLEN])
-{
-    int i = 0;
+const tagmap_t tap03le09_tagname_map = { tap03le09_idx, (const char *)&tap03le09_pool, MAXTAGS, NULL };
 
-    if (tap_tagname_map == NULL || rap_tagname_map == NULL)
-    {
-        fprintf(stderr, "Error passing arguments\n");
-        return -1;
-    }
+#define TAGNAME_POOL tap03ge10_pool
+static const struct tap03ge10_pool { char t0; TAP03GE10_TAGS(TAGNAME_MEMBER) } tap03ge10_pool = { '\0', TAP03GE10_TAGS(TAGNAME_STRING) };
+static const unsigned int tap03ge10_idx[MAXTAGS] = { TAP03GE10_TAGS(TAGNAME_OFFSET) };
+#undef TAGNAME_POOL
 
-    for (i = 0; i < MAXTAGS; i++)
-    {
-        if (strlen(rap_tagname_map[i]) > 0)
-        {
-            strcpy(tap_tagname_map[i], rap_tagname_map[i]);
-        }
-    }
+const tagmap_t tap03ge10_tagname_map = { tap03ge10_idx, (const char *)&tap03ge10_pool, MAXTAGS, NULL };
 
-    return 0;
-}
+/* EOF */
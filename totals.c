@@ -0,0 +1,865 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: totals.c
+|*
+|* Description: Totals of the records of a TAP, NRT or RAP file instead of
+|*              its dump (--totals): records, durations, data volumes and
+|*              charges by service, and charges and chargeable units by
+|*              service and ChargeType. They are checked against the
+|*              AuditControlInfo (or the count of NRT and RAP) of the
+|*              file, in the same pass.
+|*
+|*              The service of a record is its first TeleServiceCode or
+|*              BearerServiceCode (the type of record if none), and the
+|*              one of a ChargeDetail the last code before it. The groups
+|*              are kept in a hash table of open addressing, as the tags
+|*              of --stats, and sorted by key when printed. The kind of
+|*              each tag is found once from its name in the tag map.
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Defines */
+
+#define TOTALS_MAX_DECIMALS 18  /* Decimals of an amount of 8 bytes at most */
+#define NRT_DECIMALS        3   /* NRT amounts: SDR with 3 decimals */
+
+#define KEY_TELE    ((unsigned long long)'T' << 56) /* Kind of service of a key */
+#define KEY_BEARER  ((unsigned long long)'B' << 56)
+#define KEY_RECORD  ((unsigned long long)'R' << 56)
+
+
+/* 3. Prototypes */
+
+static int      totals_start_cons(void *user, const asn1event *ev);
+static int      totals_primitive(void *user, const asn1event *ev);
+static int      totals_end_cons (void *user, const asn1event *ev);
+static int      totals_kind     (const asn1totals *tt, const asn1event *ev);
+static int      totals_add      (asn1totals *tt, unsigned long long key, long events, long long duration,
+                                 long long volume, long long charge, long long units);
+static int      totals_grow     (asn1totals *tt);
+static long long totals_int     (const uchar *value, long len);
+static unsigned long long totals_text(const uchar *value, long len, int bytes);
+static void     totals_amount   (asn1output *out, long long v, int decimals, int width);
+static const char *totals_code  (char *dst, unsigned long long code, int bytes);
+static void     totals_service  (asn1output *out, unsigned long long key, const asn1ctx *ctx);
+static int      cmp_groups      (const void *a, const void *b);
+
+
+/* 4. Global Variables */
+
+const asn1handler totals_handler =              /* Callbacks adding up the records */
+{
+    totals_start_cons,
+    totals_primitive,
+    totals_end_cons,
+    NULL,
+    NULL
+};
+
+static const struct
+{
+    const char* name;
+    int         kind;
+} totals_names[] =                              /* Tags of TAP, NRT and RAP added up, by name */
+{
+    { "Sender",                     TOT_SENDER },
+    { "Recipient",                  TOT_RECIPIENT },
+    { "TapDecimalPlaces",           TOT_DECIMALS },
+    { "TeleServiceCode",            TOT_TELE },
+    { "BearerServiceCode",          TOT_BEARER },
+    { "ChargeDetail",               TOT_DETAIL },
+    { "ChargeType",                 TOT_CHARGE_TYPE },
+    { "Charge",                     TOT_CHARGE },
+    { "ChargeableUnits",            TOT_UNITS },
+    { "ChargeAmount",               TOT_AMOUNT },
+    { "TotalCallEventDuration",     TOT_DURATION },
+    { "CallEventDuration",          TOT_DURATION },
+    { "DataVolumeIncoming",         TOT_VOLUME },
+    { "DataVolumeOutgoing",         TOT_VOLUME },
+    { "TaxValue",                   TOT_TAX },
+    { "Discount",                   TOT_DISCOUNT },
+    { "DiscountValue",              TOT_DISCOUNT },
+    { "CallEventDetailsCount",      TOT_AUDIT + AUDIT_COUNT },
+    { "CallEventsCount",            TOT_AUDIT + AUDIT_COUNT },
+    { "ReturnDetailsCount",         TOT_AUDIT + AUDIT_COUNT },
+    { "TotalCharge",                TOT_AUDIT + AUDIT_CHARGE },
+    { "TotalTaxValue",              TOT_AUDIT + AUDIT_TAX },
+    { "TotalDiscountValue",         TOT_AUDIT + AUDIT_DISCOUNT },
+    { NULL,                         TOT_NONE }
+};
+
+static const char* audit_names[AUDIT_MAX] =     /* Computed values, if the file does not declare them */
+{
+    "Records", "TotalCharge", "TotalTaxValue", "TotalDiscountValue"
+};
+
+
+/****************************************************************************
+|*
+|* Function: totals_init
+|*
+|* Description;
+|*
+|*     Empty totals for the decoding of ctx, with the kind of each tag of
+|*     its tag map. Call it before the tag map is left out for -n.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int totals_init(asn1totals *tt, const asn1ctx *ctx)
+{
+    const tagmap_t* map = NULL;
+    const char*     name = NULL;
+    int             tag = 0;
+    int             i = 0;
+
+    memset(tt, 0x00, sizeof(*tt));
+    tt->decimals = (ctx->file_type == FT_NRT ? NRT_DECIMALS : -1);
+    tt->rec_depth = -1;
+    tt->agroups = TOTALS_MIN_GROUPS;
+
+    /* 1. Tags of all the maps chained */
+
+    for (map = ctx->tagmap; map != NULL; map = map->next)
+    {
+        if (map->ntags > tt->ntags)
+            tt->ntags = map->ntags;
+    }
+
+    if ( ( tt->groups = (totgroup *)calloc((size_t)tt->agroups, sizeof(totgroup)) ) == NULL ||
+            (tt->ntags > 0 && ( tt->tags = (typedtag *)calloc((size_t)tt->ntags, sizeof(typedtag)) ) == NULL) )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the totals\n");
+        totals_close(tt);
+        return -1;
+    }
+
+
+    /* 2. Kind of each name */
+
+    for (tag = 0; tag < tt->ntags; tag++)
+    {
+        if ( ( name = tagmap_name(ctx->tagmap, tag) ) == NULL )
+            continue;
+
+        for (i = 0; totals_names[i].name != NULL; i++)
+        {
+            if (strcmp(name, totals_names[i].name) == 0)
+            {
+                tt->tags[tag].name = name;
+                tt->tags[tag].kind = totals_names[i].kind;
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_start_cons
+|*
+|* Description;
+|*
+|*     Starts a record, with the type of record as its service until a
+|*     code is found, or a ChargeDetail
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int totals_start_cons(void *user, const asn1event *ev)
+{
+    asn1totals*     tt = (asn1totals *)user;
+
+    if (ev->is_record)
+    {
+        tt->rec_depth = ev->depth;
+        tt->rec_service = 0;
+        tt->service = KEY_RECORD | (unsigned long long)(unsigned int)ev->item->tag << 24;
+        tt->duration = 0;
+        tt->volume = 0;
+        tt->amount = 0;
+    }
+    else if (tt->rec_depth >= 0 && totals_kind(tt, ev) == TOT_DETAIL)
+    {
+        tt->charge_type = 0;
+        tt->charge = 0;
+        tt->units = 0;
+    }
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_primitive
+|*
+|* Description;
+|*
+|*     Keeps the value of a primitive for its record or ChargeDetail, or
+|*     for the file if out of the records
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int totals_primitive(void *user, const asn1event *ev)
+{
+    asn1totals*     tt = (asn1totals *)user;
+    const uchar*    value = ev->value;
+    long            len = ev->item->size;
+    int             kind = 0;
+
+    if (ev->is_eoe)
+        return ASN1_CONTINUE;
+
+    /* 1. A record without elements */
+
+    if (ev->is_record)
+    {
+        tt->records++;
+        return (totals_add(tt, KEY_RECORD | (unsigned long long)(unsigned int)ev->item->tag << 24, 1, 0, 0, 0, 0) == 0
+                ? ASN1_CONTINUE : ASN1_STOP);
+    }
+
+    if ( ( kind = totals_kind(tt, ev) ) == TOT_NONE )
+        return ASN1_CONTINUE;
+
+    /* 2. Elements of the file */
+
+    if (tt->rec_depth < 0)
+    {
+        switch (kind)
+        {
+            case TOT_SENDER:
+                snprintf(tt->sender, sizeof(tt->sender), "%.*s", (int)len, (const char *)value);
+                break;
+            case TOT_RECIPIENT:
+                snprintf(tt->recipient, sizeof(tt->recipient), "%.*s", (int)len, (const char *)value);
+                break;
+            case TOT_DECIMALS:
+                if (len == 1 && value[0] <= TOTALS_MAX_DECIMALS)
+                    tt->decimals = value[0];
+                break;
+            default:
+                if (kind >= TOT_AUDIT && kind < TOT_AUDIT + AUDIT_MAX)
+                {
+                    tt->declared[kind - TOT_AUDIT] = totals_int(value, len);
+                    tt->audit_names[kind - TOT_AUDIT] = tt->tags[ev->item->tag].name;
+                }
+                break;
+        }
+
+        return ASN1_CONTINUE;
+    }
+
+
+    /* 3. Elements of a record */
+
+    switch (kind)
+    {
+        case TOT_TELE:
+        case TOT_BEARER:
+            tt->service = (kind == TOT_TELE ? KEY_TELE : KEY_BEARER) | totals_text(value, len, 4) << 24;
+            if (tt->rec_service == 0)
+                tt->rec_service = tt->service;
+            break;
+        case TOT_CHARGE_TYPE:  tt->charge_type = totals_text(value, len, 3); break;
+        case TOT_CHARGE:       tt->charge = totals_int(value, len); break;
+        case TOT_UNITS:        tt->units = totals_int(value, len); break;
+        case TOT_AMOUNT:       tt->amount += totals_int(value, len); break;
+        case TOT_DURATION:     tt->duration += totals_int(value, len); break;
+        case TOT_VOLUME:       tt->volume += totals_int(value, len); break;
+        case TOT_TAX:          tt->computed[AUDIT_TAX] += totals_int(value, len); break;
+        case TOT_DISCOUNT:     tt->computed[AUDIT_DISCOUNT] += totals_int(value, len); break;
+        default:               break;
+    }
+
+    return ASN1_CONTINUE;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_end_cons
+|*
+|* Description;
+|*
+|*     Adds a ChargeDetail to its service and ChargeType, and a record to
+|*     its service. Charges of ChargeType 00 (total charge) and the NRT
+|*     ChargeAmount are the charge of the service and of the file.
+|*
+|* Return:
+|*      ASN1_CONTINUE
+|*      ASN1_STOP: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int totals_end_cons(void *user, const asn1event *ev)
+{
+    asn1totals*     tt = (asn1totals *)user;
+    unsigned long long service = 0;
+    int             rc = 0;
+
+    /* 1. Record */
+
+    if (ev->is_record)
+    {
+        service = (tt->rec_service != 0 ? tt->rec_service : tt->service);
+
+        tt->rec_depth = -1;
+        tt->records++;
+        tt->computed[AUDIT_CHARGE] += tt->amount;
+
+        rc = totals_add(tt, service, 1, tt->duration, tt->volume, tt->amount, 0);
+
+        return (rc == 0 ? ASN1_CONTINUE : ASN1_STOP);
+    }
+
+    /* 2. ChargeDetail. Charge types are not empty in the key: no clash with the service */
+
+    if (tt->rec_depth < 0 || totals_kind(tt, ev) != TOT_DETAIL)
+        return ASN1_CONTINUE;
+
+    if (tt->charge_type == 0)
+        tt->charge_type = (unsigned long long)'-' << 16;
+
+    rc = totals_add(tt, tt->service | tt->charge_type, 1, 0, 0, tt->charge, tt->units);
+
+    if (rc == 0 && tt->charge_type == (unsigned long long)('0' << 16 | '0' << 8))
+    {
+        tt->computed[AUDIT_CHARGE] += tt->charge;
+        rc = totals_add(tt, tt->service, 0, 0, 0, tt->charge, 0);
+    }
+
+    return (rc == 0 ? ASN1_CONTINUE : ASN1_STOP);
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_kind
+|*
+|* Description;
+|*
+|*     Kind of the element of ev. Elements of the universal class, or
+|*     named otherwise than by the tag map (schema), have none.
+|*
+|* Return:
+|*      TOT_*
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int totals_kind(const asn1totals *tt, const asn1event *ev)
+{
+    const asn1item* item = ev->item;
+    const typedtag* t = NULL;
+
+    if (item->class == 0 || item->tag >= tt->ntags)
+        return TOT_NONE;
+
+    t = &tt->tags[item->tag];
+
+    return (ev->name != NULL && ev->name != t->name ? TOT_NONE : t->kind);
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_add
+|*
+|* Description;
+|*
+|*     Adds the values to the group of key
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int totals_add(asn1totals *tt, unsigned long long key, long events, long long duration,
+                      long long volume, long long charge, long long units)
+{
+    totgroup*       g = NULL;
+    int             i = 0;
+
+    /* 1. Entry of the key, or a free one for it */
+
+    if (tt->ngroups * 2 >= tt->agroups && totals_grow(tt) != 0)
+        return -1;
+
+    for (i = (int)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (tt->agroups - 1);
+            tt->groups[i].key != 0 && tt->groups[i].key != key;
+            i = (i + 1) & (tt->agroups - 1))
+        ;
+
+    g = &tt->groups[i];
+
+    if (g->key == 0)
+    {
+        g->key = key;
+        tt->ngroups++;
+    }
+
+
+    /* 2. Values */
+
+    g->events += events;
+    g->duration += duration;
+    g->volume += volume;
+    g->charge += charge;
+    g->units += units;
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_grow
+|*
+|* Description;
+|*
+|*     Doubles the hash table of the groups
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int totals_grow(asn1totals *tt)
+{
+    totgroup*       old = tt->groups;
+    totgroup*       groups = NULL;
+    int             agroups = tt->agroups * 2;
+    int             i = 0;
+    int             j = 0;
+
+    if ( ( groups = (totgroup *)calloc((size_t)agroups, sizeof(totgroup)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the totals\n");
+        return -1;
+    }
+
+    for (i = 0; i < tt->agroups; i++)
+    {
+        if (old[i].key == 0)
+            continue;
+
+        for (j = (int)((old[i].key * 0x9E3779B97F4A7C15ULL) >> 32) & (agroups - 1);
+                groups[j].key != 0;
+                j = (j + 1) & (agroups - 1))
+            ;
+
+        groups[j] = old[i];
+    }
+
+    tt->groups = groups;
+    tt->agroups = agroups;
+    free(old);
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_int
+|*
+|* Description;
+|*
+|*     Signed integer of value (two's complement, big endian)
+|*
+|* Return:
+|*      Integer
+|*      0: Empty or longer than 8 bytes
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long long totals_int(const uchar *value, long len)
+{
+    long long       v = 0;
+    long            i = 0;
+
+    if (len < 1 || (size_t)len > sizeof(v))
+        return 0;
+
+    for (v = (signed char)value[0], i = 1; i < len; i++)
+        v = (long long)((unsigned long long)v << 8 | value[i]);
+
+    return v;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_text
+|*
+|* Description;
+|*
+|*     First bytes (up to bytes) of a code, as a number in the order of
+|*     the text. Codes of TAP and NRT are 2 or 3 characters.
+|*
+|* Return:
+|*      Code
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static unsigned long long totals_text(const uchar *value, long len, int bytes)
+{
+    unsigned long long code = 0;
+    int             i = 0;
+
+    for (i = 0; i < bytes; i++)
+        code = code << 8 | (i < len ? value[i] : 0);
+
+    return code;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_print
+|*
+|* Description;
+|*
+|*     Prints the totals: by service and ChargeType, and then the audit:
+|*     each value computed against the one declared in the file
+|*
+|* Return:
+|*      Number of values which differ from the ones declared
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int totals_print(asn1totals *tt, asn1output *out, const asn1ctx *ctx)
+{
+    totgroup*       groups = NULL;
+    const totgroup* g = NULL;
+    char            code[8];
+    int             differ = 0;
+    int             n = 0;
+    int             i = 0;
+
+    /* 1. File */
+
+    tt->computed[AUDIT_COUNT] = tt->records;
+
+    output_printf(out, "Sender: %s\n", (tt->sender[0] != '\0' ? tt->sender : "-"));
+    output_printf(out, "Recipient: %s\n", (tt->recipient[0] != '\0' ? tt->recipient : "-"));
+    output_printf(out, "Records: %ld\n", tt->records);
+
+    if (tt->decimals >= 0)
+        output_printf(out, "Decimal places: %d\n", tt->decimals);
+
+
+    /* 2. Groups, sorted: each service before its charge types */
+
+    if ( ( groups = (totgroup *)malloc((size_t)(tt->ngroups > 0 ? tt->ngroups : 1) * sizeof(totgroup)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the totals\n");
+        return 0;
+    }
+
+    for (i = 0; i < tt->agroups; i++)
+    {
+        if (tt->groups[i].key != 0)
+            groups[n++] = tt->groups[i];
+    }
+
+    qsort(groups, (size_t)n, sizeof(totgroup), cmp_groups);
+
+    output_printf(out, "\n%-24s %-4s %10s %14s %14s %20s %14s\n", "Service", "Type", "Count", "Duration", "Volume", "Charge", "Units");
+
+    for (i = 0; i < n; i++)
+    {
+        g = &groups[i];
+
+        totals_service(out, g->key, ctx);
+
+        if ((g->key & 0xffffff) == 0)
+        {
+            output_printf(out, " %-4s %10ld %14lld %14lld ", "", g->events, g->duration, g->volume);
+            totals_amount(out, g->charge, tt->decimals, 20);
+        }
+        else
+        {
+            output_printf(out, " %-4s %10ld %14s %14s ", totals_code(code, g->key, 3), g->events, "", "");
+            totals_amount(out, g->charge, tt->decimals, 20);
+            output_printf(out, " %14lld", g->units);
+        }
+
+        output_eol(out);
+    }
+
+    free(groups);
+
+
+    /* 3. Audit */
+
+    output_printf(out, "\n%-24s %20s %20s\n", "Audit", "Computed", "Declared");
+
+    for (i = 0; i < AUDIT_MAX; i++)
+    {
+        output_printf(out, "%-24s ", (tt->audit_names[i] != NULL ? tt->audit_names[i] : audit_names[i]));
+
+        if (i == AUDIT_COUNT)
+            output_printf(out, "%20lld", tt->computed[i]);
+        else
+            totals_amount(out, tt->computed[i], tt->decimals, 20);
+
+        if (tt->audit_names[i] == NULL)
+        {
+            output_printf(out, " %20s", "-");
+        }
+        else
+        {
+            output_putc(out, ' ');
+
+            if (i == AUDIT_COUNT)
+                output_printf(out, "%20lld", tt->declared[i]);
+            else
+                totals_amount(out, tt->declared[i], tt->decimals, 20);
+
+            output_puts(out, (tt->declared[i] == tt->computed[i] ? "  OK" : "  DIFFERS"));
+            differ += (tt->declared[i] != tt->computed[i]);
+        }
+
+        output_eol(out);
+    }
+
+    return differ;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_amount
+|*
+|* Description;
+|*
+|*     Prints the amount v with decimals decimals (-1: unknown, printed as
+|*     it is), right aligned in width characters
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void totals_amount(asn1output *out, long long v, int decimals, int width)
+{
+    unsigned long long u = (v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v);
+    char            str[48];
+    int             n = sizeof(str) - 1;
+    int             i = 0;
+
+    /* Digits backwards, at least one before the point */
+
+    str[n] = '\0';
+
+    do
+    {
+        if (i == decimals && i > 0)
+            str[--n] = '.';
+        str[--n] = (char)('0' + u % 10);
+        u /= 10;
+    }
+    while (++i <= decimals || u != 0);
+
+    if (v < 0)
+        str[--n] = '-';
+
+    output_printf(out, "%*s", width, str + n);
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_code
+|*
+|* Description;
+|*
+|*     Writes the bytes characters of code (see totals_text()) into dst,
+|*     at least bytes + 1 bytes. Missing or unprintable characters are
+|*     left out.
+|*
+|* Return:
+|*      dst
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static const char *totals_code(char *dst, unsigned long long code, int bytes)
+{
+    int             c = 0;
+    int             n = 0;
+    int             i = 0;
+
+    for (i = bytes - 1; i >= 0; i--)
+    {
+        c = (int)(code >> (8 * i) & 0xff);
+        if (c >= 0x20 && c < 0x7f)
+            dst[n++] = (char)c;
+    }
+
+    dst[n] = '\0';
+
+    return dst;
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_service
+|*
+|* Description;
+|*
+|*     Prints the service of key: teleservice or bearer service and its
+|*     code, or the name (or tag) of the type of record
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static void totals_service(asn1output *out, unsigned long long key, const asn1ctx *ctx)
+{
+    char            code[8];
+    const char*     name = NULL;
+    int             tag = (int)(key >> 24 & 0xffffffff);
+
+    switch (key & ~0ULL << 56)
+    {
+        case KEY_TELE:
+            output_printf(out, "Tele %-19s", totals_code(code, (unsigned long long)tag, 4));
+            break;
+        case KEY_BEARER:
+            output_printf(out, "Bearer %-17s", totals_code(code, (unsigned long long)tag, 4));
+            break;
+        default:
+            if ( ( name = asn1_tagname(ctx, tag) ) != NULL )
+                output_printf(out, "%-24s", name);
+            else
+                output_printf(out, "%-24d", tag);
+            break;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: cmp_groups
+|*
+|* Description;
+|*
+|*     Order of the groups for qsort(): by key
+|*
+|* Return:
+|*      <0, 0, >0
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static int cmp_groups(const void *a, const void *b)
+{
+    const totgroup* ga = (const totgroup *)a;
+    const totgroup* gb = (const totgroup *)b;
+
+    return (ga->key > gb->key) - (ga->key < gb->key);
+}
+
+
+/****************************************************************************
+|*
+|* Function: totals_close
+|*
+|* Description;
+|*
+|*     Releases the totals
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void totals_close(asn1totals *tt)
+{
+    free(tt->tags);
+    free(tt->groups);
+
+    tt->tags = NULL;
+    tt->groups = NULL;
+}
+
+/* EOF */
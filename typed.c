@@ -0,0 +1,560 @@
+/****************************************************************************
+|*
+|* tap3edit Tools (http://www.tap3edit.com)
+|*
+|* Copyright (c) 2005-2018, Javier Gutierrez <https://github.com/tap3edit/readasn>
+|*
+|* Permission to use, copy, modify, and/or distribute this software for any
+|* purpose with or without fee is hereby granted, provided that the above
+|* copyright notice and this permission notice appear in all copies.
+|*
+|* THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+|* WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+|* MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+|* ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+|* WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+|* ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+|* OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+|*
+|*
+|* Module: typed.c
+|*
+|* Description: Typed values of the primitives of TAP and NRT files: IMSI
+|*              and MSISDN as TBCD digits, numbers as BCD digits, time
+|*              stamps with their UTC offset and amounts scaled by
+|*              TapDecimalPlaces. The type of each tag is found once from
+|*              its name in the tag map of the file, so a primitive costs
+|*              an index into an array before its conversion.
+|*
+|*              The UTC offset is the element right after the time stamp:
+|*              UtcTimeOffset (DateTimeLong, NRT), or UtcTimeOffsetCode
+|*              (DateTime), looked up in the UtcTimeOffsetInfo read before.
+|*              TapDecimalPlaces and UtcTimeOffsetInfo come before the
+|*              call events, so they are known when the amounts and the
+|*              codes are found. NRT amounts are in SDR with 3 decimals.
+|*
+|*              The values are written as the primitives are found, so
+|*              the time stamp has no offset: the typed value of the
+|*              offset after it is the full time stamp with the offset
+|*              (2026-04-19T12:19:00+01:00).
+|*
+|* Modifications:
+|*
+|* When         Who     Pos     What
+|* 20261016                     Initial Version
+|* 20261016                     Full time stamp on the offset documented
+|*
+****************************************************************************/
+
+/* 1. Includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "readasn.h"
+
+
+/* 2. Defines */
+
+#define TYPED_MAX_DECIMALS 18   /* Decimals of an amount of 8 bytes at most */
+#define NRT_DECIMALS       3    /* NRT amounts: SDR with 3 decimals */
+
+
+/* 3. Prototypes */
+
+static long     typed_stamp     (char *dst, const uchar *src, long len);
+static long     typed_offset    (char *dst, const uchar *src, long len);
+static long     typed_amount    (char *dst, const uchar *src, long len, int decimals);
+static long     typed_stamped   (const asn1typed *ty, const asn1event *ev, char *dst, long len);
+
+
+/* 4. Global Variables */
+
+static const struct
+{
+    const char* name;
+    int         kind;
+} typed_names[] =                               /* Typed tags of TAP and NRT, by name */
+{
+    { "Imsi",                       TYPED_TBCD },
+    { "Msisdn",                     TYPED_TBCD },
+    { "Imei",                       TYPED_BCD },
+    { "CallingNumber",              TYPED_BCD },
+    { "CalledNumber",               TYPED_BCD },
+    { "ConnectedNumber",            TYPED_BCD },
+    { "ThirdPartyNumber",           TYPED_BCD },
+    { "CamelDestinationNumber",     TYPED_BCD },
+    { "LocalTimeStamp",             TYPED_STAMP },
+    { "CallEventStartTimeStamp",    TYPED_STAMP },
+    { "FileAvailableTimeStamp",     TYPED_STAMP },
+    { "UtcTimeOffset",              TYPED_OFFSET },
+    { "UtcTimeOffsetCode",          TYPED_CODE },
+    { "TapDecimalPlaces",           TYPED_DECIMALS },
+    { "AbsoluteAmount",             TYPED_AMOUNT },
+    { "Charge",                     TYPED_AMOUNT },
+    { "ChargeAmount",               TYPED_AMOUNT },
+    { "TaxValue",                   TYPED_AMOUNT },
+    { "TaxableAmount",              TYPED_AMOUNT },
+    { "DiscountValue",              TYPED_AMOUNT },
+    { "FixedDiscountValue",         TYPED_AMOUNT },
+    { "DiscountableAmount",         TYPED_AMOUNT },
+    { "AdvisedCharge",              TYPED_AMOUNT },
+    { "TotalCharge",                TYPED_AMOUNT },
+    { "TotalTaxValue",              TYPED_AMOUNT },
+    { "TotalDiscountValue",         TYPED_AMOUNT },
+    { "TotalAdvisedCharge",         TYPED_AMOUNT },
+    { "TotalChargeRefund",          TYPED_AMOUNT },
+    { "TotalTaxRefund",             TYPED_AMOUNT },
+    { "TotalDiscountRefund",        TYPED_AMOUNT },
+    { "TotalAdvisedChargeRefund",   TYPED_AMOUNT },
+    { "TotalCommissionRefund",      TYPED_AMOUNT },
+    { NULL,                         TYPED_NONE }
+};
+
+static const char tbcd_pairs[] =                /* Digits of every byte, low nibble first. F: filler */
+    "00102030405060708090*0#0a0b0c0f001112131415161718191*1#1a1b1c1f1"
+    "02122232425262728292*2#2a2b2c2f203132333435363738393*3#3a3b3c3f3"
+    "04142434445464748494*4#4a4b4c4f405152535455565758595*5#5a5b5c5f5"
+    "06162636465666768696*6#6a6b6c6f607172737475767778797*7#7a7b7c7f7"
+    "08182838485868788898*8#8a8b8c8f809192939495969798999*9#9a9b9c9f9"
+    "0*1*2*3*4*5*6*7*8*9***#*a*b*c*f*0#1#2#3#4#5#6#7#8#9#*###a#b#c#f#"
+    "0a1a2a3a4a5a6a7a8a9a*a#aaabacafa0b1b2b3b4b5b6b7b8b9b*b#babbbcbfb"
+    "0c1c2c3c4c5c6c7c8c9c*c#cacbcccfc0f1f2f3f4f5f6f7f8f9f*f#fafbfcfff";
+
+static const uchar stamp_at[14] =              /* Place of each digit of CCYYMMDDhhmmss */
+{
+    0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18
+};
+
+
+/****************************************************************************
+|*
+|* Function: typed_init
+|*
+|* Description;
+|*
+|*     Finds the type of each tag of the tag map of ctx by its name. Files
+|*     without tag map have no typed values. Call it before the tag map is
+|*     left out for -n: the values are typed by the tag.
+|*
+|* Return:
+|*      0: Successful
+|*     -1: No memory
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+int typed_init(asn1typed *ty, const asn1ctx *ctx)
+{
+    const tagmap_t* map = NULL;
+    const char*     name = NULL;
+    int             tag = 0;
+    int             i = 0;
+
+    memset(ty, 0x00, sizeof(*ty));
+    ty->decimals = (ctx->file_type == FT_NRT ? NRT_DECIMALS : -1);
+    ty->stamp_end = -1;
+    ty->code_end = -1;
+
+    /* 1. Tags of all the maps chained */
+
+    for (map = ctx->tagmap; map != NULL; map = map->next)
+    {
+        if (map->ntags > ty->ntags)
+            ty->ntags = map->ntags;
+    }
+
+    if (ty->ntags == 0)
+        return 0;
+
+    if ( ( ty->tags = (typedtag *)calloc((size_t)ty->ntags, sizeof(typedtag)) ) == NULL )
+    {
+        fprintf(stderr, "Couldn't allocate memory for the typed values\n");
+        ty->ntags = 0;
+        return -1;
+    }
+
+
+    /* 2. Type of each name */
+
+    for (tag = 0; tag < ty->ntags; tag++)
+    {
+        if ( ( name = tagmap_name(ctx->tagmap, tag) ) == NULL )
+            continue;
+
+        for (i = 0; typed_names[i].name != NULL; i++)
+        {
+            if (strcmp(name, typed_names[i].name) == 0)
+            {
+                ty->tags[tag].name = name;
+                ty->tags[tag].kind = typed_names[i].kind;
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_close
+|*
+|* Description;
+|*
+|*     Releases the types of the tags. Not for the copies of ty.
+|*
+|* Return:
+|*      void
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+void typed_close(asn1typed *ty)
+{
+    free(ty->tags);
+
+    ty->tags = NULL;
+    ty->ntags = 0;
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_value
+|*
+|* Description;
+|*
+|*     Writes the typed value of the primitive of ev into dst (at least
+|*     TYPED_MAX_LEN bytes, not terminated), and keeps what later values
+|*     need: TapDecimalPlaces, the last time stamp, the offset of each
+|*     UtcTimeOffsetCode. Elements of the universal class, or named
+|*     otherwise than by the tag map (schema), are not typed.
+|*
+|* Return:
+|*      Length of the typed value
+|*      0: No typed value
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+long typed_value(asn1typed *ty, const asn1event *ev, char *dst)
+{
+    const asn1item* item = ev->item;
+    const uchar*    value = ev->value;
+    const typedtag* t = NULL;
+    long            len = item->size;
+    long            n = 0;
+
+    /* 1. Type of the tag */
+
+    if (item->class == 0 || item->tag >= ty->ntags)
+        return 0;
+
+    t = &ty->tags[item->tag];
+
+    if (t->kind == TYPED_NONE || (ev->name != NULL && ev->name != t->name))
+        return 0;
+
+
+    /* 2. Conversion */
+
+    switch (t->kind)
+    {
+        case TYPED_TBCD:
+            return (len <= TYPED_MAX_LEN / 2 ? typed_tbcd(dst, value, len) : 0);
+
+        case TYPED_BCD:
+            return (len <= TYPED_MAX_LEN / 2 ? typed_bcd(dst, value, len) : 0);
+
+        case TYPED_STAMP:
+            /* 2.1. Kept for the offset right after it */
+            if ( ( n = typed_stamp(dst, value, len) ) > 0 )
+            {
+                memcpy(ty->stamp, dst, (size_t)n);
+                ty->stamp_end = ev->vpos + len;
+            }
+            return n;
+
+        case TYPED_OFFSET:
+            /* 2.2. Offset of the code right before it (UtcTimeOffsetInfo), or of the time stamp */
+            if ( ( n = typed_offset(dst, value, len) ) == 0 )
+                return 0;
+            if (ev->pos == ty->code_end)
+            {
+                memcpy(ty->offsets[ty->code], dst, (size_t)n);
+                ty->offsets[ty->code][n] = '\0';
+            }
+            return typed_stamped(ty, ev, dst, n);
+
+        case TYPED_CODE:
+            /* 2.3. Kept for the offset right after it. Offset of the code if known */
+            if (len < 1 || len > 2 || ( n = (len == 1 ? value[0] : value[0] << 8 | value[1]) ) >= TYPED_CODES)
+                return 0;
+            ty->code = (int)n;
+            ty->code_end = ev->vpos + len;
+            if (ty->offsets[n][0] == '\0')
+                return 0;
+            memcpy(dst, ty->offsets[n], 6);
+            return typed_stamped(ty, ev, dst, 6);
+
+        case TYPED_DECIMALS:
+            if (len == 1 && value[0] <= TYPED_MAX_DECIMALS)
+                ty->decimals = value[0];
+            return 0;
+
+        case TYPED_AMOUNT:
+            return typed_amount(dst, value, len, ty->decimals);
+
+        default:
+            return 0;
+    }
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_tbcd
+|*
+|* Description;
+|*
+|*     Writes the TBCD digits of src (two per byte, the first one in the
+|*     low nibble) into dst, which needs 2 * len bytes. Fillers (F) are
+|*     left out; A-E are written "*#abc". One lookup per byte and no
+|*     branch on the nibbles.
+|*
+|* Return:
+|*      Digits written
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+long typed_tbcd(char *dst, const uchar *src, long len)
+{
+    long            n = 0;
+    long            i = 0;
+    unsigned int    lo = 0, hi = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        memcpy(dst + n, tbcd_pairs + 2 * src[i], 2);
+        lo = src[i] & 0x0f;
+        hi = src[i] >> 4;
+        n += (lo != 0x0f) * (1 + (hi != 0x0f));
+    }
+
+    return n;
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_bcd
+|*
+|* Description;
+|*
+|*     Same as typed_tbcd() with the first digit in the high nibble
+|*
+|* Return:
+|*      Digits written
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+long typed_bcd(char *dst, const uchar *src, long len)
+{
+    long            n = 0;
+    long            i = 0;
+    unsigned int    lo = 0, hi = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        lo = src[i] & 0x0f;
+        hi = src[i] >> 4;
+        memcpy(dst + n, tbcd_pairs + 2 * (lo << 4 | hi), 2);
+        n += (hi != 0x0f) * (1 + (lo != 0x0f));
+    }
+
+    return n;
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_stamp
+|*
+|* Description;
+|*
+|*     Writes the time stamp CCYYMMDDhhmmss of src as CCYY-MM-DDThh:mm:ss
+|*
+|* Return:
+|*      Length written
+|*      0: Not 14 digits
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long typed_stamp(char *dst, const uchar *src, long len)
+{
+    unsigned int    bad = 0;
+    int             i = 0;
+
+    if (len != 14)
+        return 0;
+
+    for (i = 0; i < 14; i++)
+        bad |= ((unsigned int)src[i] - '0' > 9);
+
+    if (bad)
+        return 0;
+
+    memcpy(dst, "CCYY-MM-DDThh:mm:ss", 19);
+
+    for (i = 0; i < 14; i++)
+        dst[stamp_at[i]] = (char)src[i];
+
+    return 19;
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_offset
+|*
+|* Description;
+|*
+|*     Writes the UTC offset +hhmm of src as +hh:mm
+|*
+|* Return:
+|*      Length written
+|*      0: Not a sign and 4 digits
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long typed_offset(char *dst, const uchar *src, long len)
+{
+    unsigned int    bad = 0;
+    int             i = 0;
+
+    if (len != 5 || (src[0] != '+' && src[0] != '-'))
+        return 0;
+
+    for (i = 1; i < 5; i++)
+        bad |= ((unsigned int)src[i] - '0' > 9);
+
+    if (bad)
+        return 0;
+
+    dst[0] = (char)src[0];
+    dst[1] = (char)src[1];
+    dst[2] = (char)src[2];
+    dst[3] = ':';
+    dst[4] = (char)src[3];
+    dst[5] = (char)src[4];
+
+    return 6;
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_amount
+|*
+|* Description;
+|*
+|*     Writes the signed integer of src (up to 8 bytes) with decimals
+|*     decimals (-1: unknown, written as it is)
+|*
+|* Return:
+|*      Length written
+|*      0: Empty or longer than 8 bytes
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long typed_amount(char *dst, const uchar *src, long len, int decimals)
+{
+    char                digits[24];
+    unsigned long long  u = 0;
+    long long           v = 0;
+    long                n = 0;
+    long                i = 0;
+
+    if (len < 1 || (size_t)len > sizeof(v))
+        return 0;
+
+    /* 1. Two's complement, big endian */
+
+    for (v = (signed char)src[0], i = 1; i < len; i++)
+        v = (long long)((unsigned long long)v << 8 | src[i]);
+
+    u = (v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v);
+
+
+    /* 2. Digits backwards, at least one before the point */
+
+    do
+    {
+        digits[n++] = (char)('0' + u % 10);
+        u /= 10;
+    }
+    while (u != 0);
+
+    while (n <= decimals)
+        digits[n++] = '0';
+
+    i = 0;
+    if (v < 0)
+        dst[i++] = '-';
+
+    while (n > 0)
+    {
+        if (n == decimals)
+            dst[i++] = '.';
+        dst[i++] = digits[--n];
+    }
+
+    return i;
+}
+
+
+/****************************************************************************
+|*
+|* Function: typed_stamped
+|*
+|* Description;
+|*
+|*     Puts the time stamp found right before ev in front of its offset,
+|*     already in dst (len bytes)
+|*
+|* Return:
+|*      Length of the value
+|*
+|* Modifications:
+|* 20261016    Initial version
+|*
+****************************************************************************/
+static long typed_stamped(const asn1typed *ty, const asn1event *ev, char *dst, long len)
+{
+    if (ev->pos != ty->stamp_end)
+        return len;
+
+    memmove(dst + 19, dst, (size_t)len);
+    memcpy(dst, ty->stamp, 19);
+
+    return 19 + len;
+}
+
+/* EOF */